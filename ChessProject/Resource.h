@@ -5,6 +5,7 @@
 #define IDS_APP_TITLE			103
 
 #define IDR_MAINFRAME			128
+#define IDR_PIECE_ATLAS			129
 #define IDD_CHESSPROJECT_DIALOG	102
 #define IDD_ABOUTBOX			103
 #define IDM_ABOUT				104
@@ -22,7 +23,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 
 #define _APS_NO_MFC					130
-#define _APS_NEXT_RESOURCE_VALUE	129
+#define _APS_NEXT_RESOURCE_VALUE	130
 #define _APS_NEXT_COMMAND_VALUE		32771
 #define _APS_NEXT_CONTROL_VALUE		1000
 #define _APS_NEXT_SYMED_VALUE		110
@@ -1,4 +1,17 @@
 ﻿#include "Board.h"
+#include "Geometry.h"
+
+using Geometry::PopLsb;
+
+namespace
+{
+    inline int ColorIndex(PieceColor c) { return (c == PieceColor::White) ? 0 : 1; }
+
+    inline bool IsSlider(PieceType t)
+    {
+        return t == PieceType::Bishop || t == PieceType::Rook || t == PieceType::Queen;
+    }
+}
 
 Board::Board()
 {
@@ -35,24 +48,34 @@ void Board::ResetToStartPosition()
     m_board[0][2] = Piece(PieceType::Bishop, bc); m_board[0][3] = Piece(PieceType::Queen, bc);
     m_board[0][4] = Piece(PieceType::King, bc);   m_board[0][5] = Piece(PieceType::Bishop, bc);
     m_board[0][6] = Piece(PieceType::Knight, bc); m_board[0][7] = Piece(PieceType::Rook, bc);
+
+    RebuildAttacks();
 }
 
 const Piece& Board::GetPiece(int x, int y) const { return m_board[y][x]; }
 Piece& Board::GetPiece(int x, int y) { return m_board[y][x]; }
-void Board::SetPiece(int x, int y, const Piece& p) { m_board[y][x] = p; }
+void Board::SetPiece(int x, int y, const Piece& p) { UpdateSquare(x, y, p); }
+
+void Board::LoadCells(const std::array<std::array<Piece, 8>, 8>& cells)
+{
+    m_history.clear();
+    m_board = cells;
+    RebuildAttacks();
+}
 
 void Board::MovePieceRaw(int sx, int sy, int dx, int dy)
 {
     Piece p = m_board[sy][sx];
     p.hasMoved = true;
-    m_board[dy][dx] = p;
-    m_board[sy][sx] = Piece();
+    UpdateSquare(dx, dy, p);
+    UpdateSquare(sx, sy, Piece());
 }
 
 void Board::PushState(bool isWhiteTurn)
 {
     BoardState state;
     state.cells = m_board;
+    state.attacks = m_attacks;
     state.whiteCanCastleK = m_whiteCanCastleK;
     state.whiteCanCastleQ = m_whiteCanCastleQ;
     state.blackCanCastleK = m_blackCanCastleK;
@@ -66,15 +89,143 @@ void Board::PushState(bool isWhiteTurn)
 bool Board::PopState()
 {
     if (m_history.empty()) return false;
-    BoardState state = m_history.back();
-    m_history.pop_back();
+    const BoardState& state = m_history.back();
 
     m_board = state.cells;
+    m_attacks = state.attacks;
     m_whiteCanCastleK = state.whiteCanCastleK;
     m_whiteCanCastleQ = state.whiteCanCastleQ;
     m_blackCanCastleK = state.blackCanCastleK;
     m_blackCanCastleQ = state.blackCanCastleQ;
     m_enPassantX = state.enPassantX;
     m_enPassantY = state.enPassantY;
+    m_history.pop_back();
+    return true;
+}
+
+// [변경] 컴파일 타임 테이블 조회 (슬라이더는 현재 점유 칸 기준, 처음 막힌 칸까지)
+uint64_t Board::ComputeAttacks(int x, int y, const Piece& p) const
+{
+    int sq = y * 8 + x;
+    uint64_t occupied = m_attacks.occupied[0] | m_attacks.occupied[1];
+    switch (p.type) {
+    case PieceType::Pawn:   return Geometry::PawnAttacks(p.color == PieceColor::White, sq);
+    case PieceType::Knight: return Geometry::KnightAttacks(sq);
+    case PieceType::King:   return Geometry::KingAttacks(sq);
+    case PieceType::Bishop: return Geometry::SliderAttacks(sq, Geometry::k_bishopDirs, occupied);
+    case PieceType::Rook:   return Geometry::SliderAttacks(sq, Geometry::k_rookDirs, occupied);
+    case PieceType::Queen:  return Geometry::SliderAttacks(sq, Geometry::k_queenDirs, occupied);
+    default:                return 0;
+    }
+}
+
+// 한 색의 공격 비트맵 = 그 색 기물들의 공격 칸 합집합 (기물 16개 이하 OR)
+void Board::RefreshAttackMap(int color)
+{
+    uint64_t map = 0;
+    uint64_t pieces = m_attacks.occupied[color];
+    while (pieces) map |= m_attacks.pieceAttacks[PopLsb(pieces)];
+    m_attacks.map[color] = map;
+}
+
+// 한 칸의 내용이 바뀔 때:
+// 1) 원래 기물의 공격 제거  2) 점유 여부가 바뀌었으면 이 칸을 공격하던 슬라이더 광선만 재계산
+// 3) 새 기물의 공격 추가  4) 영향받은 색의 비트맵 갱신
+void Board::UpdateSquare(int x, int y, const Piece& p)
+{
+    int sq = y * 8 + x;
+    uint64_t bit = 1ull << sq;
+    Piece old = m_board[y][x];
+    bool dirty[2] = { false, false };
+
+    if (old.type != PieceType::None) {
+        int c = ColorIndex(old.color);
+        m_attacks.pieceAttacks[sq] = 0;
+        m_attacks.occupied[c] &= ~bit;
+        m_attacks.sliders &= ~bit;
+        m_attacks.pawns[c] &= ~bit;
+        if (old.type == PieceType::King && m_attacks.kingSq[c] == sq) m_attacks.kingSq[c] = -1;
+        dirty[c] = true;
+    }
+
+    m_board[y][x] = p;
+    // 슬라이더 광선 계산이 점유 비트를 쓰므로 먼저 반영
+    if (p.type != PieceType::None) m_attacks.occupied[ColorIndex(p.color)] |= bit;
+
+    // 같은 칸에 기물만 바뀐 경우(캡처) 광선은 그대로 막혀 있으므로 재계산 불필요
+    if ((old.type == PieceType::None) != (p.type == PieceType::None)) {
+        uint64_t sliders = m_attacks.sliders;
+        while (sliders) {
+            int s = PopLsb(sliders);
+            if (!(m_attacks.pieceAttacks[s] & bit)) continue;
+            const Piece& sp = m_board[s / 8][s % 8];
+            m_attacks.pieceAttacks[s] = ComputeAttacks(s % 8, s / 8, sp);
+            dirty[ColorIndex(sp.color)] = true;
+        }
+    }
+
+    if (p.type != PieceType::None) {
+        int c = ColorIndex(p.color);
+        m_attacks.pieceAttacks[sq] = ComputeAttacks(x, y, p);
+        if (IsSlider(p.type)) m_attacks.sliders |= bit;
+        if (p.type == PieceType::Pawn) m_attacks.pawns[c] |= bit;
+        if (p.type == PieceType::King) m_attacks.kingSq[c] = sq;
+        dirty[c] = true;
+    }
+
+    if (dirty[0]) RefreshAttackMap(0);
+    if (dirty[1]) RefreshAttackMap(1);
+}
+
+void Board::RebuildAttacks()
+{
+    m_attacks = AttackState();
+    // 점유 비트를 먼저 모두 채운 뒤 공격 칸 계산
+    for (int y = 0; y < 8; ++y)
+        for (int x = 0; x < 8; ++x)
+            if (m_board[y][x].type != PieceType::None)
+                m_attacks.occupied[ColorIndex(m_board[y][x].color)] |= 1ull << (y * 8 + x);
+
+    for (int y = 0; y < 8; ++y) {
+        for (int x = 0; x < 8; ++x) {
+            const Piece& p = m_board[y][x];
+            if (p.type == PieceType::None) continue;
+            int sq = y * 8 + x;
+            int c = ColorIndex(p.color);
+            m_attacks.pieceAttacks[sq] = ComputeAttacks(x, y, p);
+            if (IsSlider(p.type)) m_attacks.sliders |= 1ull << sq;
+            if (p.type == PieceType::Pawn) m_attacks.pawns[c] |= 1ull << sq;
+            if (p.type == PieceType::King) m_attacks.kingSq[c] = sq;
+        }
+    }
+    RefreshAttackMap(0);
+    RefreshAttackMap(1);
+}
+
+uint64_t Board::AttackersOf(int x, int y, bool byWhite) const
+{
+    uint64_t bit = 1ull << (y * 8 + x);
+    uint64_t pieces = m_attacks.occupied[byWhite ? 0 : 1];
+    uint64_t result = 0;
+    while (pieces) {
+        int s = PopLsb(pieces);
+        if (m_attacks.pieceAttacks[s] & bit) result |= 1ull << s;
+    }
+    return result;
+}
+
+int Board::AttackerCount(int x, int y, bool byWhite) const
+{
+    uint64_t attackers = AttackersOf(x, y, byWhite);
+    int n = 0;
+    while (attackers) { attackers &= attackers - 1; ++n; }
+    return n;
+}
+
+bool Board::FindKing(bool white, int& x, int& y) const
+{
+    int sq = m_attacks.kingSq[white ? 0 : 1];
+    if (sq < 0) return false;
+    x = sq % 8; y = sq / 8;
     return true;
-}
\ No newline at end of file
+}
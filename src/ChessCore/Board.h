@@ -1,12 +1,25 @@
 ﻿#pragma once
 #include <array>
+#include <cstdint>
 #include <vector>
 #include "Piece.h"
 
+// [추가] 칸 공격 정보 (색 인덱스: 0 = 백, 1 = 흑, 칸 인덱스 = y * 8 + x)
+struct AttackState
+{
+    std::array<uint64_t, 64> pieceAttacks{}; // 각 칸의 기물이 공격하는 칸
+    uint64_t occupied[2] = { 0, 0 };         // 색별 기물 위치
+    uint64_t map[2] = { 0, 0 };              // 색별 공격받는 칸 (pieceAttacks의 합집합)
+    uint64_t sliders = 0;                    // 비숍/룩/퀸이 있는 칸
+    uint64_t pawns[2] = { 0, 0 };            // [추가] 색별 폰 위치 (폰 구조 분석 / 폰 해시)
+    int kingSq[2] = { -1, -1 };
+};
+
 // 보드 상태 백업용 구조체 (무르기 구현용)
 struct BoardState
 {
     std::array<std::array<Piece, 8>, 8> cells;
+    AttackState attacks; // 복구 시 재계산하지 않도록 함께 저장
     bool whiteCanCastleK = true;
     bool whiteCanCastleQ = true;
     bool blackCanCastleK = true;
@@ -26,6 +39,8 @@ public:
     const Piece& GetPiece(int x, int y) const;
     Piece& GetPiece(int x, int y);
     void SetPiece(int x, int y, const Piece& p);
+    // [추가] 64칸 배치를 통째로 교체 (히스토리 비움, 공격 정보는 한 번만 재계산). 압축 국면 디코딩용
+    void LoadCells(const std::array<std::array<Piece, 8>, 8>& cells);
 
     // 단순 이동 (좌표만 변경)
     void MovePieceRaw(int sx, int sy, int dx, int dy);
@@ -33,6 +48,20 @@ public:
     // 상태 관리
     void PushState(bool isWhiteTurn); // 현재 상태 저장
     bool PopState(); // 이전 상태 복구 (Undo)
+    void ClearHistory() { m_history.clear(); } // [추가] 탐색용 복사본에서 히스토리 복사 비용 제거
+
+    // [추가] 칸 공격 정보 (비트 인덱스 = y * 8 + x)
+    // SetPiece / MovePieceRaw 때마다 바뀐 칸의 기물과 그 칸을 지나는 슬라이더 광선만 다시 계산
+    // 공격자 수 / 공격자 위치는 기물별 공격 칸에서 바로 셈 (기물 16개 이하)
+    // 주의: 기물의 type/color 변경은 반드시 SetPiece로 (GetPiece 참조로는 hasMoved만 변경)
+    bool IsAttacked(int x, int y, bool byWhite) const { return (m_attacks.map[byWhite ? 0 : 1] >> (y * 8 + x)) & 1; }
+    int AttackerCount(int x, int y, bool byWhite) const;
+    uint64_t AttackMap(bool byWhite) const { return m_attacks.map[byWhite ? 0 : 1]; }
+    uint64_t AttacksFrom(int x, int y) const { return m_attacks.pieceAttacks[y * 8 + x]; } // 그 칸의 기물이 공격하는 칸
+    uint64_t AttackersOf(int x, int y, bool byWhite) const;                       // 그 칸을 공격하는 기물 위치
+    bool FindKing(bool white, int& x, int& y) const;
+    uint64_t Occupancy(bool white) const { return m_attacks.occupied[white ? 0 : 1]; } // 그 색 기물이 있는 칸
+    uint64_t Pawns(bool white) const { return m_attacks.pawns[white ? 0 : 1]; }         // [추가] 그 색 폰이 있는 칸
 
     // 특수 규칙 플래그
     bool m_whiteCanCastleK = true;
@@ -45,4 +74,11 @@ public:
 private:
     std::array<std::array<Piece, 8>, 8> m_board;
     std::vector<BoardState> m_history; // 히스토리 스택
+
+    AttackState m_attacks;
+
+    void UpdateSquare(int x, int y, const Piece& p);
+    void RebuildAttacks();
+    uint64_t ComputeAttacks(int x, int y, const Piece& p) const;
+    void RefreshAttackMap(int color);
 };
\ No newline at end of file
@@ -1,9 +1,12 @@
 ﻿#include "Fen.h"
 #include "Board.h"
 #include "Piece.h"
+#include <sstream>
+#include "../Utils/Trace.h"
 
 std::string Fen::BoardToFEN(const Board& board, bool isWhiteTurn)
 {
+    TRACE_SCOPE("BoardToFEN", "core");
     std::string fen;
 
     for (int rank = 0; rank < 8; ++rank)
@@ -62,4 +65,101 @@ std::string Fen::BoardToFEN(const Board& board, bool isWhiteTurn)
     // 4. 하프무브/풀무브 (약식으로 0 1)
     fen += " 0 1";
     return fen;
+}
+
+bool Fen::FENToBoard(const std::string& fen, Board& board, bool& isWhiteTurn)
+{
+    std::istringstream iss(fen);
+    std::string placement, turn, castling = "-", enPassant = "-";
+    if (!(iss >> placement >> turn)) return false;
+    iss >> castling >> enPassant; // 생략 가능
+
+    board.ResetToStartPosition(); // 히스토리/플래그 초기화
+    for (int y = 0; y < 8; ++y)
+        for (int x = 0; x < 8; ++x)
+            board.SetPiece(x, y, Piece());
+
+    // 1. 기물 배치 (rank 8 -> y = 0)
+    int x = 0, y = 0;
+    for (char c : placement)
+    {
+        if (c == '/') {
+            if (x != 8) return false;
+            ++y; x = 0;
+            continue;
+        }
+        if (c >= '1' && c <= '8') {
+            x += c - '0';
+            if (x > 8) return false;
+            continue;
+        }
+        if (x >= 8 || y >= 8) return false;
+
+        PieceColor color = (c >= 'A' && c <= 'Z') ? PieceColor::White : PieceColor::Black;
+        PieceType type = PieceType::None;
+        switch (tolower(c)) {
+        case 'p': type = PieceType::Pawn; break;
+        case 'n': type = PieceType::Knight; break;
+        case 'b': type = PieceType::Bishop; break;
+        case 'r': type = PieceType::Rook; break;
+        case 'q': type = PieceType::Queen; break;
+        case 'k': type = PieceType::King; break;
+        default: return false;
+        }
+        board.SetPiece(x, y, Piece(type, color));
+        ++x;
+    }
+    if (y != 7 || x != 8) return false;
+
+    // 2. 턴
+    if (turn == "w") isWhiteTurn = true;
+    else if (turn == "b") isWhiteTurn = false;
+    else return false;
+
+    // 3. 캐슬링 권한
+    board.m_whiteCanCastleK = castling.find('K') != std::string::npos;
+    board.m_whiteCanCastleQ = castling.find('Q') != std::string::npos;
+    board.m_blackCanCastleK = castling.find('k') != std::string::npos;
+    board.m_blackCanCastleQ = castling.find('q') != std::string::npos;
+
+    // 4. 앙파상 타겟
+    board.m_enPassantX = -1; board.m_enPassantY = -1;
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' && enPassant[1] >= '1' && enPassant[1] <= '8') {
+        board.m_enPassantX = enPassant[0] - 'a';
+        board.m_enPassantY = 8 - (enPassant[1] - '0');
+    }
+
+    // 5. hasMoved 추정
+    InferHasMoved(board);
+    return true;
+}
+
+// GameLogic은 캐슬링/2칸 전진에 hasMoved를 사용
+void Fen::InferHasMoved(Board& board)
+{
+    for (int yy = 0; yy < 8; ++yy)
+        for (int xx = 0; xx < 8; ++xx) {
+            Piece& p = board.GetPiece(xx, yy);
+            bool white = (p.color == PieceColor::White);
+            switch (p.type) {
+            case PieceType::Pawn:
+                p.hasMoved = (yy != (white ? 6 : 1));
+                break;
+            case PieceType::King:
+                p.hasMoved = white ? !(board.m_whiteCanCastleK || board.m_whiteCanCastleQ)
+                                   : !(board.m_blackCanCastleK || board.m_blackCanCastleQ);
+                break;
+            case PieceType::Rook:
+            {
+                int homeY = white ? 7 : 0;
+                bool kSide = white ? board.m_whiteCanCastleK : board.m_blackCanCastleK;
+                bool qSide = white ? board.m_whiteCanCastleQ : board.m_blackCanCastleQ;
+                p.hasMoved = !((yy == homeY && xx == 7 && kSide) || (yy == homeY && xx == 0 && qSide));
+                break;
+            }
+            default:
+                p.hasMoved = true;
+                break;
+            }
+        }
 }
\ No newline at end of file
@@ -6,4 +6,11 @@ class Board;
 namespace Fen
 {
     std::string BoardToFEN(const Board& board, bool isWhiteTurn);
+
+    // [추가] FEN 문자열 -> Board. 형식이 잘못되면 false (board는 변경될 수 있음)
+    // hasMoved 플래그는 캐슬링 권한과 폰의 시작 랭크로부터 추정
+    bool FENToBoard(const std::string& fen, Board& board, bool& isWhiteTurn);
+
+    // [추가] 캐슬링 권한과 폰의 시작 랭크로 hasMoved 추정 (FEN / 압축 국면 공용)
+    void InferHasMoved(Board& board);
 }
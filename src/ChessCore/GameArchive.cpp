@@ -0,0 +1,441 @@
+﻿#include "GameArchive.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "Board.h"
+#include "Fen.h"
+#include "PackedPosition.h"
+#include "../Utils/Trace.h"
+
+namespace
+{
+    const char k_magic[4] = { 'C', 'G', 'A', 'R' };
+    const uint32_t k_version = 2;         // [변경] 2: 승급을 다시 펼치지 않고 합법수 목록 번호를 그대로 씀
+    const uint8_t k_flagCustomStart = 1; // bit1..2 = ArchiveResult
+    const size_t k_maxMoves = 218;       // 한 국면 합법수 최대 (승급 Q/R/B/N 각각 포함)
+
+    // 블록 머리에서 읽은 대국 정보
+    struct PendingStart
+    {
+        uint8_t flags;
+        uint64_t plies;
+        PackedPosition start;
+    };
+
+    bool SameMove(const Move& a, const Move& b)
+    {
+        // 승급 종류가 비어 있으면 퀸 (ApplyMove와 동일)
+        PieceType pa = (a.promotion == PieceType::None) ? PieceType::Queen : a.promotion;
+        PieceType pb = (b.promotion == PieceType::None) ? PieceType::Queen : b.promotion;
+        return a.sx == b.sx && a.sy == b.sy && a.dx == b.dx && a.dy == b.dy && pa == pb;
+    }
+
+    void PutVarint(std::vector<uint8_t>& out, uint64_t v)
+    {
+        while (v >= 0x80) { out.push_back((uint8_t)(v | 0x80)); v >>= 7; }
+        out.push_back((uint8_t)v);
+    }
+
+    bool GetVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v)
+    {
+        v = 0;
+        for (int shift = 0; shift < 64 && p < end; shift += 7) {
+            uint8_t b = *p++;
+            v |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    // -----------------------------------------------------------------------
+    // 적응형 빈도 모델: 심볼 = 수 번호. 번호 n 이상은 그 국면에 없으므로 앞 n개 빈도만 합산
+    // -----------------------------------------------------------------------
+    class IndexModel
+    {
+    public:
+        IndexModel() { std::fill(std::begin(m_freq), std::end(m_freq), (uint16_t)1); m_total = k_maxMoves; }
+
+        uint32_t Total(size_t n) const { return Sum(n); }
+        uint32_t Cum(size_t symbol) const { return Sum(symbol); }
+        uint32_t Freq(size_t symbol) const { return m_freq[symbol]; }
+
+        // 누적 빈도 target이 속한 심볼 (n개 중)
+        size_t Find(uint32_t target, size_t n, uint32_t& cum) const
+        {
+            cum = 0;
+            size_t s = 0;
+            for (; s + 1 < n && cum + m_freq[s] <= target; ++s) cum += m_freq[s];
+            return s;
+        }
+
+        void Update(size_t symbol)
+        {
+            m_freq[symbol] += k_step;
+            m_total += k_step;
+            if (m_total > k_limit) {
+                m_total = 0;
+                for (auto& f : m_freq) { f = (uint16_t)((f + 1) >> 1); m_total += f; }
+            }
+        }
+
+    private:
+        static const uint32_t k_step = 24;
+        static const uint32_t k_limit = 1 << 15; // 범위 부호기의 BOT(1<<16)보다 작아야 함
+
+        uint32_t Sum(size_t n) const
+        {
+            uint32_t s = 0;
+            for (size_t i = 0; i < n; ++i) s += m_freq[i];
+            return s;
+        }
+
+        uint16_t m_freq[k_maxMoves];
+        uint32_t m_total;
+    };
+
+    // -----------------------------------------------------------------------
+    // 32비트 캐리 없는 범위 부호기 (Subbotin)
+    // -----------------------------------------------------------------------
+    const uint32_t k_top = 1u << 24;
+    const uint32_t k_bot = 1u << 16;
+
+    class RangeEncoder
+    {
+    public:
+        explicit RangeEncoder(std::vector<uint8_t>& out) : m_out(out) {}
+
+        void Encode(uint32_t cum, uint32_t freq, uint32_t total)
+        {
+            m_range /= total;
+            m_low += cum * m_range;
+            m_range *= freq;
+            while ((m_low ^ (m_low + m_range)) < k_top || (m_range < k_bot && ((m_range = (0u - m_low) & (k_bot - 1)), true))) {
+                m_out.push_back((uint8_t)(m_low >> 24));
+                m_low <<= 8;
+                m_range <<= 8;
+            }
+        }
+
+        void Flush()
+        {
+            for (int i = 0; i < 4; ++i) {
+                m_out.push_back((uint8_t)(m_low >> 24));
+                m_low <<= 8;
+            }
+        }
+
+    private:
+        std::vector<uint8_t>& m_out;
+        uint32_t m_low = 0;
+        uint32_t m_range = 0xFFFFFFFFu;
+    };
+
+    class RangeDecoder
+    {
+    public:
+        RangeDecoder(const uint8_t* p, const uint8_t* end) : m_p(p), m_end(end)
+        {
+            for (int i = 0; i < 4; ++i) m_code = (m_code << 8) | Next();
+        }
+
+        uint32_t GetFreq(uint32_t total)
+        {
+            m_range /= total;
+            uint32_t v = (m_code - m_low) / m_range;
+            return (v < total) ? v : total - 1;
+        }
+
+        void Decode(uint32_t cum, uint32_t freq)
+        {
+            m_low += cum * m_range;
+            m_range *= freq;
+            while ((m_low ^ (m_low + m_range)) < k_top || (m_range < k_bot && ((m_range = (0u - m_low) & (k_bot - 1)), true))) {
+                m_code = (m_code << 8) | Next();
+                m_low <<= 8;
+                m_range <<= 8;
+            }
+        }
+
+    private:
+        uint8_t Next() { return (m_p < m_end) ? *m_p++ : 0; }
+
+        const uint8_t* m_p;
+        const uint8_t* m_end;
+        uint32_t m_low = 0;
+        uint32_t m_range = 0xFFFFFFFFu;
+        uint32_t m_code = 0;
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+bool GameArchiveWriter::Open(const std::string& path, uint32_t gamesPerBlock)
+{
+    Close();
+    m_file = MappedFile::OpenForWrite(path);
+    if (!m_file) return false;
+    std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+
+    // 자리만 잡아 두고 Close 때 개수 / 색인 위치를 채워 다시 씀
+    GameArchiveHeader header{};
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_gamesPerBlock = std::max<uint32_t>(gamesPerBlock, 1);
+    m_offset = sizeof(header);
+    m_gameCount = m_moveCount = 0;
+    m_pending.clear();
+    m_symbols.clear();
+    m_counts.clear();
+    m_blocks.clear();
+    return true;
+}
+
+bool GameArchiveWriter::Append(const ArchivedGame& game)
+{
+    if (!m_file) return false;
+
+    Board board;
+    bool isWhiteTurn = true;
+    PendingGame pending{ (uint8_t)((uint8_t)game.result << 1), std::string(), (uint32_t)game.moves.size() };
+    if (!game.startFen.empty()) {
+        PackedPosition packed;
+        if (!Fen::FENToBoard(game.startFen, board, isWhiteTurn) || !PackedPosition::Encode(board, isWhiteTurn, packed)) return false;
+        pending.flags |= k_flagCustomStart;
+        pending.start.assign((const char*)&packed, sizeof(packed));
+        // 디코더와 같은 보드에서 출발하도록 패킹된 국면으로 다시 만듦 (hasMoved 추정 규칙 통일)
+        packed.Decode(board, isWhiteTurn);
+    }
+    board.ClearHistory();
+
+    // 불법수가 나오면 블록 버퍼를 건드리지 않도록 따로 모았다가 붙임
+    std::vector<uint8_t> symbols, counts;
+    symbols.reserve(game.moves.size());
+    counts.reserve(game.moves.size());
+    std::vector<Move> legal;
+    for (const auto& mv : game.moves) {
+        m_logic.GenerateLegalMoves(board, isWhiteTurn, legal);
+        if (legal.empty() || legal.size() > k_maxMoves) return false;
+        size_t i = 0;
+        while (i < legal.size() && !SameMove(legal[i], mv)) ++i;
+        if (i == legal.size()) return false;
+        symbols.push_back((uint8_t)i);
+        counts.push_back((uint8_t)(legal.size() - 1));
+        m_logic.ApplyMove(board, legal[i], isWhiteTurn);
+        isWhiteTurn = !isWhiteTurn;
+    }
+
+    m_pending.push_back(std::move(pending));
+    m_symbols.insert(m_symbols.end(), symbols.begin(), symbols.end());
+    m_counts.insert(m_counts.end(), counts.begin(), counts.end());
+    ++m_gameCount;
+    m_moveCount += game.moves.size();
+    return (m_pending.size() < m_gamesPerBlock) || FlushBlock();
+}
+
+bool GameArchiveWriter::FlushBlock()
+{
+    if (m_pending.empty()) return true;
+
+    // [대국 수][대국별: 플래그, 수 개수, (시작 국면)][범위 부호화된 수 번호]
+    std::vector<uint8_t> data;
+    PutVarint(data, m_pending.size());
+    for (const auto& g : m_pending) {
+        data.push_back(g.flags);
+        PutVarint(data, g.plies);
+        data.insert(data.end(), g.start.begin(), g.start.end());
+    }
+    IndexModel model;
+    RangeEncoder encoder(data);
+    for (size_t i = 0; i < m_symbols.size(); ++i) {
+        size_t n = (size_t)m_counts[i] + 1;
+        encoder.Encode(model.Cum(m_symbols[i]), model.Freq(m_symbols[i]), model.Total(n));
+        model.Update(m_symbols[i]);
+    }
+    encoder.Flush();
+
+    GameArchiveBlockEntry entry{ m_offset, m_gameCount - m_pending.size(), (uint32_t)data.size(), (uint32_t)m_pending.size() };
+    if (std::fwrite(data.data(), 1, data.size(), m_file) != data.size()) return false;
+    m_blocks.push_back(entry);
+    m_offset += data.size();
+    m_pending.clear();
+    m_symbols.clear();
+    m_counts.clear();
+    return true;
+}
+
+bool GameArchiveWriter::Close()
+{
+    if (!m_file) return true;
+
+    bool ok = FlushBlock();
+    GameArchiveHeader header{};
+    std::memcpy(header.magic, k_magic, sizeof(k_magic));
+    header.version = k_version;
+    header.blockCount = (uint32_t)m_blocks.size();
+    header.gameCount = m_gameCount;
+    header.moveCount = m_moveCount;
+    header.indexOffset = m_offset;
+    if (ok && !m_blocks.empty())
+        ok = std::fwrite(m_blocks.data(), sizeof(GameArchiveBlockEntry), m_blocks.size(), m_file) == m_blocks.size();
+    ok = ok && std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    m_blocks.clear();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+bool GameArchiveReader::Open(const std::string& path)
+{
+    Close();
+    if (!m_file.Open(path) || m_file.Size() < sizeof(GameArchiveHeader)) {
+        Close();
+        return false;
+    }
+    std::memcpy(&m_header, m_file.Data(), sizeof(m_header));
+    uint64_t size = m_file.Size();
+    bool valid = std::memcmp(m_header.magic, k_magic, sizeof(k_magic)) == 0 && m_header.version == k_version
+        && m_header.indexOffset >= sizeof(GameArchiveHeader) && m_header.indexOffset <= size
+        && m_header.blockCount <= (size - m_header.indexOffset) / sizeof(GameArchiveBlockEntry);
+    if (!valid) {
+        Close();
+        return false;
+    }
+    m_blocks = (const GameArchiveBlockEntry*)(m_file.Data() + m_header.indexOffset);
+    for (size_t i = 0; i < m_header.blockCount; ++i) {
+        if (m_blocks[i].offset < sizeof(GameArchiveHeader) || m_blocks[i].offset + m_blocks[i].size > m_header.indexOffset) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void GameArchiveReader::Close()
+{
+    m_file.Close();
+    m_header = GameArchiveHeader{};
+    m_blocks = nullptr;
+}
+
+bool GameArchiveReader::DecodeGames(size_t block, uint32_t count, std::vector<ArchivedGame>& outGames, const PositionVisitor& onPosition) const
+{
+    TRACE_SCOPE("GameArchive::DecodeBlock", "core");
+    outGames.clear();
+    if (block >= m_header.blockCount) return false;
+    const GameArchiveBlockEntry& entry = m_blocks[block];
+    const uint8_t* p = m_file.Data() + entry.offset;
+    const uint8_t* end = p + entry.size;
+
+    uint64_t gameCount = 0;
+    if (!GetVarint(p, end, gameCount) || gameCount != entry.gameCount) return false;
+    count = std::min<uint32_t>(count, entry.gameCount);
+
+    // 머리 부분은 블록의 모든 대국을 읽어야 수 스트림 시작 위치를 앎
+    std::vector<PendingStart> starts;
+    starts.reserve((size_t)gameCount);
+    for (uint64_t g = 0; g < gameCount; ++g) {
+        PendingStart s{};
+        uint64_t plies = 0;
+        if (p >= end) return false;
+        s.flags = *p++;
+        if (!GetVarint(p, end, plies)) return false;
+        s.plies = plies;
+        if (s.flags & k_flagCustomStart) {
+            if (end - p < (ptrdiff_t)sizeof(PackedPosition)) return false;
+            std::memcpy(&s.start, p, sizeof(PackedPosition));
+            p += sizeof(PackedPosition);
+        }
+        starts.push_back(s);
+    }
+
+    GameLogic logic;
+    IndexModel model;
+    RangeDecoder decoder(p, end);
+    std::vector<Move> legal;
+    outGames.resize(count);
+    for (uint32_t g = 0; g < count; ++g) {
+        const PendingStart& s = starts[g];
+        ArchivedGame& game = outGames[g];
+        game.result = (ArchiveResult)((s.flags >> 1) & 3);
+        game.moves.reserve((size_t)s.plies);
+
+        Board board;
+        bool isWhiteTurn = true;
+        if (s.flags & k_flagCustomStart) {
+            if (!s.start.Decode(board, isWhiteTurn)) return false;
+            game.startFen = Fen::BoardToFEN(board, isWhiteTurn);
+        }
+        for (uint64_t ply = 0; ply < s.plies; ++ply) {
+            logic.GenerateLegalMoves(board, isWhiteTurn, legal);
+            size_t n = legal.size();
+            if (n == 0 || n > k_maxMoves) return false;
+            uint32_t cum = 0;
+            size_t symbol = model.Find(decoder.GetFreq(model.Total(n)), n, cum);
+            decoder.Decode(cum, model.Freq(symbol));
+            model.Update(symbol);
+
+            const Move& mv = legal[symbol];
+            if (onPosition) onPosition(board, isWhiteTurn, mv);
+            game.moves.push_back(mv);
+            logic.ApplyMove(board, mv, isWhiteTurn);
+            isWhiteTurn = !isWhiteTurn;
+        }
+    }
+    return true;
+}
+
+bool GameArchiveReader::DecodeBlock(size_t block, std::vector<ArchivedGame>& outGames, const PositionVisitor& onPosition) const
+{
+    return DecodeGames(block, UINT32_MAX, outGames, onPosition);
+}
+
+bool GameArchiveReader::ReadGame(uint64_t index, ArchivedGame& outGame) const
+{
+    if (index >= m_header.gameCount) return false;
+    // 블록은 대국 번호 순 -> firstGame으로 이진 탐색
+    const GameArchiveBlockEntry* end = m_blocks + m_header.blockCount;
+    const GameArchiveBlockEntry* it = std::upper_bound(m_blocks, end, index,
+        [](uint64_t i, const GameArchiveBlockEntry& e) { return i < e.firstGame; });
+    if (it == m_blocks) return false;
+    --it;
+
+    std::vector<ArchivedGame> games;
+    uint32_t local = (uint32_t)(index - it->firstGame);
+    if (!DecodeGames((size_t)(it - m_blocks), local + 1, games, nullptr) || games.size() <= local) return false;
+    outGame = std::move(games[local]);
+    return true;
+}
+
+bool GameArchiveReader::DecodeParallel(int threads, const BlockVisitor& onBlock) const
+{
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> ok{ true };
+
+    auto worker = [&]() {
+        std::vector<ArchivedGame> games;
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= m_header.blockCount) break;
+            if (!DecodeBlock(i, games)) { ok = false; continue; }
+            if (onBlock) onBlock(i, games);
+        }
+    };
+
+    if (threads < 1) threads = 1;
+    threads = (int)std::min<size_t>((size_t)threads, std::max<size_t>(m_header.blockCount, 1));
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    return ok;
+}
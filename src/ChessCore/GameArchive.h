@@ -0,0 +1,114 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+#include "GameLogic.h"
+#include "MappedFile.h"
+
+// [추가] 이진 기보 보관 파일 (.cgar)
+// - 수 하나 = 그 국면의 합법수 목록(GenerateLegalMoves 순서, 승급 Q/R/B/N은 각각 한 수) 안의 번호
+//   번호는 적응형 빈도 모델 + 범위 부호화(range coder)로 압축. 합법수 개수를 디코더도 알기 때문에
+//   있을 수 없는 번호에는 확률을 주지 않음
+// - 대국 N개를 블록 하나로 묶고 블록마다 모델을 새로 시작 -> 블록끼리 독립적으로 (병렬) 디코딩
+// - 파일 끝의 블록 색인으로 임의 블록 / 임의 대국에 바로 접근
+// 디코딩은 수를 실제로 두어 가며 진행하므로 각 수 직전의 Board가 그대로 재현됨
+enum class ArchiveResult : uint8_t
+{
+    Unknown = 0, // "*"
+    WhiteWins,
+    BlackWins,
+    Draw
+};
+
+struct ArchivedGame
+{
+    std::string startFen;    // 비어 있으면 표준 초기 국면
+    std::vector<Move> moves; // 승급 수는 promotion이 채워져 있음
+    ArchiveResult result = ArchiveResult::Unknown;
+};
+
+struct GameArchiveHeader
+{
+    char magic[4];           // "CGAR"
+    uint32_t version;
+    uint32_t blockCount;
+    uint32_t reserved;
+    uint64_t gameCount;
+    uint64_t moveCount;
+    uint64_t indexOffset;
+};
+
+struct GameArchiveBlockEntry
+{
+    uint64_t offset;         // 파일 내 블록 시작
+    uint64_t firstGame;
+    uint32_t size;           // 블록 바이트 수
+    uint32_t gameCount;
+};
+
+class GameArchiveWriter
+{
+public:
+    ~GameArchiveWriter() { Close(); }
+
+    bool Open(const std::string& path, uint32_t gamesPerBlock = 1024);
+    // 수를 처음부터 두어 보며 번호로 바꿈. 불법수가 있거나 시작 FEN이 잘못됐으면 false (아무것도 기록하지 않음)
+    bool Append(const ArchivedGame& game);
+    bool Close();
+
+    uint64_t GameCount() const { return m_gameCount; }
+    uint64_t MoveCount() const { return m_moveCount; }
+
+private:
+    struct PendingGame
+    {
+        uint8_t flags;
+        std::string start;   // PackedPosition 32바이트 (시작 국면이 표준이 아닐 때만)
+        uint32_t plies;
+    };
+
+    bool FlushBlock();
+
+    std::FILE* m_file = nullptr;
+    uint32_t m_gamesPerBlock = 1024;
+    uint64_t m_offset = 0;
+    uint64_t m_gameCount = 0;
+    uint64_t m_moveCount = 0;
+    std::vector<PendingGame> m_pending;
+    std::vector<uint8_t> m_symbols;  // 블록 안의 모든 수 번호
+    std::vector<uint8_t> m_counts;   // 각 수를 둘 때의 합법수 개수 - 1
+    std::vector<GameArchiveBlockEntry> m_blocks;
+    GameLogic m_logic;
+};
+
+class GameArchiveReader
+{
+public:
+    // 각 수를 두기 직전 국면과 그 수 (디코딩 중 재생되는 보드를 그대로 넘김)
+    using PositionVisitor = std::function<void(const Board& board, bool isWhiteTurn, const Move& next)>;
+    using BlockVisitor = std::function<void(size_t block, const std::vector<ArchivedGame>& games)>;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    uint64_t GameCount() const { return m_header.gameCount; }
+    uint64_t MoveCount() const { return m_header.moveCount; }
+    size_t BlockCount() const { return m_header.blockCount; }
+    const GameArchiveBlockEntry& Block(size_t i) const { return m_blocks[i]; }
+
+    // 블록 하나 디코딩. 공유 상태가 없어 여러 스레드에서 동시에 호출 가능
+    bool DecodeBlock(size_t block, std::vector<ArchivedGame>& outGames, const PositionVisitor& onPosition = nullptr) const;
+    // 대국 번호로 읽기 (그 블록의 앞쪽 대국까지만 디코딩)
+    bool ReadGame(uint64_t index, ArchivedGame& outGame) const;
+    // 블록을 threads개 스레드에 나눠 디코딩. onBlock은 여러 스레드에서 동시에 불릴 수 있음
+    bool DecodeParallel(int threads, const BlockVisitor& onBlock) const;
+
+private:
+    bool DecodeGames(size_t block, uint32_t count, std::vector<ArchivedGame>& outGames, const PositionVisitor& onPosition) const;
+
+    MappedFile m_file;
+    GameArchiveHeader m_header{};
+    const GameArchiveBlockEntry* m_blocks = nullptr;
+};
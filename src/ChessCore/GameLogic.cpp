@@ -1,161 +1,158 @@
 ﻿#include "GameLogic.h"
 #include <cmath>
+#include "Geometry.h"
+#include "MovePicker.h"
+#include "../Utils/Trace.h"
 
-GameLogic::GameLogic() {}
-
-bool GameLogic::IsMoveLegalBasic(const Board& board, const Move& move, bool isWhiteTurn)
+namespace
 {
-    if (move.sx == move.dx && move.sy == move.dy) return false;
-    if (move.sx < 0 || move.sx >= 8 || move.sy < 0 || move.sy >= 8) return false;
-    if (move.dx < 0 || move.dx >= 8 || move.dy < 0 || move.dy >= 8) return false;
+    // [추가] 색별 상수 (템플릿 인자로 넘겨 컴파일 타임에 접힘)
+    template <PieceColor Us> struct Side;
 
-    const Piece& from = board.GetPiece(move.sx, move.sy);
-    const Piece& to = board.GetPiece(move.dx, move.dy);
-
-    if (from.type == PieceType::None) return false;
-    if (isWhiteTurn && from.color != PieceColor::White) return false;
-    if (!isWhiteTurn && from.color != PieceColor::Black) return false;
-    if (to.type != PieceType::None && to.color == from.color) return false;
-
-    return true;
-}
+    template <> struct Side<PieceColor::White>
+    {
+        static constexpr bool isWhite = true;
+        static constexpr PieceColor them = PieceColor::Black;
+        static constexpr int pawnDir = -1;  // y 감소 방향으로 전진
+        static constexpr int promoRank = 0;
+        static bool CanCastleK(const Board& b) { return b.m_whiteCanCastleK; }
+        static bool CanCastleQ(const Board& b) { return b.m_whiteCanCastleQ; }
+        static void LoseCastling(Board& b) { b.m_whiteCanCastleK = false; b.m_whiteCanCastleQ = false; }
+    };
+
+    template <> struct Side<PieceColor::Black>
+    {
+        static constexpr bool isWhite = false;
+        static constexpr PieceColor them = PieceColor::White;
+        static constexpr int pawnDir = 1;
+        static constexpr int promoRank = 7;
+        static bool CanCastleK(const Board& b) { return b.m_blackCanCastleK; }
+        static bool CanCastleQ(const Board& b) { return b.m_blackCanCastleQ; }
+        static void LoseCastling(Board& b) { b.m_blackCanCastleK = false; b.m_blackCanCastleQ = false; }
+    };
+
+    constexpr PieceColor k_white = PieceColor::White;
+    constexpr PieceColor k_black = PieceColor::Black;
+
+    // [추가] SEE용 기물 가치 (센티폰, PieceType 순서). 킹은 잡히면 끝이므로 아주 크게
+    const int k_seeValue[] = { 0, 100, 320, 330, 500, 900, 20000 };
+
+    // 한 칸을 두고 벌어지는 교환에 필요한 것만 모은 비트보드
+    // 종류별 비트는 그 칸에 닿을 수 있는 자리(나이트 / 킹 칸 + 빈 보드 기준 8방향 광선)만 채움
+    struct SeeBoard
+    {
+        int to;
+        uint64_t color[2];      // 0 = 백
+        uint64_t byType[7];
+        uint64_t bishopQueens;
+        uint64_t rookQueens;
 
-bool GameLogic::IsSquareAttacked(const Board& board, int x, int y, bool byWhite)
-{
-    PieceColor attackerColor = byWhite ? PieceColor::White : PieceColor::Black;
-
-    // 1. 폰 공격 확인
-    int pawnDir = byWhite ? -1 : 1; // 백폰(6->0)은 -1 방향으로 공격
-    // 공격자가 (x-1, y-dir) 또는 (x+1, y-dir)에 있어야 (x,y)를 공격함
-    // (주의: byWhite는 '공격하는 쪽' 기준)
-    // 백이 공격하려면 백폰은 (y+1)에 위치해야 y를 공격함 (y좌표가 줄어드는 방향이 전진이므로)
-    int attackY = y - pawnDir;
-    if (attackY >= 0 && attackY < 8) {
-        for (int dx = -1; dx <= 1; dx += 2) {
-            int nx = x + dx;
-            if (nx >= 0 && nx < 8) {
-                const Piece& p = board.GetPiece(nx, attackY);
-                if (p.type == PieceType::Pawn && p.color == attackerColor) return true;
+        SeeBoard(const Board& board, int square) : to(square), byType()
+        {
+            color[0] = board.Occupancy(true);
+            color[1] = board.Occupancy(false);
+            uint64_t reach = Geometry::KnightAttacks(to) | Geometry::KingAttacks(to) | Geometry::SliderAttacks(to, Geometry::k_queenDirs, 0);
+            for (uint64_t m = reach & (color[0] | color[1]); m; ) {
+                int sq = Geometry::PopLsb(m);
+                byType[(int)board.GetPiece(sq % 8, sq / 8).type] |= Geometry::SquareBit(sq);
             }
+            bishopQueens = byType[(int)PieceType::Bishop] | byType[(int)PieceType::Queen];
+            rookQueens = byType[(int)PieceType::Rook] | byType[(int)PieceType::Queen];
         }
-    }
 
-    // 2. 나이트 공격 확인
-    static const int k_offs[8][2] = { {1,2},{2,1},{2,-1},{1,-2},{-1,-2},{-2,-1},{-2,1},{-1,2} };
-    for (auto& o : k_offs) {
-        int nx = x + o[0], ny = y + o[1];
-        if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-            const Piece& p = board.GetPiece(nx, ny);
-            if (p.color == attackerColor && p.type == PieceType::Knight) return true;
+        // occupied 기준으로 to를 공격하는 양쪽 기물 (occupied 밖의 기물 제외)
+        uint64_t AttackersTo(uint64_t occupied) const
+        {
+            uint64_t pawns = byType[(int)PieceType::Pawn];
+            return ((Geometry::KnightAttacks(to) & byType[(int)PieceType::Knight])
+                | (Geometry::KingAttacks(to) & byType[(int)PieceType::King])
+                | (Geometry::PawnAttacks(false, to) & pawns & color[0])  // 백 폰은 to의 아래 대각선에 있음
+                | (Geometry::PawnAttacks(true, to) & pawns & color[1])
+                | (Geometry::SliderAttacks(to, Geometry::k_bishopDirs, occupied) & bishopQueens)
+                | (Geometry::SliderAttacks(to, Geometry::k_rookDirs, occupied) & rookQueens)) & occupied;
         }
-    }
 
-    // 3. 킹 공격 확인 (인접 8칸)
-    for (int dy = -1; dy <= 1; ++dy) {
-        for (int dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0) continue;
-            int nx = x + dx, ny = y + dy;
-            if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-                const Piece& p = board.GetPiece(nx, ny);
-                if (p.color == attackerColor && p.type == PieceType::King) return true;
-            }
+        // 기물 하나가 빠진 뒤 그 뒤에서 새로 열린 슬라이더 (x-ray)
+        uint64_t Uncovered(PieceType removed, uint64_t occupied) const
+        {
+            uint64_t result = 0;
+            if (removed == PieceType::Pawn || removed == PieceType::Bishop || removed == PieceType::Queen)
+                result |= Geometry::SliderAttacks(to, Geometry::k_bishopDirs, occupied) & bishopQueens;
+            if (removed == PieceType::Rook || removed == PieceType::Queen)
+                result |= Geometry::SliderAttacks(to, Geometry::k_rookDirs, occupied) & rookQueens;
+            return result & occupied;
         }
-    }
 
-    // 4. 직선(룩, 퀸) 및 대각선(비숍, 퀸) 슬라이딩 공격
-    // (상하좌우)
-    static const int rookDirs[4][2] = { {1,0},{-1,0},{0,1},{0,-1} };
-    for (auto& d : rookDirs) {
-        int nx = x + d[0], ny = y + d[1];
-        while (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-            const Piece& p = board.GetPiece(nx, ny);
-            if (p.type != PieceType::None) {
-                if (p.color == attackerColor && (p.type == PieceType::Rook || p.type == PieceType::Queen)) return true;
-                break;
-            }
-            nx += d[0]; ny += d[1];
-        }
-    }
-    // (대각선)
-    static const int bishopDirs[4][2] = { {1,1},{1,-1},{-1,1},{-1,-1} };
-    for (auto& d : bishopDirs) {
-        int nx = x + d[0], ny = y + d[1];
-        while (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-            const Piece& p = board.GetPiece(nx, ny);
-            if (p.type != PieceType::None) {
-                if (p.color == attackerColor && (p.type == PieceType::Bishop || p.type == PieceType::Queen)) return true;
-                break;
+        // 가장 싼 공격자 (attackers가 비어 있지 않아야 함)
+        PieceType LeastValuable(uint64_t attackers, uint64_t& outBit) const
+        {
+            for (int t = (int)PieceType::Pawn; t <= (int)PieceType::King; ++t) {
+                uint64_t b = attackers & byType[t];
+                if (b) {
+                    outBit = b & (0 - b);
+                    return (PieceType)t;
+                }
             }
-            nx += d[0]; ny += d[1];
+            outBit = 0;
+            return PieceType::None;
         }
-    }
+    };
 
-    return false;
-}
-
-bool GameLogic::IsKingInCheck(const Board& board, bool isWhiteKing)
-{
-    int kx = -1, ky = -1;
-    PieceColor target = isWhiteKing ? PieceColor::White : PieceColor::Black;
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            const Piece& p = board.GetPiece(x, y);
-            if (p.type == PieceType::King && p.color == target) {
-                kx = x; ky = y; break;
+    // 수 자체로 생기는 첫 득실: 잡은 기물 (앙파상 포함) + 승급 차익. 도착 칸에 서는 기물과 비워지는 칸도 돌려줌
+    int SeeFirstGain(const Board& board, const Move& move, PieceType& outOnSquare, uint64_t& outVacated)
+    {
+        const Piece& mover = board.GetPiece(move.sx, move.sy);
+        const Piece& victim = board.GetPiece(move.dx, move.dy);
+        int gain = k_seeValue[(int)victim.type];
+        outOnSquare = mover.type;
+        outVacated = Geometry::SquareBit(move.sy * 8 + move.sx);
+        if (mover.type == PieceType::Pawn) {
+            if (move.dx != move.sx && victim.type == PieceType::None) {
+                gain = k_seeValue[(int)PieceType::Pawn];
+                outVacated |= Geometry::SquareBit(move.sy * 8 + move.dx);
+            }
+            if (move.dy == 0 || move.dy == 7) {
+                outOnSquare = (move.promotion == PieceType::None) ? PieceType::Queen : move.promotion;
+                gain += k_seeValue[(int)outOnSquare] - k_seeValue[(int)PieceType::Pawn];
             }
         }
+        return gain;
     }
-    // 킹이 없으면(비정상) 체크 아님
-    if (kx == -1) return false;
-    // 내 킹이 상대방( !isWhiteKing )에 의해 공격받는지 확인
-    return IsSquareAttacked(board, kx, ky, !isWhiteKing);
 }
 
-bool GameLogic::HasLegalMoves(const Board& board, bool isWhiteTurn)
+GameLogic::GameLogic() {}
+
+template <PieceColor Us>
+bool GameLogic::IsMoveLegalBasic(const Board& board, const Move& move)
 {
-    // 모든 아군 기물에 대해
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; ++x) {
-            const Piece& p = board.GetPiece(x, y);
-            if (p.type == PieceType::None) continue;
-            if (isWhiteTurn && p.color != PieceColor::White) continue;
-            if (!isWhiteTurn && p.color != PieceColor::Black) continue;
-
-            std::vector<Move> moves;
-            GeneratePseudoLegalMoves(board, x, y, isWhiteTurn, moves);
-
-            for (const auto& mv : moves) {
-                // 수를 둬보고 킹이 안전한지 확인
-                Board temp = board;
-                if (ApplyMove(temp, mv, isWhiteTurn)) {
-                    // ApplyMove 내부에서 체크 검증까지 통과했다면 true
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    if (move.sx == move.dx && move.sy == move.dy) return false;
+    if (move.sx < 0 || move.sx >= 8 || move.sy < 0 || move.sy >= 8) return false;
+    if (move.dx < 0 || move.dx >= 8 || move.dy < 0 || move.dy >= 8) return false;
+
+    const Piece& from = board.GetPiece(move.sx, move.sy);
+    const Piece& to = board.GetPiece(move.dx, move.dy);
+
+    if (from.type == PieceType::None || from.color != Us) return false;
+    if (to.type != PieceType::None && to.color == Us) return false;
+
+    return true;
 }
 
-GameState GameLogic::CheckGameState(const Board& board, bool isWhiteTurn)
+template <PieceColor Us>
+bool GameLogic::IsKingInCheckT(const Board& board)
 {
-    // 1. 합법적인 수가 있는지 확인
-    if (HasLegalMoves(board, isWhiteTurn)) {
-        return GameState::Playing;
-    }
-
-    // 2. 합법수가 없으면 체크메이트 아니면 스테일메이트
-    if (IsKingInCheck(board, isWhiteTurn)) {
-        return GameState::Checkmate;
-    }
-    else {
-        return GameState::Stalemate;
-    }
+    int kx = -1, ky = -1;
+    // 킹이 없으면(비정상) 체크 아님
+    if (!board.FindKing(Side<Us>::isWhite, kx, ky)) return false;
+    // 내 킹이 상대방에 의해 공격받는지 확인
+    return board.IsAttacked(kx, ky, !Side<Us>::isWhite);
 }
 
-bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
+template <PieceColor Us>
+bool GameLogic::ApplyMoveT(Board& board, const Move& move)
 {
-    if (!IsMoveLegalBasic(board, move, isWhiteTurn)) return false;
+    using S = Side<Us>;
+    if (!IsMoveLegalBasic<Us>(board, move)) return false;
 
     Piece p = board.GetPiece(move.sx, move.sy);
     int dx = move.dx - move.sx;
@@ -166,23 +163,22 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
     // --- 규칙 검사 ---
     if (p.type == PieceType::Pawn)
     {
-        int dir = (p.color == PieceColor::White) ? -1 : 1;
         const Piece& target = board.GetPiece(move.dx, move.dy);
 
         if (absDx == 0) // 전진
         {
-            if (dy == dir && target.type == PieceType::None) {}
-            else if (!p.hasMoved && dy == 2 * dir && target.type == PieceType::None)
+            if (dy == S::pawnDir && target.type == PieceType::None) {}
+            else if (!p.hasMoved && dy == 2 * S::pawnDir && target.type == PieceType::None)
             {
-                int midY = move.sy + dir;
+                int midY = move.sy + S::pawnDir;
                 if (board.GetPiece(move.dx, midY).type != PieceType::None) return false;
                 board.m_enPassantX = move.sx; board.m_enPassantY = midY;
             }
             else return false;
         }
-        else if (absDx == 1 && dy == dir) // 대각선
+        else if (absDx == 1 && dy == S::pawnDir) // 대각선
         {
-            if (target.type != PieceType::None && target.color != p.color) {}
+            if (target.type != PieceType::None && target.color == S::them) {}
             else if (move.dx == board.m_enPassantX && move.dy == board.m_enPassantY) {
                 board.SetPiece(move.dx, move.sy, Piece()); // 앙파상 캡처
             }
@@ -195,7 +191,7 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
         if (absDx == 2 && dy == 0) // 캐슬링
         {
             if (p.hasMoved) return false;
-            if (IsKingInCheck(board, isWhiteTurn)) return false; // 체크 상태에선 캐슬링 불가
+            if (IsKingInCheckT<Us>(board)) return false; // 체크 상태에선 캐슬링 불가
 
             int rookX = (dx > 0) ? 7 : 0;
             int rookDx = (dx > 0) ? 5 : 3;
@@ -208,25 +204,21 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
                 if (board.GetPiece(k, move.sy).type != PieceType::None) return false;
                 // 킹의 이동 경로(최종 위치 포함 전까지)가 공격받으면 안됨
                 // (단순 구현: 이동 전, 이동 중, 이동 후 체크는 호출자가 검증한다고 가정하거나 여기서 체크)
-                if (std::abs(k - move.sx) <= 2 && IsSquareAttacked(board, k, move.sy, !isWhiteTurn)) return false;
+                if (std::abs(k - move.sx) <= 2 && board.IsAttacked(k, move.sy, !S::isWhite)) return false;
             }
             board.MovePieceRaw(rookX, move.sy, rookDx, move.sy);
         }
         else if (absDx > 1 || absDy > 1) return false;
     }
-    else if (p.type == PieceType::Knight) { if (!((absDx == 1 && absDy == 2) || (absDx == 2 && absDy == 1))) return false; }
+    else if (p.type == PieceType::Knight) { if (!(Geometry::KnightAttacks(move.sy * 8 + move.sx) & Geometry::SquareBit(move.dy * 8 + move.dx))) return false; }
     else if (p.type == PieceType::Rook) { if (dx != 0 && dy != 0) return false; }
     else if (p.type == PieceType::Bishop) { if (absDx != absDy) return false; }
     else if (p.type == PieceType::Queen) { if ((dx != 0 && dy != 0) && (absDx != absDy)) return false; }
 
+    // [변경] 경로 칸을 하나씩 걷는 대신 사이 칸 테이블과 점유 비트 비교
     if (p.type == PieceType::Rook || p.type == PieceType::Bishop || p.type == PieceType::Queen) {
-        int stepX = (dx == 0) ? 0 : (dx > 0 ? 1 : -1);
-        int stepY = (dy == 0) ? 0 : (dy > 0 ? 1 : -1);
-        int cx = move.sx + stepX; int cy = move.sy + stepY;
-        while (cx != move.dx || cy != move.dy) {
-            if (board.GetPiece(cx, cy).type != PieceType::None) return false;
-            cx += stepX; cy += stepY;
-        }
+        uint64_t occupied = board.Occupancy(true) | board.Occupancy(false);
+        if (Geometry::Between(move.sy * 8 + move.sx, move.dy * 8 + move.dx) & occupied) return false;
     }
 
     // --- 실제 이동 적용 ---
@@ -237,7 +229,7 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
     board.MovePieceRaw(move.sx, move.sy, move.dx, move.dy);
 
     // [승급 로직 수정]
-    if (p.type == PieceType::Pawn && (move.dy == 0 || move.dy == 7))
+    if (p.type == PieceType::Pawn && move.dy == S::promoRank)
     {
         Piece promo = board.GetPiece(move.dx, move.dy);
         // move.promotion에 값이 있으면 그걸로, 없으면 퀸(기본값)
@@ -246,10 +238,7 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
     }
 
     // 캐슬링 권한 상실
-    if (p.type == PieceType::King) {
-        if (p.color == PieceColor::White) { board.m_whiteCanCastleK = false; board.m_whiteCanCastleQ = false; }
-        else { board.m_blackCanCastleK = false; board.m_blackCanCastleQ = false; }
-    }
+    if (p.type == PieceType::King) S::LoseCastling(board);
     if (p.type == PieceType::Rook) {
         if (move.sx == 0 && move.sy == 7) board.m_whiteCanCastleQ = false;
         if (move.sx == 7 && move.sy == 7) board.m_whiteCanCastleK = false;
@@ -258,72 +247,373 @@ bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
     }
 
     // [중요] 이동 후 내 킹이 체크 상태면 이동 취소 (불법수)
-    if (IsKingInCheck(board, isWhiteTurn)) return false; // (Board는 값 복사로 넘어오므로 원본 영향 없음)
+    if (IsKingInCheckT<Us>(board)) return false; // (Board는 값 복사로 넘어오므로 원본 영향 없음)
 
     return true;
 }
 
-void GameLogic::GeneratePseudoLegalMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves)
+template <PieceColor Us>
+void GameLogic::GeneratePseudoLegalMovesT(const Board& board, int x, int y, std::vector<Move>& outMoves)
 {
+    using S = Side<Us>;
     outMoves.clear();
     const Piece& p = board.GetPiece(x, y);
-    if (p.type == PieceType::None) return;
-    if (isWhiteTurn && p.color != PieceColor::White) return;
-    if (!isWhiteTurn && p.color != PieceColor::Black) return;
+    if (p.type == PieceType::None || p.color != Us) return;
 
     switch (p.type) {
-    case PieceType::Pawn:   AddPawnMoves(board, x, y, isWhiteTurn, outMoves); break;
-    case PieceType::Knight: AddKnightMoves(board, x, y, isWhiteTurn, outMoves); break;
-    case PieceType::Bishop: { static const int d[4][2] = { {1,1},{1,-1},{-1,1},{-1,-1} }; AddSlidingMoves(board, x, y, d, 4, isWhiteTurn, outMoves); break; }
-    case PieceType::Rook: { static const int d[4][2] = { {1,0},{-1,0},{0,1},{0,-1} }; AddSlidingMoves(board, x, y, d, 4, isWhiteTurn, outMoves); break; }
-    case PieceType::Queen: { static const int d[8][2] = { {1,0},{-1,0},{0,1},{0,-1},{1,1},{1,-1},{-1,1},{-1,-1} }; AddSlidingMoves(board, x, y, d, 8, isWhiteTurn, outMoves); break; }
+    case PieceType::Pawn:   AddPawnMoves<Us>(board, x, y, outMoves); break;
+    case PieceType::Knight: AddKnightMoves<Us>(board, x, y, outMoves); break;
+    case PieceType::Bishop: AddSlidingMoves<Us>(board, x, y, Geometry::k_bishopDirs, outMoves); break;
+    case PieceType::Rook:   AddSlidingMoves<Us>(board, x, y, Geometry::k_rookDirs, outMoves); break;
+    case PieceType::Queen:  AddSlidingMoves<Us>(board, x, y, Geometry::k_queenDirs, outMoves); break;
     case PieceType::King: {
-        for (int dy = -1; dy <= 1; ++dy) for (int dx = -1; dx <= 1; ++dx) {
-            if (dx == 0 && dy == 0) continue;
-            Move mv{ x, y, x + dx, y + dy };
-            if (IsMoveLegalBasic(board, mv, isWhiteTurn)) outMoves.push_back(mv);
-        }
-        Move ck{ x, y, x + 2, y }; Board t = board; if (ApplyMove(t, ck, isWhiteTurn)) outMoves.push_back(ck);
-        Move cq{ x, y, x - 2, y }; t = board; if (ApplyMove(t, cq, isWhiteTurn)) outMoves.push_back(cq);
+        AddTargets(x, y, Geometry::KingAttacks(y * 8 + x) & ~board.Occupancy(S::isWhite), outMoves);
+        // [최적화] 캐슬링 권한이 없으면 ApplyMove도 실패하므로 보드 복사 전에 걸러냄
+        if (!p.hasMoved && S::CanCastleK(board)) { Move ck{ x, y, x + 2, y }; Board t = board; if (ApplyMoveT<Us>(t, ck)) outMoves.push_back(ck); }
+        if (!p.hasMoved && S::CanCastleQ(board)) { Move cq{ x, y, x - 2, y }; Board t = board; if (ApplyMoveT<Us>(t, cq)) outMoves.push_back(cq); }
         break;
     }
+    default: break;
     }
 }
 
-void GameLogic::AddPawnMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves) {
+template <PieceColor Us>
+void GameLogic::GenerateLegalMovesT(const Board& board, std::vector<Move>& outMoves)
+{
+    outMoves.clear();
+    std::vector<Move> pseudo;
+    // [추가] 체크 판정용 정보는 국면마다 한 번 (수마다 상대 킹 공격을 다시 보지 않음)
+    CheckInfo info;
+    ComputeCheckInfo(board, Side<Us>::isWhite, info);
+    uint64_t own = board.Occupancy(Side<Us>::isWhite);
+    while (own) {
+        int sq = Geometry::PopLsb(own);
+        GeneratePseudoLegalMovesT<Us>(board, sq % 8, sq / 8, pseudo);
+        for (const auto& mv : pseudo) {
+            Board temp = board;
+            if (!ApplyMoveT<Us>(temp, mv)) continue;
+
+            const Piece& p = board.GetPiece(mv.sx, mv.sy);
+            if (p.type == PieceType::Pawn && mv.dy == Side<Us>::promoRank) {
+                static const PieceType promos[] = { PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight };
+                for (PieceType t : promos) {
+                    Move pm = mv; pm.promotion = t;
+                    pm.check = GivesCheck(board, pm, info);
+                    outMoves.push_back(pm);
+                }
+            }
+            else {
+                outMoves.push_back(mv);
+                outMoves.back().check = GivesCheck(board, mv, info);
+            }
+        }
+    }
+}
+
+template <PieceColor Us>
+void GameLogic::AddPawnMoves(const Board& board, int x, int y, std::vector<Move>& outMoves) {
+    using S = Side<Us>;
     const Piece& p = board.GetPiece(x, y);
-    int dir = (p.color == PieceColor::White) ? -1 : 1;
-    int ny = y + dir;
+    int ny = y + S::pawnDir;
     if (ny >= 0 && ny < 8 && board.GetPiece(x, ny).type == PieceType::None) {
         outMoves.push_back({ x, y, x, ny });
-        if (!p.hasMoved && y + 2 * dir >= 0 && y + 2 * dir < 8 && board.GetPiece(x, y + 2 * dir).type == PieceType::None)
-            outMoves.push_back({ x, y, x, y + 2 * dir });
+        int ny2 = y + 2 * S::pawnDir;
+        if (!p.hasMoved && ny2 >= 0 && ny2 < 8 && board.GetPiece(x, ny2).type == PieceType::None)
+            outMoves.push_back({ x, y, x, ny2 });
     }
-    for (int dx = -1; dx <= 1; dx += 2) {
-        int nx = x + dx;
-        if (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-            const Piece& t = board.GetPiece(nx, ny);
-            if (t.type != PieceType::None && t.color != p.color) outMoves.push_back({ x, y, nx, ny });
-            else if (nx == board.m_enPassantX && ny == board.m_enPassantY) outMoves.push_back({ x, y, nx, ny });
-        }
+    // [변경] 대각선 두 칸은 폰 공격 테이블에서 (상대 기물 또는 앙파상 칸)
+    uint64_t targets = Geometry::PawnAttacks(S::isWhite, y * 8 + x) & board.Occupancy(!S::isWhite);
+    if (board.m_enPassantX >= 0 && board.m_enPassantY == ny)
+        targets |= Geometry::PawnAttacks(S::isWhite, y * 8 + x) & Geometry::SquareBit(board.m_enPassantY * 8 + board.m_enPassantX);
+    AddTargets(x, y, targets, outMoves);
+}
+// [변경] 오프셋 + 경계 검사 대신 컴파일 타임 공격 테이블에서 아군 칸만 제외
+template <PieceColor Us>
+void GameLogic::AddKnightMoves(const Board& board, int x, int y, std::vector<Move>& outMoves) {
+    AddTargets(x, y, Geometry::KnightAttacks(y * 8 + x) & ~board.Occupancy(Side<Us>::isWhite), outMoves);
+}
+template <PieceColor Us>
+void GameLogic::AddSlidingMoves(const Board& board, int x, int y, unsigned dirs, std::vector<Move>& outMoves) {
+    uint64_t occupied = board.Occupancy(true) | board.Occupancy(false);
+    AddTargets(x, y, Geometry::SliderAttacks(y * 8 + x, dirs, occupied) & ~board.Occupancy(Side<Us>::isWhite), outMoves);
+}
+void GameLogic::AddTargets(int x, int y, uint64_t targets, std::vector<Move>& outMoves) {
+    while (targets) {
+        int sq = Geometry::PopLsb(targets);
+        outMoves.push_back({ x, y, sq % 8, sq / 8 });
     }
 }
-void GameLogic::AddKnightMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves) {
-    static const int o[8][2] = { {1,2},{2,1},{2,-1},{1,-2},{-1,-2},{-2,-1},{-2,1},{-1,2} };
-    for (auto& k : o) { Move mv{ x, y, x + k[0], y + k[1] }; if (IsMoveLegalBasic(board, mv, isWhiteTurn)) outMoves.push_back(mv); }
+
+// --- 공개 함수: isWhiteTurn으로 한 번만 분기해 색별 구현 호출 ---
+
+// [변경] Board가 증분 갱신하는 공격 비트맵 조회 (이전: 매 호출마다 8방향 광선 + 나이트/폰/킹 스캔)
+bool GameLogic::IsSquareAttacked(const Board& board, int x, int y, bool byWhite)
+{
+    return board.IsAttacked(x, y, byWhite);
+}
+
+bool GameLogic::IsKingInCheck(const Board& board, bool isWhiteKing)
+{
+    return isWhiteKing ? IsKingInCheckT<k_white>(board) : IsKingInCheckT<k_black>(board);
 }
-void GameLogic::AddSlidingMoves(const Board& board, int x, int y, const int dirs[][2], int dirCount, bool isWhiteTurn, std::vector<Move>& outMoves) {
-    for (int d = 0; d < dirCount; ++d) {
-        int nx = x + dirs[d][0], ny = y + dirs[d][1];
-        while (nx >= 0 && nx < 8 && ny >= 0 && ny < 8) {
-            Move mv{ x, y, nx, ny };
-            const Piece& t = board.GetPiece(nx, ny);
-            if (t.type != PieceType::None) {
-                if (t.color != (isWhiteTurn ? PieceColor::White : PieceColor::Black)) outMoves.push_back(mv);
+
+// [변경] 공격자 / 방어자 수와 가치 비교 -> 가장 싼 공격자로 잡는 교환이 이득(SEE > 0)인지로 판정
+// x-ray 방어자, 방어자가 모자라 결국 잃는 경우까지 반영
+uint64_t GameLogic::HangingPieces(const Board& board, bool white)
+{
+    uint64_t result = 0;
+    uint64_t targets = board.Occupancy(white) & board.AttackMap(!white);
+    while (targets) {
+        int sq = Geometry::PopLsb(targets);
+        int x = sq % 8, y = sq / 8;
+        if (board.GetPiece(x, y).type == PieceType::King) continue;
+
+        // 앞에서부터 가장 싼 공격자가 아니어도 되도록 공격자마다 확인 (보통 한두 개)
+        for (uint64_t attackers = board.AttackersOf(x, y, !white); attackers; ) {
+            int s = Geometry::PopLsb(attackers);
+            Move capture;
+            capture.sx = s % 8; capture.sy = s / 8;
+            capture.dx = x; capture.dy = y;
+            if (SeeGe(board, capture, 1)) {
+                result |= Geometry::SquareBit(sq);
                 break;
             }
-            outMoves.push_back(mv);
-            nx += dirs[d][0]; ny += dirs[d][1];
         }
     }
-}
\ No newline at end of file
+    return result;
+}
+
+int GameLogic::See(const Board& board, const Move& move)
+{
+    int to = move.dy * 8 + move.dx;
+    const Piece& mover = board.GetPiece(move.sx, move.sy);
+    if (mover.type == PieceType::None) return 0;
+
+    SeeBoard sb(board, to);
+    PieceType onSquare;
+    uint64_t vacated;
+    int gain[40]; // 교환은 기물 수(32)를 넘지 않음
+    gain[0] = SeeFirstGain(board, move, onSquare, vacated);
+
+    uint64_t occupied = (sb.color[0] | sb.color[1]) & ~vacated;
+    uint64_t attackers = sb.AttackersTo(occupied);
+    bool promoSquare = move.dy == 0 || move.dy == 7;
+    int side = (mover.color == PieceColor::White) ? 1 : 0; // 다음에 잡을 쪽
+    int d = 0;
+
+    for (;;) {
+        uint64_t mine = attackers & sb.color[side];
+        if (!mine) break;
+        uint64_t bit;
+        PieceType t = sb.LeastValuable(mine, bit);
+        // 상대 공격자가 남아 있으면 킹은 잡으러 들어갈 수 없음
+        if (t == PieceType::King && (attackers & sb.color[side ^ 1])) break;
+
+        ++d;
+        gain[d] = k_seeValue[(int)onSquare] - gain[d - 1];
+        onSquare = t;
+        if (t == PieceType::Pawn && promoSquare) {
+            gain[d] += k_seeValue[(int)PieceType::Queen] - k_seeValue[(int)PieceType::Pawn];
+            onSquare = PieceType::Queen;
+        }
+        occupied ^= bit;
+        attackers = (attackers & occupied) | sb.Uncovered(t, occupied);
+        side ^= 1;
+    }
+
+    // 뒤에서부터: 각 쪽은 잡거나 멈출 수 있음
+    for (; d > 0; --d)
+        gain[d - 1] = -(-gain[d - 1] > gain[d] ? -gain[d - 1] : gain[d]);
+    return gain[0];
+}
+
+bool GameLogic::SeeGe(const Board& board, const Move& move, int threshold)
+{
+    int to = move.dy * 8 + move.dx;
+    const Piece& mover = board.GetPiece(move.sx, move.sy);
+    if (mover.type == PieceType::None) return threshold <= 0;
+
+    SeeBoard sb(board, to);
+    PieceType onSquare;
+    uint64_t vacated;
+    int firstGain = SeeFirstGain(board, move, onSquare, vacated);
+    uint64_t occupied = (sb.color[0] | sb.color[1]) & ~vacated;
+    uint64_t attackers = sb.AttackersTo(occupied);
+
+    // 폰이 승급 칸에서 되잡으면 기물 가치가 바뀌어 아래 누적식이 맞지 않음 -> 전체 계산 (드묾)
+    if ((move.dy == 0 || move.dy == 7) && (attackers & sb.byType[(int)PieceType::Pawn]))
+        return See(board, move) >= threshold;
+
+    // swap = 지금까지의 득실 - threshold. 상대가 다시 잡아도 이 이상이면 바로 참, 잡기 전부터 모자라면 바로 거짓
+    int swap = firstGain - threshold;
+    if (swap < 0) return false;
+    swap = k_seeValue[(int)onSquare] - swap;
+    if (swap <= 0) return true;
+
+    int side = (mover.color == PieceColor::White) ? 0 : 1;
+    int result = 1;
+
+    for (;;) {
+        side ^= 1;
+        uint64_t mine = attackers & sb.color[side];
+        if (!mine) break;
+        result ^= 1;
+
+        uint64_t bit;
+        PieceType t = sb.LeastValuable(mine, bit);
+        if (t == PieceType::King)
+            return (attackers & sb.color[side ^ 1]) ? !result : result != 0;
+        // 이번에 잡은 쪽이 그 기물을 잃어도 결과가 바뀌지 않으면 끝
+        swap = k_seeValue[(int)t] - swap;
+        if (swap < result) break;
+
+        occupied ^= bit;
+        attackers = (attackers & occupied) | sb.Uncovered(t, occupied);
+    }
+    return result != 0;
+}
+
+// [변경] 수마다 보드를 복사해 둬 보던 방식 -> 단계별 생성기에서 첫 합법수가 나오면 끝
+bool GameLogic::HasLegalMoves(const Board& board, bool isWhiteTurn)
+{
+    MovePicker picker(board, isWhiteTurn);
+    Move mv;
+    return picker.Next(mv);
+}
+
+GameState GameLogic::CheckGameState(const Board& board, bool isWhiteTurn)
+{
+    TRACE_SCOPE("CheckGameState", "core");
+    // 1. 합법적인 수가 있는지 확인
+    if (HasLegalMoves(board, isWhiteTurn)) {
+        return GameState::Playing;
+    }
+
+    // 2. 합법수가 없으면 체크메이트 아니면 스테일메이트
+    if (IsKingInCheck(board, isWhiteTurn)) {
+        return GameState::Checkmate;
+    }
+    else {
+        return GameState::Stalemate;
+    }
+}
+
+void GameLogic::ComputeCheckInfo(const Board& board, bool isWhiteTurn, CheckInfo& outInfo)
+{
+    outInfo = CheckInfo();
+    int kx = -1, ky = -1;
+    if (!board.FindKing(!isWhiteTurn, kx, ky)) return;
+    int k = ky * 8 + kx;
+    uint64_t occupied = board.Occupancy(true) | board.Occupancy(false);
+    uint64_t own = board.Occupancy(isWhiteTurn);
+    outInfo.enemyKing = k;
+    outInfo.occupied = occupied;
+
+    uint64_t diagonal = Geometry::SliderAttacks(k, Geometry::k_bishopDirs, occupied);
+    uint64_t straight = Geometry::SliderAttacks(k, Geometry::k_rookDirs, occupied);
+    outInfo.checkSquares[(int)PieceType::Pawn] = Geometry::PawnAttacks(!isWhiteTurn, k); // 내 폰이 k를 공격하는 칸
+    outInfo.checkSquares[(int)PieceType::Knight] = Geometry::KnightAttacks(k);
+    outInfo.checkSquares[(int)PieceType::Bishop] = diagonal;
+    outInfo.checkSquares[(int)PieceType::Rook] = straight;
+    outInfo.checkSquares[(int)PieceType::Queen] = diagonal | straight;
+
+    for (uint64_t m = own; m; ) {
+        int sq = Geometry::PopLsb(m);
+        PieceType t = board.GetPiece(sq % 8, sq / 8).type;
+        if (t == PieceType::Rook || t == PieceType::Queen) outInfo.rookQueens |= Geometry::SquareBit(sq);
+        if (t == PieceType::Bishop || t == PieceType::Queen) outInfo.bishopQueens |= Geometry::SquareBit(sq);
+    }
+
+    // 킹에서 본 첫 기물이 내 것이면 그 뒤(x-ray)에 같은 선의 내 슬라이더가 있는지
+    uint64_t xrayDiagonal = Geometry::SliderAttacks(k, Geometry::k_bishopDirs, occupied & ~(diagonal & own));
+    uint64_t xrayStraight = Geometry::SliderAttacks(k, Geometry::k_rookDirs, occupied & ~(straight & own));
+    uint64_t snipers = (xrayDiagonal & ~diagonal & outInfo.bishopQueens) | (xrayStraight & ~straight & outInfo.rookQueens);
+    while (snipers) {
+        int s = Geometry::PopLsb(snipers);
+        outInfo.discoverers |= Geometry::Between(s, k) & own;
+    }
+}
+
+uint8_t GameLogic::GivesCheck(const Board& board, const Move& move, const CheckInfo& info)
+{
+    int k = info.enemyKing;
+    if (k < 0) return 0;
+    int from = move.sy * 8 + move.sx;
+    int to = move.dy * 8 + move.dx;
+    uint64_t fromBit = Geometry::SquareBit(from), toBit = Geometry::SquareBit(to), kingBit = Geometry::SquareBit(k);
+    PieceType type = board.GetPiece(move.sx, move.sy).type;
+    uint8_t result = 0;
+
+    // 캐슬링: 룩이 직접, 킹이 비킨 선의 슬라이더가 발견 체크 (킹 / 룩 네 칸이 바뀌므로 점유를 새로 만듦)
+    if (type == PieceType::King && std::abs(move.dx - move.sx) == 2) {
+        int rookFrom = move.sy * 8 + ((move.dx > move.sx) ? 7 : 0);
+        int rookTo = move.sy * 8 + ((move.dx > move.sx) ? 5 : 3);
+        uint64_t occupied = (info.occupied & ~fromBit & ~Geometry::SquareBit(rookFrom)) | toBit | Geometry::SquareBit(rookTo);
+        if (Geometry::SliderAttacks(rookTo, Geometry::k_rookDirs, occupied) & kingBit) result |= Move::k_checkDirect;
+        uint64_t rooks = info.rookQueens & ~Geometry::SquareBit(rookFrom);
+        if ((Geometry::SliderAttacks(k, Geometry::k_rookDirs, occupied) & rooks)
+            || (Geometry::SliderAttacks(k, Geometry::k_bishopDirs, occupied) & info.bishopQueens))
+            result |= Move::k_checkDiscovered;
+        return result;
+    }
+
+    // 앙파상: 잡힌 폰 칸까지 비므로 그 선의 슬라이더도 확인
+    if (type == PieceType::Pawn && move.dx != move.sx && board.GetPiece(move.dx, move.dy).type == PieceType::None) {
+        if (info.checkSquares[(int)PieceType::Pawn] & toBit) result |= Move::k_checkDirect;
+        uint64_t captured = Geometry::SquareBit(move.sy * 8 + move.dx);
+        uint64_t occupied = (info.occupied & ~fromBit & ~captured) | toBit;
+        if ((Geometry::SliderAttacks(k, Geometry::k_rookDirs, occupied) & info.rookQueens)
+            || (Geometry::SliderAttacks(k, Geometry::k_bishopDirs, occupied) & info.bishopQueens))
+            result |= Move::k_checkDiscovered;
+        return result;
+    }
+
+    // 직접 체크. 승급한 기물은 방금 비운 출발 칸을 지나 체크할 수 있어 출발 칸을 빼고 계산
+    bool promotion = type == PieceType::Pawn && (move.dy == 0 || move.dy == 7);
+    if (promotion) {
+        PieceType promo = (move.promotion != PieceType::None) ? move.promotion : PieceType::Queen;
+        uint64_t occupied = info.occupied & ~fromBit;
+        uint64_t attacks = 0;
+        switch (promo) {
+        case PieceType::Knight: attacks = Geometry::KnightAttacks(to); break;
+        case PieceType::Bishop: attacks = Geometry::SliderAttacks(to, Geometry::k_bishopDirs, occupied); break;
+        case PieceType::Rook:   attacks = Geometry::SliderAttacks(to, Geometry::k_rookDirs, occupied); break;
+        default:                attacks = Geometry::SliderAttacks(to, Geometry::k_queenDirs, occupied); break;
+        }
+        if (attacks & kingBit) result |= Move::k_checkDirect;
+    }
+    else if (info.checkSquares[(int)type] & toBit) {
+        result |= Move::k_checkDirect;
+    }
+
+    // 발견 체크: 막고 있던 기물이 그 선 밖으로 나감
+    if ((info.discoverers & fromBit) && !(Geometry::Line(from, k) & toBit))
+        result |= Move::k_checkDiscovered;
+    return result;
+}
+
+uint8_t GameLogic::GivesCheck(const Board& board, const Move& move, bool isWhiteTurn)
+{
+    CheckInfo info;
+    ComputeCheckInfo(board, isWhiteTurn, info);
+    return GivesCheck(board, move, info);
+}
+
+bool GameLogic::ApplyMove(Board& board, const Move& move, bool isWhiteTurn)
+{
+    TRACE_SCOPE("ApplyMove", "core");
+    return isWhiteTurn ? ApplyMoveT<k_white>(board, move) : ApplyMoveT<k_black>(board, move);
+}
+
+void GameLogic::GeneratePseudoLegalMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves)
+{
+    if (isWhiteTurn) GeneratePseudoLegalMovesT<k_white>(board, x, y, outMoves);
+    else GeneratePseudoLegalMovesT<k_black>(board, x, y, outMoves);
+}
+
+void GameLogic::GenerateLegalMoves(const Board& board, bool isWhiteTurn, std::vector<Move>& outMoves)
+{
+    TRACE_SCOPE("GenerateLegalMoves", "core");
+    if (isWhiteTurn) GenerateLegalMovesT<k_white>(board, outMoves);
+    else GenerateLegalMovesT<k_black>(board, outMoves);
+}
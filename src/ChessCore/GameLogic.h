@@ -17,6 +17,23 @@ struct Move
     int dx = 0;
     int dy = 0;
     PieceType promotion = PieceType::None;
+    // [추가] 이 수가 상대 킹에 거는 체크 (GenerateLegalMoves가 채움, 비트 조합: 둘 다면 이중 체크)
+    uint8_t check = 0;
+
+    static const uint8_t k_checkDirect = 1;     // 움직인 기물이 직접 체크
+    static const uint8_t k_checkDiscovered = 2; // 비켜난 자리로 뒤의 슬라이더가 체크
+    bool GivesCheck() const { return check != 0; }
+};
+
+// [추가] 수를 두지 않고 체크 여부를 판정하기 위한 국면 정보 (둘 차례 기준, 국면마다 한 번 계산)
+struct CheckInfo
+{
+    int enemyKing = -1;             // 상대 킹 칸 (없으면 -1 -> 체크 없음)
+    uint64_t occupied = 0;
+    uint64_t checkSquares[7] = {};  // PieceType별: 그 종류의 내 기물이 이 칸에 서면 직접 체크
+    uint64_t discoverers = 0;       // 내 슬라이더와 상대 킹 사이의 유일한 기물 중 내 것 (비키면 발견 체크)
+    uint64_t rookQueens = 0;        // 내 룩 / 퀸 위치 (캐슬링 / 앙파상처럼 칸이 여럿 바뀌는 수용)
+    uint64_t bishopQueens = 0;
 };
 
 class GameLogic
@@ -26,15 +43,41 @@ public:
 
     bool ApplyMove(Board& board, const Move& move, bool isWhiteTurn);
     void GeneratePseudoLegalMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves);
+    // [추가] 둘 차례인 쪽의 모든 합법수 (승급은 Q/R/B/N 네 수로 펼침)
+    void GenerateLegalMoves(const Board& board, bool isWhiteTurn, std::vector<Move>& outMoves);
     bool IsKingInCheck(const Board& board, bool isWhiteKing);
+    // [변경] private -> public (벤치마크 / 위협 표시 등 외부에서 칸 공격 여부 조회)
+    bool IsSquareAttacked(const Board& board, int x, int y, bool byWhite);
+    // [추가] 걸려 있는 기물: 상대가 잡아서 교환 이득(SEE > 0)을 보는 기물 (비트 = y * 8 + x)
+    uint64_t HangingPieces(const Board& board, bool white);
+    // [추가] 정적 교환 평가 (SEE): move의 도착 칸에서 양쪽이 가장 싼 기물부터 번갈아 잡을 때 수를 둔 쪽의 득실 (센티폰)
+    // 슬라이더 뒤의 x-ray 공격자 포함, 핀은 보지 않음. 할당 없음. 잡지 않는 수면 그 칸이 안전한지(0 / 음수)
+    int See(const Board& board, const Move& move);
+    // See(board, move) >= threshold 와 같은 결과. 득실이 정해지는 순간 끝냄
+    bool SeeGe(const Board& board, const Move& move, int threshold);
     GameState CheckGameState(const Board& board, bool isWhiteTurn);
 
+    // [추가] 체크 판정 (수를 둬 보고 공격을 다시 계산하지 않음). 반환값 = Move::check 비트
+    // move는 board에서 합법수여야 함. 여러 수를 판정할 때는 CheckInfo를 한 번만 계산해 재사용
+    void ComputeCheckInfo(const Board& board, bool isWhiteTurn, CheckInfo& outInfo);
+    uint8_t GivesCheck(const Board& board, const Move& move, const CheckInfo& info);
+    uint8_t GivesCheck(const Board& board, const Move& move, bool isWhiteTurn);
+
 private:
-    bool IsMoveLegalBasic(const Board& board, const Move& move, bool isWhiteTurn);
-    bool IsSquareAttacked(const Board& board, int x, int y, bool byWhite);
     bool HasLegalMoves(const Board& board, bool isWhiteTurn);
 
-    void AddPawnMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves);
-    void AddKnightMoves(const Board& board, int x, int y, bool isWhiteTurn, std::vector<Move>& outMoves);
-    void AddSlidingMoves(const Board& board, int x, int y, const int dirs[][2], int dirCount, bool isWhiteTurn, std::vector<Move>& outMoves);
+    // [변경] 둘 차례 색으로 특수화한 구현 (공개 함수는 isWhiteTurn으로 한 번만 분기)
+    // 폰 방향 / 승급 랭크 / 아군 마스크 / 캐슬링 플래그가 컴파일 타임 상수로 접힘
+    template <PieceColor Us> bool IsMoveLegalBasic(const Board& board, const Move& move);
+    template <PieceColor Us> bool IsKingInCheckT(const Board& board);
+    template <PieceColor Us> bool ApplyMoveT(Board& board, const Move& move);
+    template <PieceColor Us> void GeneratePseudoLegalMovesT(const Board& board, int x, int y, std::vector<Move>& outMoves);
+    template <PieceColor Us> void GenerateLegalMovesT(const Board& board, std::vector<Move>& outMoves);
+
+    template <PieceColor Us> void AddPawnMoves(const Board& board, int x, int y, std::vector<Move>& outMoves);
+    template <PieceColor Us> void AddKnightMoves(const Board& board, int x, int y, std::vector<Move>& outMoves);
+    // 방향은 Geometry 방향 비트 (k_rookDirs / k_bishopDirs / k_queenDirs)
+    template <PieceColor Us> void AddSlidingMoves(const Board& board, int x, int y, unsigned dirs, std::vector<Move>& outMoves);
+    // 도착 칸 비트마다 수 추가
+    void AddTargets(int x, int y, uint64_t targets, std::vector<Move>& outMoves);
 };
\ No newline at end of file
@@ -0,0 +1,249 @@
+﻿#include "GameTree.h"
+#include <algorithm>
+#include "Fen.h"
+#include "Zobrist.h"
+
+GameTree::GameTree()
+{
+    Reset();
+}
+
+bool GameTree::Reset(const std::string& fen)
+{
+    Board board;
+    bool isWhiteTurn = true;
+    if (!fen.empty() && !Fen::FENToBoard(fen, board, isWhiteTurn)) return false;
+    board.ClearHistory();
+
+    m_board = board;
+    m_isWhiteTurn = m_startWhite = isWhiteTurn;
+    m_startFen = fen;
+    m_count = 0;
+    m_comments.clear();
+
+    uint32_t root = Allocate();
+    At(root).key = Zobrist::Key(m_board, m_isWhiteTurn);
+    m_path.assign(1, root);
+    return true;
+}
+
+uint32_t GameTree::Allocate()
+{
+    if ((m_count >> k_blockShift) >= m_blocks.size())
+        m_blocks.emplace_back(new GameTreeNode[1u << k_blockShift]);
+    uint32_t node = m_count++;
+    GameTreeNode& n = At(node);
+    n.key = 0;
+    n.parent = n.firstChild = n.nextSibling = k_none;
+    n.move = 0;
+    n.nag = 0;
+    n.flags = 0;
+    return node;
+}
+
+uint16_t GameTree::Pack(const Move& move)
+{
+    return (uint16_t)((move.sy * 8 + move.sx) | ((move.dy * 8 + move.dx) << 6) | ((int)move.promotion << 12));
+}
+
+// 형제 중 node에만 Selected 표시 (형제 수는 보통 한두 개)
+void GameTree::Select(uint32_t node)
+{
+    for (uint32_t c = At(At(node).parent).firstChild; c != k_none; c = At(c).nextSibling)
+        At(c).flags &= (uint8_t)~Selected;
+    At(node).flags |= Selected;
+}
+
+// 현재 노드의 자식 node로 한 수 (node는 이미 검증된 수)
+void GameTree::Descend(uint32_t node)
+{
+    m_board.PushState(m_isWhiteTurn);
+    m_logic.ApplyMove(m_board, MoveOf(node), m_isWhiteTurn);
+    m_isWhiteTurn = !m_isWhiteTurn;
+    m_path.push_back(node);
+    Select(node);
+}
+
+Move GameTree::Unpack(uint16_t packed)
+{
+    Move mv;
+    mv.sx = packed & 7;
+    mv.sy = (packed >> 3) & 7;
+    mv.dx = (packed >> 6) & 7;
+    mv.dy = (packed >> 9) & 7;
+    mv.promotion = (PieceType)((packed >> 12) & 7);
+    return mv;
+}
+
+uint32_t GameTree::Play(const Move& played)
+{
+    // 같은 수가 같은 노드가 되도록 승급 표기를 정규화 (승급 칸에 간 폰 = 지정 없으면 퀸, 그 밖은 없음)
+    Move move = played;
+    bool promoting = m_board.GetPiece(move.sx, move.sy).type == PieceType::Pawn && (move.dy == 0 || move.dy == 7);
+    if (!promoting) move.promotion = PieceType::None;
+    else if (move.promotion == PieceType::None) move.promotion = PieceType::Queen;
+
+    uint32_t parent = Current();
+    uint16_t packed = Pack(move);
+
+    // 이미 있는 수면 그 가지로 이동만
+    uint32_t last = k_none;
+    for (uint32_t c = At(parent).firstChild; c != k_none; c = At(c).nextSibling) {
+        if (At(c).move == packed) {
+            Descend(c);
+            return c;
+        }
+        last = c;
+    }
+
+    m_board.PushState(m_isWhiteTurn);
+    if (!m_logic.ApplyMove(m_board, move, m_isWhiteTurn)) {
+        m_board.PopState();
+        return k_none;
+    }
+    m_isWhiteTurn = !m_isWhiteTurn;
+
+    uint32_t node = Allocate();
+    GameTreeNode& n = At(node);
+    n.key = Zobrist::Key(m_board, m_isWhiteTurn);
+    n.parent = parent;
+    n.move = packed;
+    if (last == k_none) At(parent).firstChild = node;
+    else At(last).nextSibling = node;
+
+    m_path.push_back(node);
+    Select(node);
+    return node;
+}
+
+void GameTree::PathTo(uint32_t node, std::vector<uint32_t>& outPath) const
+{
+    outPath.clear();
+    for (uint32_t n = node; n != k_root && n != k_none; n = At(n).parent)
+        outPath.push_back(n);
+    std::reverse(outPath.begin(), outPath.end());
+}
+
+bool GameTree::IsAttached(uint32_t node) const
+{
+    if (node >= m_count) return false;
+    for (uint32_t n = node; n != k_none; n = At(n).parent)
+        if (At(n).flags & Detached) return false;
+    return true;
+}
+
+bool GameTree::GoTo(uint32_t node)
+{
+    if (!IsAttached(node)) return false;
+    PathTo(node, m_scratch);
+
+    // m_path[0]은 루트이므로 m_path[i + 1]과 m_scratch[i]를 비교
+    size_t common = 0;
+    while (common + 1 < m_path.size() && common < m_scratch.size() && m_path[common + 1] == m_scratch[common])
+        ++common;
+
+    while (m_path.size() > common + 1) {
+        m_board.PopState();
+        m_path.pop_back();
+        m_isWhiteTurn = !m_isWhiteTurn;
+    }
+    for (size_t i = common; i < m_scratch.size(); ++i)
+        Descend(m_scratch[i]);
+    return true;
+}
+
+bool GameTree::Back()
+{
+    if (m_path.size() <= 1) return false;
+    m_board.PopState();
+    m_path.pop_back();
+    m_isWhiteTurn = !m_isWhiteTurn;
+    return true;
+}
+
+bool GameTree::Forward()
+{
+    uint32_t first = At(Current()).firstChild;
+    if (first == k_none) return false;
+    uint32_t child = first;
+    while (child != k_none && !(At(child).flags & Selected)) child = At(child).nextSibling;
+    Descend(child != k_none ? child : first);
+    return true;
+}
+
+bool GameTree::PromoteVariation(uint32_t node)
+{
+    if (node == k_root || !IsAttached(node)) return false;
+    GameTreeNode& parent = At(At(node).parent);
+    if (parent.firstChild == node) return true;
+
+    uint32_t prev = parent.firstChild;
+    while (At(prev).nextSibling != node) prev = At(prev).nextSibling;
+    At(prev).nextSibling = At(node).nextSibling;
+    At(node).nextSibling = parent.firstChild;
+    parent.firstChild = node;
+    return true;
+}
+
+bool GameTree::DeleteVariation(uint32_t node)
+{
+    if (node == k_root || !IsAttached(node)) return false;
+    uint32_t parentIndex = At(node).parent;
+
+    // 현재 위치가 지울 가지 안이면 먼저 부모로
+    if (std::find(m_path.begin(), m_path.end(), node) != m_path.end())
+        GoTo(parentIndex);
+
+    GameTreeNode& parent = At(parentIndex);
+    if (parent.firstChild == node) {
+        parent.firstChild = At(node).nextSibling;
+    }
+    else {
+        uint32_t prev = parent.firstChild;
+        while (At(prev).nextSibling != node) prev = At(prev).nextSibling;
+        At(prev).nextSibling = At(node).nextSibling;
+    }
+    At(node).nextSibling = k_none;
+    At(node).flags |= Detached;
+
+    // 떼어 낸 가지는 다시 붙지 않으므로 그 안의 주석을 표에서 지움
+    if (!m_comments.empty()) {
+        m_scratch.assign(1, node);
+        while (!m_scratch.empty()) {
+            uint32_t n = m_scratch.back();
+            m_scratch.pop_back();
+            if (At(n).flags & HasComment) {
+                m_comments.erase(n);
+                At(n).flags &= (uint8_t)~HasComment;
+            }
+            for (uint32_t c = At(n).firstChild; c != k_none; c = At(c).nextSibling)
+                m_scratch.push_back(c);
+        }
+    }
+    return true;
+}
+
+void GameTree::SetNag(uint32_t node, uint8_t nag)
+{
+    if (node >= m_count) return;
+    At(node).nag = nag;
+}
+
+void GameTree::SetComment(uint32_t node, const std::string& text)
+{
+    if (node >= m_count) return;
+    if (text.empty()) {
+        m_comments.erase(node);
+        At(node).flags &= (uint8_t)~HasComment;
+        return;
+    }
+    m_comments[node] = text;
+    At(node).flags |= HasComment;
+}
+
+const std::string* GameTree::Comment(uint32_t node) const
+{
+    if (node >= m_count || !(At(node).flags & HasComment)) return nullptr;
+    auto it = m_comments.find(node);
+    return it != m_comments.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,103 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Board.h"
+#include "GameLogic.h"
+
+// [추가] 변화수를 담는 기보 트리 (Board의 일렬 히스토리 대신: 무르기가 뒤 수를 지우지 않음)
+// - 노드는 24바이트 고정 크기로 블록(1024개) 단위 아레나에서 차례로 할당. 노드마다 new 하지 않음
+//   링크는 포인터 대신 32비트 노드 번호 -> 블록이 늘어도 번호는 그대로, 노드가 작음
+// - 첫 자식 = 본선, 그 형제들 = 변화수. 루트(0번)는 시작 국면이라 수가 없음
+// - 형제 중 마지막으로 지나간 자식에 Selected 표시 -> Forward(다시 두기)는 그 가지를 따라감
+// - 루트 -> 현재 노드 경로를 Board 히스토리(PushState)와 나란히 유지
+//   다른 노드로 갈 때 공통 조상까지만 PopState로 되돌리고 나머지 수만 둠 (처음부터 다시 두지 않음)
+struct GameTreeNode
+{
+    uint64_t key;           // 수를 둔 뒤 국면의 Zobrist 키
+    uint32_t parent;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint16_t move;          // 출발 칸 | 도착 칸 << 6 | 승급 PieceType << 12 (칸 = y * 8 + x)
+    uint8_t nag;            // 수 평가 기호 (PGN $1 = !, $2 = ? ...). 0 = 없음
+    uint8_t flags;
+};
+static_assert(sizeof(GameTreeNode) == 24, "GameTreeNode layout");
+
+class GameTree
+{
+public:
+    static const uint32_t k_none = 0xFFFFFFFFu;
+    static const uint32_t k_root = 0;
+
+    GameTree();
+
+    // 트리를 비우고 시작 국면부터 (fen이 비어 있으면 표준 초기 국면). FEN이 잘못됐으면 false
+    // 아레나 블록은 해제하지 않고 재사용
+    bool Reset(const std::string& fen = std::string());
+
+    const Board& CurrentBoard() const { return m_board; }
+    bool IsWhiteTurn() const { return m_isWhiteTurn; }
+    uint32_t Current() const { return m_path.back(); }
+    int CurrentPly() const { return (int)m_path.size() - 1; } // 루트로부터 수 개수
+    const std::string& StartFen() const { return m_startFen; }
+
+    // 현재 노드에서 수를 둠. 같은 수가 이미 자식에 있으면 그 노드로 이동만 함
+    // 새 수는 마지막 형제로 붙음 (자식이 없었으면 본선). 불법수면 k_none (현재 위치 유지)
+    uint32_t Play(const Move& move);
+    // 임의 노드로 이동 (공통 조상까지 되돌린 뒤 필요한 수만 둠). 삭제된 노드면 false
+    bool GoTo(uint32_t node);
+    bool Back();
+    bool Forward();         // 마지막으로 지나간 자식으로 한 수 (없으면 본선)
+    void GoToRoot() { GoTo(k_root); }
+
+    size_t NodeCount() const { return m_count; }
+    const GameTreeNode& Node(uint32_t node) const { return At(node); }
+    Move MoveOf(uint32_t node) const { return Unpack(At(node).move); }
+    // 루트 다음 노드부터 node까지 (루트 자신은 빈 경로)
+    void PathTo(uint32_t node, std::vector<uint32_t>& outPath) const;
+    bool IsAttached(uint32_t node) const;
+
+    // 형제 중 맨 앞으로 옮겨 본선으로 만듦
+    bool PromoteVariation(uint32_t node);
+    // node와 그 아래를 트리에서 떼어 냄 (현재 위치가 그 안이면 부모로 이동). 아레나 공간은 Reset 때 회수
+    bool DeleteVariation(uint32_t node);
+
+    // 없는 노드 번호는 무시 (Comment는 nullptr)
+    void SetNag(uint32_t node, uint8_t nag);
+    // 주석은 드물어서 노드 밖 표에 둠 (빈 문자열이면 삭제). 떼어 낸 가지의 주석은 DeleteVariation이 지움
+    void SetComment(uint32_t node, const std::string& text);
+    const std::string* Comment(uint32_t node) const;
+
+private:
+    enum Flags : uint8_t
+    {
+        HasComment = 1 << 0,
+        Detached = 1 << 1,   // DeleteVariation으로 떼어 낸 가지의 맨 위 노드
+        Selected = 1 << 2    // 형제 중 마지막으로 지나간 노드 (Forward가 따라감)
+    };
+    static const int k_blockShift = 10;
+    static const uint32_t k_blockMask = (1u << k_blockShift) - 1;
+
+    uint32_t Allocate();
+    void Select(uint32_t node);
+    void Descend(uint32_t node);
+    GameTreeNode& At(uint32_t node) { return m_blocks[node >> k_blockShift][node & k_blockMask]; }
+    const GameTreeNode& At(uint32_t node) const { return m_blocks[node >> k_blockShift][node & k_blockMask]; }
+    static uint16_t Pack(const Move& move);
+    static Move Unpack(uint16_t packed);
+
+    std::vector<std::unique_ptr<GameTreeNode[]>> m_blocks;
+    uint32_t m_count = 0;
+    std::unordered_map<uint32_t, std::string> m_comments;
+
+    std::string m_startFen;      // 표준 초기 국면이면 빈 문자열
+    bool m_startWhite = true;
+    Board m_board;               // 현재 노드 국면. 히스토리 깊이 = m_path.size() - 1
+    bool m_isWhiteTurn = true;
+    std::vector<uint32_t> m_path; // 루트 .. 현재 노드
+    std::vector<uint32_t> m_scratch;
+    GameLogic m_logic;
+};
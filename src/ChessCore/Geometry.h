@@ -0,0 +1,217 @@
+﻿#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// [추가] 컴파일 타임에 만드는 보드 기하 테이블 (칸 인덱스 = y * 8 + x, y 0 = 8랭크)
+// - 나이트/킹/폰 공격 칸, 방향별 광선, 두 칸 사이(between), 두 칸을 지나는 직선(line), 거리
+// - 전부 constexpr이라 시작 비용 0, 조회 시 경계 검사 없음
+// - 테이블 생성에 상수 평가 단계가 많이 들어 MSVC는 /constexpr:steps 를 늘려 둠 (vcxproj)
+namespace Geometry
+{
+    // 0..3은 칸 인덱스가 커지는 방향, 4..7은 작아지는 방향 (가장 가까운 막힌 칸 = LSB / MSB)
+    enum Direction { East, South, SouthEast, SouthWest, West, North, NorthWest, NorthEast, DirectionCount };
+
+    constexpr int k_dirX[DirectionCount] = { 1, 0, 1, -1, -1, 0, -1, 1 };
+    constexpr int k_dirY[DirectionCount] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    constexpr unsigned k_rookDirs = (1u << East) | (1u << South) | (1u << West) | (1u << North);
+    constexpr unsigned k_bishopDirs = (1u << SouthEast) | (1u << SouthWest) | (1u << NorthWest) | (1u << NorthEast);
+    constexpr unsigned k_queenDirs = k_rookDirs | k_bishopDirs;
+
+    constexpr int Opposite(int dir) { return dir ^ 4; }
+    constexpr int Square(int x, int y) { return y * 8 + x; }
+    constexpr uint64_t SquareBit(int sq) { return 1ull << sq; }
+
+    namespace Detail
+    {
+        struct SquareTable { uint64_t v[64]; };
+        struct ColorTable { uint64_t v[2][64]; };
+        struct RayTable { uint64_t v[DirectionCount][64]; };
+        struct PairTable { uint64_t v[64][64]; };
+        struct DistanceTable { uint8_t v[64][64]; };
+
+        constexpr bool OnBoard(int x, int y) { return x >= 0 && x < 8 && y >= 0 && y < 8; }
+        constexpr uint64_t BitIf(int x, int y) { return OnBoard(x, y) ? SquareBit(Square(x, y)) : 0; }
+        constexpr int Abs(int v) { return v < 0 ? -v : v; }
+        constexpr int Max(int a, int b) { return a > b ? a : b; }
+
+        constexpr SquareTable MakeKnight()
+        {
+            const int ox[8] = { 1, 2, 2, 1, -1, -2, -2, -1 };
+            const int oy[8] = { 2, 1, -1, -2, -2, -1, 1, 2 };
+            SquareTable t{};
+            for (int sq = 0; sq < 64; ++sq)
+                for (int i = 0; i < 8; ++i) t.v[sq] |= BitIf(sq % 8 + ox[i], sq / 8 + oy[i]);
+            return t;
+        }
+
+        constexpr SquareTable MakeKing()
+        {
+            SquareTable t{};
+            for (int sq = 0; sq < 64; ++sq)
+                for (int d = 0; d < DirectionCount; ++d) t.v[sq] |= BitIf(sq % 8 + k_dirX[d], sq / 8 + k_dirY[d]);
+            return t;
+        }
+
+        // 색 인덱스 0 = 백 (y 감소 방향으로 전진), 1 = 흑
+        constexpr ColorTable MakePawn()
+        {
+            ColorTable t{};
+            for (int sq = 0; sq < 64; ++sq) {
+                int x = sq % 8, y = sq / 8;
+                t.v[0][sq] = BitIf(x - 1, y - 1) | BitIf(x + 1, y - 1);
+                t.v[1][sq] = BitIf(x - 1, y + 1) | BitIf(x + 1, y + 1);
+            }
+            return t;
+        }
+
+        constexpr RayTable MakeRays()
+        {
+            RayTable t{};
+            for (int d = 0; d < DirectionCount; ++d)
+                for (int sq = 0; sq < 64; ++sq) {
+                    int x = sq % 8 + k_dirX[d], y = sq / 8 + k_dirY[d];
+                    for (; OnBoard(x, y); x += k_dirX[d], y += k_dirY[d]) t.v[d][sq] |= SquareBit(Square(x, y));
+                }
+            return t;
+        }
+
+        // a에서 b로 가는 방향 (같은 줄/대각선이 아니면 -1)
+        constexpr int DirectionOf(int a, int b)
+        {
+            int dx = b % 8 - a % 8, dy = b / 8 - a / 8;
+            if (a == b || (dx != 0 && dy != 0 && Abs(dx) != Abs(dy))) return -1;
+            int sx = (dx > 0) - (dx < 0), sy = (dy > 0) - (dy < 0);
+            for (int d = 0; d < DirectionCount; ++d)
+                if (k_dirX[d] == sx && k_dirY[d] == sy) return d;
+            return -1;
+        }
+    }
+
+    constexpr Detail::SquareTable k_knight = Detail::MakeKnight();
+    constexpr Detail::SquareTable k_king = Detail::MakeKing();
+    constexpr Detail::ColorTable k_pawn = Detail::MakePawn();
+    constexpr Detail::RayTable k_rays = Detail::MakeRays();
+
+    namespace Detail
+    {
+        // 광선 테이블에서 바로 만듦 (쌍마다 칸을 따라 걷지 않아 상수 평가 단계가 적음)
+        constexpr PairTable MakeBetween()
+        {
+            PairTable t{};
+            for (int a = 0; a < 64; ++a)
+                for (int b = 0; b < 64; ++b) {
+                    int d = DirectionOf(a, b);
+                    if (d >= 0) t.v[a][b] = k_rays.v[d][a] & k_rays.v[Opposite(d)][b];
+                }
+            return t;
+        }
+
+        constexpr PairTable MakeLine()
+        {
+            PairTable t{};
+            for (int a = 0; a < 64; ++a)
+                for (int b = 0; b < 64; ++b) {
+                    int d = DirectionOf(a, b);
+                    if (d >= 0) t.v[a][b] = k_rays.v[d][a] | k_rays.v[Opposite(d)][a] | SquareBit(a);
+                }
+            return t;
+        }
+
+        constexpr DistanceTable MakeDistance()
+        {
+            DistanceTable t{};
+            for (int a = 0; a < 64; ++a)
+                for (int b = 0; b < 64; ++b)
+                    t.v[a][b] = (uint8_t)Max(Abs(a % 8 - b % 8), Abs(a / 8 - b / 8));
+            return t;
+        }
+    }
+
+    constexpr Detail::PairTable k_between = Detail::MakeBetween();
+    constexpr Detail::PairTable k_line = Detail::MakeLine();
+    constexpr Detail::DistanceTable k_distance = Detail::MakeDistance();
+
+    constexpr uint64_t KnightAttacks(int sq) { return k_knight.v[sq]; }
+    constexpr uint64_t KingAttacks(int sq) { return k_king.v[sq]; }
+    constexpr uint64_t PawnAttacks(bool white, int sq) { return k_pawn.v[white ? 0 : 1][sq]; }
+    constexpr uint64_t Ray(int dir, int sq) { return k_rays.v[dir][sq]; }
+    // a와 b 사이의 칸 (양 끝 제외). 같은 줄/대각선이 아니면 0
+    constexpr uint64_t Between(int a, int b) { return k_between.v[a][b]; }
+    // a와 b를 지나는 직선 전체 (양 끝 포함). 같은 줄/대각선이 아니면 0
+    constexpr uint64_t Line(int a, int b) { return k_line.v[a][b]; }
+    // 킹 걸음 수 (체비셰프 거리)
+    constexpr int Distance(int a, int b) { return k_distance.v[a][b]; }
+
+    // --- 컴파일 타임 검증 (a8 = 0, h8 = 7, a1 = 56, h1 = 63) ---
+    static_assert(KnightAttacks(0) == (SquareBit(10) | SquareBit(17)), "knight a8 -> c7, b6");
+    static_assert(KnightAttacks(Square(3, 4)) == 0x14220022140000ull, "knight d4: 8 squares");
+    static_assert(KingAttacks(63) == (SquareBit(54) | SquareBit(55) | SquareBit(62)), "king h1");
+    static_assert(PawnAttacks(true, Square(4, 6)) == (SquareBit(Square(3, 5)) | SquareBit(Square(5, 5))), "white pawn e2 -> d3, f3");
+    static_assert(PawnAttacks(false, Square(0, 1)) == SquareBit(Square(1, 2)), "black pawn a7 -> b6");
+    static_assert(Ray(East, 0) == 0xFEull, "ray a8 east");
+    static_assert(Ray(South, 0) == 0x0101010101010100ull, "ray a8 south (a-file)");
+    static_assert(Ray(NorthEast, 56) == 0x0002040810204080ull, "ray a1 north-east (long diagonal)");
+    static_assert(Between(0, 63) == 0x0040201008040200ull, "between a8 h1");
+    static_assert(Between(0, 7) == 0x7Eull, "between a8 h8");
+    static_assert(Between(0, 1) == 0 && Between(0, 10) == 0, "adjacent / knight pair");
+    static_assert(Line(Square(1, 1), Square(3, 3)) == 0x8040201008040201ull, "line b7 d5 = a8-h1 diagonal");
+    static_assert(Line(0, 10) == 0, "no line through a knight pair");
+    static_assert(Distance(0, 63) == 7 && Distance(0, 10) == 2 && Distance(27, 27) == 0, "distance");
+
+    // 최하위 / 최상위 1비트 인덱스 (m != 0). Win32(x86) MSVC에는 64비트 스캔 내장 함수가 없어 32비트 두 번
+    inline int Lsb(uint64_t m)
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long i;
+        _BitScanForward64(&i, m);
+        return (int)i;
+#elif defined(_MSC_VER)
+        unsigned long i;
+        if (_BitScanForward(&i, (unsigned long)m)) return (int)i;
+        _BitScanForward(&i, (unsigned long)(m >> 32));
+        return (int)i + 32;
+#else
+        return __builtin_ctzll(m);
+#endif
+    }
+
+    inline int Msb(uint64_t m)
+    {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long i;
+        _BitScanReverse64(&i, m);
+        return (int)i;
+#elif defined(_MSC_VER)
+        unsigned long i;
+        if (_BitScanReverse(&i, (unsigned long)(m >> 32))) return (int)i + 32;
+        _BitScanReverse(&i, (unsigned long)m);
+        return (int)i;
+#else
+        return 63 - __builtin_clzll(m);
+#endif
+    }
+
+    // 최하위 1비트의 인덱스를 반환하고 그 비트를 지움 (m != 0)
+    inline int PopLsb(uint64_t& m)
+    {
+        int i = Lsb(m);
+        m &= m - 1;
+        return i;
+    }
+
+    // dirs 비트의 방향들로 뻗는 슬라이더 공격 칸 (처음 막힌 칸 포함)
+    inline uint64_t SliderAttacks(int sq, unsigned dirs, uint64_t occupied)
+    {
+        uint64_t result = 0;
+        for (int d = 0; d < DirectionCount; ++d) {
+            if (!(dirs & (1u << d))) continue;
+            uint64_t ray = k_rays.v[d][sq];
+            uint64_t blockers = ray & occupied;
+            if (blockers) ray ^= k_rays.v[d][(d < West) ? Lsb(blockers) : Msb(blockers)];
+            result |= ray;
+        }
+        return result;
+    }
+}
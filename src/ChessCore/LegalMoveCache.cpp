@@ -0,0 +1,77 @@
+﻿#include "LegalMoveCache.h"
+#include "Fen.h"
+#include "../Utils/Trace.h"
+
+bool LegalMoveSet::IsPromotion(int sx, int sy, int dx, int dy) const
+{
+    if (!IsLegal(sx, sy, dx, dy)) return false;
+    int sq = sy * 8 + sx;
+    for (int i = begin[sq]; i < begin[sq + 1]; ++i) {
+        const Move& m = moves[i];
+        if (m.dx == dx && m.dy == dy) return m.promotion != PieceType::None;
+    }
+    return false;
+}
+
+bool LegalMoveSet::Find(int sx, int sy, int dx, int dy, PieceType promotion, Move& outMove) const
+{
+    if (!IsLegal(sx, sy, dx, dy)) return false;
+    int sq = sy * 8 + sx;
+    for (int i = begin[sq]; i < begin[sq + 1]; ++i) {
+        const Move& m = moves[i];
+        if (m.dx != dx || m.dy != dy) continue;
+        if (m.promotion != PieceType::None && m.promotion != promotion) continue;
+        outMove = m;
+        return true;
+    }
+    return false;
+}
+
+std::shared_ptr<const LegalMoveSet> LegalMoveCache::Build(const Board& board, bool isWhiteTurn, std::string key)
+{
+    TRACE_SCOPE("LegalMoveCache::Build", "core");
+    auto set = std::make_shared<LegalMoveSet>();
+    set->key = std::move(key);
+
+    GameLogic logic;
+    std::vector<Move> all;
+    logic.GenerateLegalMoves(board, isWhiteTurn, all);
+
+    // 출발 칸별 개수 -> 누적 -> 배치 (합법수는 최대 218개이므로 인덱스는 uint8_t로 충분)
+    int count[64] = {};
+    for (const auto& m : all) {
+        int sq = m.sy * 8 + m.sx;
+        ++count[sq];
+        set->targets[sq] |= 1ull << (m.dy * 8 + m.dx);
+    }
+    int pos = 0;
+    for (int sq = 0; sq < 64; ++sq) {
+        set->begin[sq] = (uint8_t)pos;
+        pos += count[sq];
+    }
+    set->begin[64] = (uint8_t)pos;
+
+    set->moves.resize(all.size());
+    int fill[64];
+    for (int sq = 0; sq < 64; ++sq) fill[sq] = set->begin[sq];
+    for (const auto& m : all) set->moves[fill[m.sy * 8 + m.sx]++] = m;
+    return set;
+}
+
+void LegalMoveCache::Prepare(const Board& board, bool isWhiteTurn)
+{
+    Get(board, isWhiteTurn);
+}
+
+void LegalMoveCache::Invalidate()
+{
+    m_current.reset();
+}
+
+const LegalMoveSet& LegalMoveCache::Get(const Board& board, bool isWhiteTurn)
+{
+    std::string key = Fen::BoardToFEN(board, isWhiteTurn);
+    if (!m_current || m_current->key != key)
+        m_current = Build(board, isWhiteTurn, key);
+    return *m_current;
+}
@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameLogic.h"
+
+// 한 국면의 합법수 전체를 출발 칸별로 정리한 표
+// 칸 인덱스 = y * 8 + x
+struct LegalMoveSet
+{
+    std::string key;          // 국면 키 (FEN)
+    std::vector<Move> moves;  // 출발 칸 순으로 정렬 (승급은 Q/R/B/N 네 수)
+    uint8_t begin[65] = {};   // moves[begin[sq] .. begin[sq + 1]) = sq에서 출발하는 수
+    uint64_t targets[64] = {}; // 출발 칸별 도착 칸 비트
+
+    bool HasMovesFrom(int x, int y) const { return targets[y * 8 + x] != 0; }
+    bool IsLegal(int sx, int sy, int dx, int dy) const { return (targets[sy * 8 + sx] >> (dy * 8 + dx)) & 1; }
+    // 승급 수면 true (어느 기물로 승급할지는 따로 고름)
+    bool IsPromotion(int sx, int sy, int dx, int dy) const;
+    // 합법이면 outMove를 채우고 true. 승급 수는 promotion 기물이 일치하는 수를 찾음
+    bool Find(int sx, int sy, int dx, int dy, PieceType promotion, Move& outMove) const;
+    bool Empty() const { return moves.empty(); }
+};
+
+// [추가] GUI용 국면별 합법수 캐시
+// - 수를 둔 직후 Prepare()로 미리 계산
+// - 무르기 등으로 국면이 되돌아가면 Invalidate()
+// - Get()은 키가 같으면 바로 반환, 다른 국면이면 그 자리에서 계산
+// [변경] 백그라운드(std::async) 계산 제거: Build가 약 10µs로 스레드 시작 + get()(약 30µs)보다 싸고,
+//        무르기 때 지난 국면의 계산을 UI 스레드가 기다리던 문제도 없어짐
+class LegalMoveCache
+{
+public:
+    LegalMoveCache() = default;
+    LegalMoveCache(const LegalMoveCache&) = delete;
+    LegalMoveCache& operator=(const LegalMoveCache&) = delete;
+
+    void Prepare(const Board& board, bool isWhiteTurn);
+    void Invalidate();
+    const LegalMoveSet& Get(const Board& board, bool isWhiteTurn);
+
+    static std::shared_ptr<const LegalMoveSet> Build(const Board& board, bool isWhiteTurn, std::string key);
+
+private:
+    std::shared_ptr<const LegalMoveSet> m_current;
+};
@@ -0,0 +1,86 @@
+﻿#include "MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+namespace
+{
+    std::wstring Widen(const std::string& utf8)
+    {
+        int len = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, nullptr, 0);
+        std::wstring w(len > 0 ? len - 1 : 0, L'\0');
+        if (len > 1) MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, &w[0], len);
+        return w;
+    }
+}
+#endif
+
+std::FILE* MappedFile::OpenForWrite(const std::string& path)
+{
+#ifdef _WIN32
+    return _wfopen(Widen(path).c_str(), L"wb");
+#else
+    return std::fopen(path.c_str(), "wb");
+#endif
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileW(Widen(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || (uint64_t)size.QuadPart > (size_t)-1) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mapHandle = mapping;
+    m_data = (const uint8_t*)view;
+    m_size = (size_t)size.QuadPart;
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // 매핑은 fd를 닫아도 유지됨
+    if (view == MAP_FAILED) return false;
+    m_data = (const uint8_t*)view;
+    m_size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!m_data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle((HANDLE)m_mapHandle);
+    CloseHandle((HANDLE)m_fileHandle);
+    m_mapHandle = m_fileHandle = nullptr;
+#else
+    munmap((void*)m_data, m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
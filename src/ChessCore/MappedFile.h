@@ -0,0 +1,34 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// [추가] 읽기 전용 파일 매핑 (Windows: CreateFileMapping, POSIX: mmap)
+// 국면 / 기보 저장 파일(PositionFile, GameArchive)이 파일 전체를 복사 없이 임의 접근할 때 사용
+// 32비트 프로세스에서는 주소 공간보다 큰 파일은 열 수 없음
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { Close(); }
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+    // UTF-8 경로로 쓰기용 FILE* 열기 (Windows는 _wfopen)
+    static std::FILE* OpenForWrite(const std::string& path);
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mapHandle = nullptr;
+#endif
+};
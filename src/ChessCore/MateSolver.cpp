@@ -0,0 +1,311 @@
+﻿#include "MateSolver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
+#include "Fen.h"
+#include "MovePicker.h"
+#include "Zobrist.h"
+#include "../Utils/Trace.h"
+
+namespace
+{
+    const uint32_t k_inf = 0x3FFFFFFF;
+    const size_t k_maxChildren = 256; // 한 국면 합법수 최대 218
+
+    inline void Prefetch(const void* p)
+    {
+#if defined(_MSC_VER)
+        _mm_prefetch((const char*)p, _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#else
+        (void)p;
+#endif
+    }
+
+    uint32_t SatAdd(uint32_t a, uint32_t b)
+    {
+        uint64_t s = (uint64_t)a + b;
+        return (s >= k_inf) ? k_inf : (uint32_t)s;
+    }
+
+    // 1+ε 기법: 두 번째로 좋은 자식 값보다 조금 넉넉하게 임계값을 줘서
+    // 형제 사이를 자주 오가며 같은 노드를 다시 전개하는 일을 줄임
+    uint32_t Widen(uint32_t second)
+    {
+        if (second >= k_inf) return k_inf;
+        return SatAdd(second, std::max<uint32_t>(1, second / 4));
+    }
+
+    // 임계값 - 현재값 + 자식값 (INF는 그대로 유지)
+    uint32_t Shift(uint32_t th, uint32_t total, uint32_t child)
+    {
+        if (th >= k_inf) return k_inf;
+        int64_t v = (int64_t)th - total + child;
+        if (v <= 0) return 1;
+        return (v >= k_inf) ? k_inf : (uint32_t)v;
+    }
+}
+
+MateSolver::MateSolver(const MateSolverOptions& options)
+    : m_options(options)
+{
+    size_t size = 1;
+    while (size < m_options.ttEntries) size <<= 1;
+    m_table.assign(size, Entry{ 0, 0, 0, 0 });
+    m_mask = size - 1;
+}
+
+void MateSolver::ClearTable()
+{
+    std::fill(m_table.begin(), m_table.end(), Entry{ 0, 0, 0, 0 });
+    m_generation = 0;
+}
+
+uint64_t MateSolver::NodeKey(uint64_t position, bool orNode, int movesLeft)
+{
+    // 같은 국면이라도 남은 수 / 노드 종류가 다르면 다른 항목
+    uint64_t salt = (uint64_t)(movesLeft * 2 + (orNode ? 1 : 0) + 1) * 0xD6E8FEB86659FD93ull;
+    return position ^ salt;
+}
+
+bool MateSolver::Lookup(uint64_t key, uint32_t& pn, uint32_t& dn) const
+{
+    const Entry& e = m_table[key & m_mask];
+    if (e.key != key) return false;
+    pn = e.pn; dn = e.dn;
+    return true;
+}
+
+void MateSolver::Store(uint64_t key, uint32_t pn, uint32_t dn)
+{
+    Entry& e = m_table[key & m_mask];
+    // 지금 푸는 루트에서 얻은 풀린 항목(pn 또는 dn = 0)은 풀리지 않은 항목으로 덮어쓰지 않음
+    // [변경] 이전 Solve 호출의 항목은 언제든 교체 (배치에서 지난 퍼즐의 증명이 표를 차지하지 않도록)
+    if (e.key != key && e.generation == m_generation && (e.pn == 0 || e.dn == 0) && pn != 0 && dn != 0) return;
+    e.key = key; e.pn = pn; e.dn = dn; e.generation = m_generation;
+}
+
+// 자식을 만들 필요 없이 결론이 나는 노드면 true. 아니면 children에 합법수와 수를 둔 국면을 채워 false
+bool MateSolver::Terminal(const Board& board, uint64_t position, bool toMove, bool orNode, int movesLeft, std::vector<Child>& children, uint32_t& pn, uint32_t& dn)
+{
+    if (!orNode && movesLeft == 0) {
+        // 공격 측 수를 다 썼음: 지금 체크메이트여야 증명 (체크가 아니면 생성 없이 반증)
+        bool mate = m_logic.IsKingInCheck(board, toMove) && m_logic.CheckGameState(board, toMove) == GameState::Checkmate;
+        pn = mate ? 0 : k_inf; dn = mate ? k_inf : 0;
+        return true;
+    }
+
+    GenerateChildren(board, position, toMove, !orNode, orNode ? movesLeft - 1 : movesLeft, children);
+    if (children.empty()) {
+        // 방어 측이 체크메이트면 증명. 스테일메이트 또는 공격 측이 막힌 경우는 반증
+        bool mate = !orNode && m_logic.IsKingInCheck(board, toMove);
+        pn = mate ? 0 : k_inf; dn = mate ? k_inf : 0;
+        return true;
+    }
+    return false;
+}
+
+// [변경] 자식은 수와 치환표에서 읽은 pn/dn만 (보드 복사 / 수를 둬 보기 없음). 키는 증분 계산
+void MateSolver::GenerateChildren(const Board& board, uint64_t position, bool toMove, bool childOr, int childMoves, std::vector<Child>& children)
+{
+    children.clear();
+    // [추가] 공격 측의 마지막 수는 체크가 아니면 메이트일 수 없음 -> 치환표를 보기 전에 거름
+    bool checksOnly = !childOr && childMoves == 0;
+    CheckInfo checkInfo;
+    if (checksOnly) m_logic.ComputeCheckInfo(board, toMove, checkInfo);
+
+    // 치환표 조회는 자식마다 캐시 미스 -> 키를 먼저 모두 계산해 슬롯을 프리페치한 뒤 읽음
+    uint64_t keys[k_maxChildren];
+    MovePicker picker(board, toMove);
+    Move move;
+    while (picker.Next(move) && children.size() < k_maxChildren) {
+        if (checksOnly && !m_logic.GivesCheck(board, move, checkInfo)) continue;
+        uint64_t key = NodeKey(Zobrist::KeyAfterMove(board, toMove, position, move), childOr, childMoves);
+        Prefetch(&m_table[key & m_mask]);
+        keys[children.size()] = key;
+        children.push_back(Child{ move, 1, 1 });
+    }
+    for (size_t i = 0; i < children.size(); ++i)
+        Lookup(keys[i], children[i].pn, children[i].dn);
+}
+
+void MateSolver::Mid(Board& board, uint64_t position, bool toMove, bool orNode, int movesLeft, uint32_t thpn, uint32_t thdn, uint32_t& outPn, uint32_t& outDn)
+{
+    if (++m_nodes > m_options.maxNodes) m_aborted = true;
+    uint64_t key = NodeKey(position, orNode, movesLeft);
+
+    // 자식 수와 값은 한 번만 만들어 두고, 내려갔다 온 자식의 값만 갱신
+    std::vector<Child> children;
+    if (m_aborted || Terminal(board, position, toMove, orNode, movesLeft, children, outPn, outDn)) {
+        if (m_aborted) { outPn = 1; outDn = 1; return; }
+        Store(key, outPn, outDn);
+        return;
+    }
+    bool childOr = !orNode;
+    int childMoves = orNode ? movesLeft - 1 : movesLeft;
+
+    uint32_t pn = 1, dn = 1;
+    for (;;) {
+        // OR: pn = min, dn = 합 / AND: pn = 합, dn = min
+        uint32_t minVal = k_inf, secondVal = k_inf, sumVal = 0;
+        uint32_t bestPn = 1, bestDn = 1;
+        size_t best = 0;
+        for (size_t i = 0; i < children.size(); ++i) {
+            uint32_t cpn = children[i].pn, cdn = children[i].dn;
+            uint32_t sel = orNode ? cpn : cdn;
+            uint32_t other = orNode ? cdn : cpn;
+            sumVal = SatAdd(sumVal, other);
+            if (sel < minVal) { secondVal = minVal; minVal = sel; best = i; bestPn = cpn; bestDn = cdn; }
+            else if (sel < secondVal) secondVal = sel;
+        }
+        pn = orNode ? minVal : sumVal;
+        dn = orNode ? sumVal : minVal;
+        if (pn >= thpn || dn >= thdn || pn == 0 || dn == 0 || m_aborted) break;
+
+        uint32_t cthpn, cthdn;
+        if (orNode) {
+            cthpn = std::min<uint32_t>(thpn, Widen(secondVal));
+            cthdn = Shift(thdn, dn, bestDn);
+        }
+        else {
+            cthdn = std::min<uint32_t>(thdn, Widen(secondVal));
+            cthpn = Shift(thpn, pn, bestPn);
+        }
+        Child& c = children[best];
+        uint64_t childPosition = Zobrist::KeyAfterMove(board, toMove, position, c.move);
+        board.PushState(toMove);
+        m_logic.ApplyMove(board, c.move, toMove);
+        Mid(board, childPosition, !toMove, childOr, childMoves, cthpn, cthdn, c.pn, c.dn);
+        board.PopState();
+    }
+
+    if (!m_aborted) Store(key, pn, dn);
+    outPn = pn; outDn = dn;
+}
+
+int MateSolver::Prove(Board& board, bool toMove, bool orNode, int movesLeft)
+{
+    uint32_t pn, dn;
+    uint64_t position = Zobrist::Key(board, toMove);
+    if (Lookup(NodeKey(position, orNode, movesLeft), pn, dn)) {
+        if (pn == 0) return 1;
+        if (dn == 0) return 0;
+    }
+    Mid(board, position, toMove, orNode, movesLeft, k_inf, k_inf, pn, dn);
+    if (m_aborted) return -1;
+    return (pn == 0) ? 1 : 0;
+}
+
+int MateSolver::MinMate(Board& board, bool toMove, bool orNode, int limit)
+{
+    for (int d = orNode ? 1 : 0; d <= limit; ++d) {
+        int r = Prove(board, toMove, orNode, d);
+        if (r < 0) return -1;
+        if (r == 1) return d;
+    }
+    return -1;
+}
+
+// 공격 측은 가장 빠른 메이트, 방어 측은 가장 오래 버티는 수를 골라 수순을 이어 붙임
+bool MateSolver::ExtractLine(const Board& board, bool toMove, bool orNode, int movesLeft, std::vector<Move>& line)
+{
+    std::vector<Move> moves;
+    m_logic.GenerateLegalMoves(board, toMove, moves);
+    if (moves.empty()) return !orNode; // 방어 측 체크메이트로 끝
+
+    const Move* chosen = nullptr;
+    Board chosenBoard;
+    int chosenDepth = orNode ? movesLeft : -1;
+    // 공격 측: 먼저 증명 트리(치환표에서 증명된 자식)만 후보로 봄. 나머지 수를 반증하는 탐색은 비쌈
+    // 항목이 교체되어 못 찾으면 두 번째 패스에서 전체 수를 확인
+    for (int pass = orNode ? 0 : 1; pass < 2 && !chosen; ++pass) {
+        for (const auto& mv : moves) {
+            Board next = board;
+            m_logic.ApplyMove(next, mv, toMove);
+            if (pass == 0) {
+                uint32_t pn = 1, dn = 1;
+                Lookup(NodeKey(Zobrist::Key(next, !toMove), false, movesLeft - 1), pn, dn);
+                if (pn != 0) continue;
+            }
+            int d = MinMate(next, !toMove, !orNode, orNode ? movesLeft - 1 : movesLeft);
+            if (m_aborted) return false;
+            if (d < 0) {
+                if (orNode) continue;
+                return false; // 방어 측이 빠져나감 (증명과 모순)
+            }
+            if (orNode ? (d < chosenDepth) : (d > chosenDepth)) {
+                chosen = &mv; chosenBoard = next; chosenDepth = d;
+                if (orNode && d == 0) break;
+            }
+        }
+    }
+    if (!chosen) return false;
+
+    line.push_back(*chosen);
+    if (orNode && chosenDepth == 0) return true; // 이 수로 체크메이트
+    chosenBoard.ClearHistory();
+    return ExtractLine(chosenBoard, !toMove, !orNode, chosenDepth, line);
+}
+
+MateSolution MateSolver::Solve(const Board& board, bool isWhiteTurn)
+{
+    TRACE_SCOPE("MateSolver::Solve", "core");
+    auto t0 = std::chrono::steady_clock::now();
+    MateSolution result;
+    m_nodes = 0;
+    m_aborted = false;
+    ++m_generation;
+
+    // 히스토리는 탐색에 필요 없으므로 떼어 냄 (탐색 중에는 수를 두고 되돌리는 데만 씀)
+    Board root = board;
+    root.ClearHistory();
+
+    result.status = MateStatus::NoMate;
+    for (int n = 1; n <= m_options.maxMoves; ++n) {
+        int r = Prove(root, isWhiteTurn, true, n);
+        if (r < 0) { result.status = MateStatus::Unknown; break; }
+        if (r == 1) {
+            result.status = MateStatus::Mate;
+            result.mateIn = n;
+            if (!ExtractLine(root, isWhiteTurn, true, n, result.line)) result.line.clear();
+            break;
+        }
+    }
+
+    result.nodes = m_nodes;
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
+
+std::vector<MateSolution> MateSolver::SolveBatch(const std::vector<std::string>& fens, const MateSolverOptions& options, int threads)
+{
+    std::vector<MateSolution> results(fens.size());
+    std::atomic<size_t> next{ 0 };
+
+    auto worker = [&]() {
+        MateSolver solver(options);
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= fens.size()) break;
+            Board board;
+            bool white = true;
+            if (!Fen::FENToBoard(fens[i], board, white)) continue; // Unknown 그대로
+            // 치환표는 비우지 않음 (키에 국면 전체가 들어가므로 이전 퍼즐 항목도 그대로 유효)
+            // 대신 Solve마다 세대가 바뀌어 이전 퍼즐의 항목은 우선 교체됨
+            results[i] = solver.Solve(board, white);
+        }
+    };
+
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > fens.size()) threads = (int)std::max<size_t>(fens.size(), 1);
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    return results;
+}
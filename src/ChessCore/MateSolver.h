@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameLogic.h"
+
+// [추가] 강제 메이트(mate-in-N) 전용 탐색기
+// - 깊이 제한 df-pn(depth-first proof-number search) + 치환표
+// - 공격 측(둘 차례) 수 N을 1부터 늘려 가며 증명 -> 처음 증명된 N이 최단 메이트
+// - 증명되면 수순 전체(방어 측은 가장 오래 버티는 수)를 함께 반환
+// - [변경] 보드 하나에 수를 두고(PushState) 되돌리며(PopState) 탐색. 자식은 수와 pn/dn만 들고,
+//   키는 Zobrist::KeyAfterMove로 증분 계산, 합법수는 MovePicker로 생성
+// - 한 인스턴스는 한 스레드 전용. 여러 국면은 SolveBatch가 스레드별 인스턴스로 나눠 풂
+
+struct MateSolverOptions
+{
+    int maxMoves = 5;                 // 찾을 최대 N (공격 측 수 기준)
+    uint64_t maxNodes = 20000000;     // 넘으면 Unknown으로 중단
+    size_t ttEntries = (size_t)1 << 20; // 치환표 항목 수 (2의 거듭제곱으로 올림, 항목당 24바이트)
+};
+
+enum class MateStatus
+{
+    Mate,    // mateIn 수 안에 강제 메이트
+    NoMate,  // maxMoves 안에는 강제 메이트 없음 (증명됨)
+    Unknown  // 노드 한도 초과 또는 잘못된 국면
+};
+
+struct MateSolution
+{
+    MateStatus status = MateStatus::Unknown;
+    int mateIn = 0;          // Mate일 때 공격 측 수
+    std::vector<Move> line;  // 메이트 수순 (2 * mateIn - 1 수)
+    uint64_t nodes = 0;
+    double ms = 0.0;
+};
+
+class MateSolver
+{
+public:
+    explicit MateSolver(const MateSolverOptions& options = MateSolverOptions());
+
+    MateSolution Solve(const Board& board, bool isWhiteTurn);
+    void ClearTable();
+
+    // FEN 목록을 threads개 스레드로 나눠 풂 (결과 순서 = 입력 순서, 잘못된 FEN은 Unknown)
+    static std::vector<MateSolution> SolveBatch(const std::vector<std::string>& fens, const MateSolverOptions& options, int threads);
+
+private:
+    struct Entry
+    {
+        uint64_t key;
+        uint32_t pn;
+        uint32_t dn;
+        uint32_t generation; // 항목을 쓴 Solve 호출 (이전 루트의 풀린 항목은 교체 대상)
+    };
+
+    struct Child
+    {
+        Move move;
+        // 마지막으로 알려진 증명수/반증수. 치환표 항목이 다른 국면에 밀려나도 부모가 진행 상황을 잃지 않게 함
+        uint32_t pn;
+        uint32_t dn;
+    };
+
+    // orNode: 공격 측 차례. movesLeft: 남은 공격 측 수. position: Zobrist::Key(board, toMove)
+    // board는 수를 둬 보고 되돌리므로 호출이 끝나면 원래 상태
+    void Mid(Board& board, uint64_t position, bool toMove, bool orNode, int movesLeft, uint32_t thpn, uint32_t thdn, uint32_t& outPn, uint32_t& outDn);
+    // 1 = 증명, 0 = 반증, -1 = 중단
+    int Prove(Board& board, bool toMove, bool orNode, int movesLeft);
+    // 증명되는 가장 작은 movesLeft (없으면 -1)
+    int MinMate(Board& board, bool toMove, bool orNode, int limit);
+    bool ExtractLine(const Board& board, bool toMove, bool orNode, int movesLeft, std::vector<Move>& line);
+    bool Terminal(const Board& board, uint64_t position, bool toMove, bool orNode, int movesLeft, std::vector<Child>& children, uint32_t& pn, uint32_t& dn);
+    void GenerateChildren(const Board& board, uint64_t position, bool toMove, bool childOr, int childMoves, std::vector<Child>& children);
+
+    static uint64_t NodeKey(uint64_t position, bool orNode, int movesLeft);
+    bool Lookup(uint64_t key, uint32_t& pn, uint32_t& dn) const;
+    void Store(uint64_t key, uint32_t pn, uint32_t dn);
+
+    MateSolverOptions m_options;
+    GameLogic m_logic;
+    std::vector<Entry> m_table;
+    uint64_t m_mask = 0;
+    uint64_t m_nodes = 0;
+    uint32_t m_generation = 0;
+    bool m_aborted = false;
+};
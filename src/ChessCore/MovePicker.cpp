@@ -0,0 +1,239 @@
+﻿#include "MovePicker.h"
+#include "Geometry.h"
+
+namespace
+{
+    const int k_value[] = { 0, 1, 3, 3, 5, 9, 100 }; // PieceType 순서 (MVV-LVA)
+}
+
+MovePicker::MovePicker(const Board& board, bool isWhiteTurn)
+    : m_board(board), m_white(isWhiteTurn)
+{
+    m_own = board.Occupancy(m_white);
+    m_enemy = board.Occupancy(!m_white);
+    m_occupied = m_own | m_enemy;
+
+    for (uint64_t m = m_enemy; m; ) {
+        int sq = Geometry::PopLsb(m);
+        uint64_t bit = Geometry::SquareBit(sq);
+        switch (board.GetPiece(sq % 8, sq / 8).type) {
+        case PieceType::Pawn:   m_enemyPawns |= bit; break;
+        case PieceType::Knight: m_enemyKnights |= bit; break;
+        case PieceType::Bishop: m_enemyBishopQueens |= bit; break;
+        case PieceType::Rook:   m_enemyRookQueens |= bit; break;
+        case PieceType::Queen:  m_enemyBishopQueens |= bit; m_enemyRookQueens |= bit; break;
+        case PieceType::King:   m_enemyKing |= bit; break;
+        default: break;
+        }
+    }
+
+    if (board.m_enPassantX >= 0)
+        m_epSquare = board.m_enPassantY * 8 + board.m_enPassantX;
+
+    int kx = -1, ky = -1;
+    if (!board.FindKing(m_white, kx, ky)) return; // 킹이 없으면 (비정상) 모든 의사 합법수가 합법
+    m_king = ky * 8 + kx;
+    m_checkers = EnemyAttackers(m_king, m_occupied, 0);
+
+    // 핀: 킹에서 본 첫 기물이 내 것이고 그 뒤에 같은 선의 상대 슬라이더
+    uint64_t diagonal = Geometry::SliderAttacks(m_king, Geometry::k_bishopDirs, m_occupied);
+    uint64_t straight = Geometry::SliderAttacks(m_king, Geometry::k_rookDirs, m_occupied);
+    uint64_t snipers = (Geometry::SliderAttacks(m_king, Geometry::k_bishopDirs, m_occupied & ~(diagonal & m_own)) & ~diagonal & m_enemyBishopQueens)
+        | (Geometry::SliderAttacks(m_king, Geometry::k_rookDirs, m_occupied & ~(straight & m_own)) & ~straight & m_enemyRookQueens);
+    while (snipers) {
+        int s = Geometry::PopLsb(snipers);
+        m_pinned |= Geometry::Between(s, m_king) & m_own;
+    }
+}
+
+uint64_t MovePicker::EnemyAttackers(int sq, uint64_t occupied, uint64_t ignore) const
+{
+    uint64_t keep = ~ignore;
+    return ((Geometry::KnightAttacks(sq) & m_enemyKnights)
+        | (Geometry::PawnAttacks(m_white, sq) & m_enemyPawns) // 상대 폰이 sq를 공격하는 칸 = 내 폰 공격 방향
+        | (Geometry::KingAttacks(sq) & m_enemyKing)
+        | (Geometry::SliderAttacks(sq, Geometry::k_bishopDirs, occupied) & m_enemyBishopQueens)
+        | (Geometry::SliderAttacks(sq, Geometry::k_rookDirs, occupied) & m_enemyRookQueens)) & keep;
+}
+
+uint64_t MovePicker::PieceAttacks(PieceType type, int sq) const
+{
+    switch (type) {
+    case PieceType::Knight: return Geometry::KnightAttacks(sq);
+    case PieceType::Bishop: return Geometry::SliderAttacks(sq, Geometry::k_bishopDirs, m_occupied);
+    case PieceType::Rook:   return Geometry::SliderAttacks(sq, Geometry::k_rookDirs, m_occupied);
+    case PieceType::Queen:  return Geometry::SliderAttacks(sq, Geometry::k_queenDirs, m_occupied);
+    case PieceType::King:   return Geometry::KingAttacks(sq);
+    default:                return 0;
+    }
+}
+
+void MovePicker::Add(int from, int to, PieceType promotion, int score)
+{
+    Move& mv = m_moves[m_count];
+    mv.sx = from % 8; mv.sy = from / 8;
+    mv.dx = to % 8; mv.dy = to / 8;
+    mv.promotion = promotion;
+    mv.check = 0;
+    m_scores[m_count] = score;
+    ++m_count;
+}
+
+void MovePicker::GenerateCaptures()
+{
+    static const PieceType k_promos[] = { PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight };
+    int pawnDir = m_white ? -8 : 8;
+    int promoRank = m_white ? 0 : 7;
+
+    for (uint64_t m = m_own; m; ) {
+        int from = Geometry::PopLsb(m);
+        const Piece& p = m_board.GetPiece(from % 8, from / 8);
+        int attacker = k_value[(int)p.type];
+
+        if (p.type != PieceType::Pawn) {
+            for (uint64_t t = PieceAttacks(p.type, from) & m_enemy; t; ) {
+                int to = Geometry::PopLsb(t);
+                Add(from, to, PieceType::None, k_value[(int)m_board.GetPiece(to % 8, to / 8).type] * 16 - attacker);
+            }
+            continue;
+        }
+
+        // 폰: 대각선 잡기 (+ 앙파상), 승급 칸이면 네 종류. 밀어서 승급도 이 단계
+        uint64_t targets = Geometry::PawnAttacks(m_white, from) & m_enemy;
+        if (m_epSquare >= 0) targets |= Geometry::PawnAttacks(m_white, from) & Geometry::SquareBit(m_epSquare);
+        int push = from + pawnDir;
+        if (push >= 0 && push < 64 && push / 8 == promoRank && !(m_occupied & Geometry::SquareBit(push)))
+            targets |= Geometry::SquareBit(push);
+
+        while (targets) {
+            int to = Geometry::PopLsb(targets);
+            const Piece& victim = m_board.GetPiece(to % 8, to / 8);
+            int gain = (victim.type != PieceType::None) ? k_value[(int)victim.type] * 16 : (to == m_epSquare ? 16 : 0);
+            if (to / 8 == promoRank) {
+                // 퀸 승급이 가장 앞, 언더프로모션은 단계의 맨 뒤
+                for (int i = 0; i < 4; ++i)
+                    Add(from, to, k_promos[i], i == 0 ? 2000 + gain : -1000 + gain - i);
+            }
+            else {
+                Add(from, to, PieceType::None, gain - 1);
+            }
+        }
+    }
+}
+
+void MovePicker::GenerateQuiets()
+{
+    int pawnDir = m_white ? -8 : 8;
+    int promoRank = m_white ? 0 : 7;
+    uint64_t empty = ~m_occupied;
+
+    for (uint64_t m = m_own; m; ) {
+        int from = Geometry::PopLsb(m);
+        const Piece& p = m_board.GetPiece(from % 8, from / 8);
+        if (p.type != PieceType::Pawn) {
+            for (uint64_t t = PieceAttacks(p.type, from) & empty; t; )
+                Add(from, Geometry::PopLsb(t), PieceType::None, 0);
+            continue;
+        }
+        int push = from + pawnDir;
+        if (push < 0 || push >= 64 || push / 8 == promoRank || !(empty & Geometry::SquareBit(push))) continue;
+        Add(from, push, PieceType::None, 0);
+        // 두 칸 전진은 GameLogic과 같이 hasMoved 기준
+        int push2 = push + pawnDir;
+        if (!p.hasMoved && push2 >= 0 && push2 < 64 && (empty & Geometry::SquareBit(push2)))
+            Add(from, push2, PieceType::None, 0);
+    }
+}
+
+void MovePicker::GenerateCastling()
+{
+    // 킹이 체크면 불가. 지나가는 두 칸은 공격받지 않아야 함 (킹이 아직 제자리라 공격 비트맵을 그대로 써도 됨)
+    if (m_king < 0 || m_checkers) return;
+    const Piece& king = m_board.GetPiece(m_king % 8, m_king / 8);
+    if (king.hasMoved) return;
+    int y = m_king / 8, x = m_king % 8;
+    bool rights[2] = {
+        m_white ? m_board.m_whiteCanCastleK : m_board.m_blackCanCastleK,
+        m_white ? m_board.m_whiteCanCastleQ : m_board.m_blackCanCastleQ };
+
+    for (int side = 0; side < 2; ++side) {
+        if (!rights[side]) continue;
+        int rookX = side == 0 ? 7 : 0, step = side == 0 ? 1 : -1;
+        if (x + 2 * step < 0 || x + 2 * step > 7) continue;
+        const Piece& rook = m_board.GetPiece(rookX, y);
+        if (rook.type != PieceType::Rook || rook.color != king.color || rook.hasMoved) continue;
+        if (Geometry::Between(m_king, y * 8 + rookX) & m_occupied) continue;
+        if (m_board.IsAttacked(x + step, y, !m_white) || m_board.IsAttacked(x + 2 * step, y, !m_white)) continue;
+        Add(m_king, m_king + 2 * step, PieceType::None, 0);
+    }
+}
+
+void MovePicker::GenerateStage()
+{
+    m_count = 0;
+    m_index = 0;
+    switch (m_stage) {
+    case Stage::Captures: GenerateCaptures(); break;
+    case Stage::Quiets:   GenerateQuiets(); break;
+    case Stage::Castling: GenerateCastling(); break;
+    default: break;
+    }
+}
+
+bool MovePicker::IsLegal(const Move& move) const
+{
+    if (m_king < 0) return true;
+    int from = move.sy * 8 + move.sx;
+    int to = move.dy * 8 + move.dx;
+    uint64_t fromBit = Geometry::SquareBit(from), toBit = Geometry::SquareBit(to);
+
+    if (from == m_king) {
+        if (move.dx - move.sx == 2 || move.dx - move.sx == -2) return true; // 캐슬링은 생성 때 검사함
+        // 킹이 비킨 자리로 광선이 이어지므로 킹을 뺀 점유로 도착 칸 공격 확인
+        return EnemyAttackers(to, m_occupied & ~fromBit, toBit) == 0;
+    }
+    if (m_checkers & (m_checkers - 1)) return false; // 이중 체크: 킹만 움직일 수 있음
+
+    if (to == m_epSquare && m_board.GetPiece(move.sx, move.sy).type == PieceType::Pawn) {
+        // 앙파상: 칸 세 개가 바뀌어 (가로 핀 등) 이동 후 점유로 직접 확인
+        uint64_t captured = Geometry::SquareBit(move.sy * 8 + move.dx);
+        uint64_t occupied = (m_occupied & ~fromBit & ~captured) | toBit;
+        return EnemyAttackers(m_king, occupied, captured) == 0;
+    }
+    if (m_checkers) {
+        // 체크한 기물을 잡거나 사이를 막아야 함
+        int checker = Geometry::Lsb(m_checkers);
+        if (!(toBit & (m_checkers | Geometry::Between(checker, m_king)))) return false;
+    }
+    if ((m_pinned & fromBit) && !(Geometry::Line(m_king, from) & toBit)) return false;
+    return true;
+}
+
+bool MovePicker::Next(Move& outMove)
+{
+    while (m_stage != Stage::Done) {
+        if (m_index == 0 && m_count == 0) GenerateStage();
+
+        while (m_index < m_count) {
+            // 잡는 수 단계는 남은 것 중 점수가 가장 높은 수를 앞으로 (하나만 필요하면 정렬 비용도 하나분)
+            if (m_stage == Stage::Captures) {
+                int best = m_index;
+                for (int i = m_index + 1; i < m_count; ++i)
+                    if (m_scores[i] > m_scores[best]) best = i;
+                if (best != m_index) {
+                    Move tm = m_moves[best]; m_moves[best] = m_moves[m_index]; m_moves[m_index] = tm;
+                    int ts = m_scores[best]; m_scores[best] = m_scores[m_index]; m_scores[m_index] = ts;
+                }
+            }
+            const Move& mv = m_moves[m_index++];
+            if (IsLegal(mv)) {
+                outMove = mv;
+                return true;
+            }
+        }
+        m_stage = (Stage)((int)m_stage + 1);
+        m_count = 0;
+        m_index = 0;
+    }
+    return false;
+}
@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <cstdint>
+#include "GameLogic.h"
+
+// [추가] 단계별 지연 합법수 생성기
+// 잡는 수 / 승급 -> 조용한 수 -> 캐슬링 순으로, 앞 단계를 다 꺼낸 뒤에야 다음 단계를 만듦
+// - 보드를 복사해 수를 둬 보지 않고 체크 / 핀 / 킹 도착 칸 공격(x-ray 포함)으로 합법 여부 판정
+//   (Board 복사는 히스토리까지 복사하므로 대국 중 보드에서 특히 비쌈)
+// - 합법 판정도 꺼낼 때 함 -> HasLegalMoves처럼 하나만 필요한 곳은 첫 합법수에서 끝
+// - 잡는 수는 MVV-LVA 순 (비싼 기물을 싼 기물로 먼저), 퀸 승급이 맨 앞
+// 한 단계의 수는 고정 배열에 담아 할당이 없음. Move::check는 채우지 않음 (필요하면 GameLogic::GivesCheck)
+class MovePicker
+{
+public:
+    enum class Stage : uint8_t
+    {
+        Captures = 0,   // 잡는 수, 앙파상, 승급 (밀어서 승급 포함)
+        Quiets,
+        Castling,
+        Done
+    };
+
+    MovePicker(const Board& board, bool isWhiteTurn);
+
+    // 다음 합법수. 더 없으면 false
+    bool Next(Move& outMove);
+    Stage CurrentStage() const { return m_stage; }
+    bool InCheck() const { return m_checkers != 0; }
+
+private:
+    static const int k_maxStageMoves = 224; // 한 국면 합법수 최대 218
+
+    void GenerateStage();
+    void GenerateCaptures();
+    void GenerateQuiets();
+    void GenerateCastling();
+    void Add(int from, int to, PieceType promotion, int score);
+
+    bool IsLegal(const Move& move) const;
+    // occupied 기준으로 그 칸을 공격하는 상대 기물 (ignore 칸의 상대 기물은 없는 것으로 봄)
+    uint64_t EnemyAttackers(int sq, uint64_t occupied, uint64_t ignore) const;
+    uint64_t PieceAttacks(PieceType type, int sq) const;
+
+    const Board& m_board;
+    bool m_white;
+    Stage m_stage = Stage::Captures;
+
+    uint64_t m_own = 0, m_enemy = 0, m_occupied = 0;
+    // 상대 기물 종류별 위치
+    uint64_t m_enemyPawns = 0, m_enemyKnights = 0, m_enemyBishopQueens = 0, m_enemyRookQueens = 0, m_enemyKing = 0;
+    int m_king = -1;
+    uint64_t m_checkers = 0;
+    uint64_t m_pinned = 0;
+    int m_epSquare = -1;
+
+    Move m_moves[k_maxStageMoves];
+    int m_scores[k_maxStageMoves];
+    int m_count = 0;
+    int m_index = 0;
+};
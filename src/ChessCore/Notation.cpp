@@ -0,0 +1,169 @@
+﻿#include "Notation.h"
+#include <vector>
+#include "Board.h"
+
+namespace
+{
+    char PieceLetter(PieceType t)
+    {
+        switch (t) {
+        case PieceType::Knight: return 'N';
+        case PieceType::Bishop: return 'B';
+        case PieceType::Rook:   return 'R';
+        case PieceType::Queen:  return 'Q';
+        case PieceType::King:   return 'K';
+        default:                return 0;
+        }
+    }
+
+    // 비교용 SAN: 체크/주석/승급 '=' 기호를 떼고 캐슬링의 숫자 0을 O로 통일
+    std::string CanonicalSAN(const std::string& san)
+    {
+        std::string out;
+        for (char c : san) {
+            if (c == '+' || c == '#' || c == '!' || c == '?' || c == '=') continue;
+            out += (c == '0') ? 'O' : c;
+        }
+        return out;
+    }
+}
+
+std::string Notation::SquareName(int x, int y)
+{
+    std::string s;
+    s += (char)('a' + x);
+    s += (char)('0' + (8 - y));
+    return s;
+}
+
+std::string Notation::MoveToUCI(const Move& move)
+{
+    std::string s = SquareName(move.sx, move.sy) + SquareName(move.dx, move.dy);
+    switch (move.promotion) {
+    case PieceType::Queen:  s += 'q'; break;
+    case PieceType::Rook:   s += 'r'; break;
+    case PieceType::Bishop: s += 'b'; break;
+    case PieceType::Knight: s += 'n'; break;
+    default: break;
+    }
+    return s;
+}
+
+bool Notation::MoveFromUCI(const std::string& uci, Move& outMove)
+{
+    return MoveFromUCI(uci.data(), uci.size(), outMove);
+}
+
+bool Notation::MoveFromUCI(const char* uci, size_t length, Move& outMove)
+{
+    if (length < 4) return false;
+    if (uci[0] < 'a' || uci[0] > 'h' || uci[2] < 'a' || uci[2] > 'h') return false;
+    if (uci[1] < '1' || uci[1] > '8' || uci[3] < '1' || uci[3] > '8') return false;
+
+    Move mv{};
+    mv.sx = uci[0] - 'a';
+    mv.sy = 8 - (uci[1] - '0');
+    mv.dx = uci[2] - 'a';
+    mv.dy = 8 - (uci[3] - '0');
+
+    // [승급 파싱] e.g. a7a8q
+    if (length >= 5) {
+        switch (uci[4]) {
+        case 'q': mv.promotion = PieceType::Queen; break;
+        case 'r': mv.promotion = PieceType::Rook; break;
+        case 'b': mv.promotion = PieceType::Bishop; break;
+        case 'n': mv.promotion = PieceType::Knight; break;
+        default: mv.promotion = PieceType::Queen; break;
+        }
+    }
+    outMove = mv;
+    return true;
+}
+
+namespace
+{
+    // 체크 표시 없는 SAN. 같은 칸으로 가는 같은 종류 기물의 구분 표기는 legal(그 국면의 합법수)로 판단
+    // (폰 / 캐슬링은 legal을 보지 않으므로 비어 있어도 됨)
+    std::string SanBody(const Board& board, const Move& move, const std::vector<Move>& legal)
+    {
+        const Piece& p = board.GetPiece(move.sx, move.sy);
+        const Piece& target = board.GetPiece(move.dx, move.dy);
+        std::string san;
+
+        if (p.type == PieceType::King && (move.dx - move.sx == 2 || move.dx - move.sx == -2)) {
+            san = (move.dx > move.sx) ? "O-O" : "O-O-O";
+        }
+        else if (p.type == PieceType::Pawn) {
+            bool capture = (move.dx != move.sx); // 대각선 이동 = 캡처 (앙파상 포함)
+            if (capture) {
+                san += (char)('a' + move.sx);
+                san += 'x';
+            }
+            san += Notation::SquareName(move.dx, move.dy);
+            if (move.dy == 0 || move.dy == 7) {
+                san += '=';
+                san += PieceLetter(move.promotion != PieceType::None ? move.promotion : PieceType::Queen);
+            }
+        }
+        else {
+            san += PieceLetter(p.type);
+
+            // 같은 종류의 다른 기물이 같은 칸으로 갈 수 있으면 구분 표기
+            bool ambiguous = false, sameFile = false, sameRank = false;
+            for (const auto& o : legal) {
+                if (o.dx != move.dx || o.dy != move.dy) continue;
+                if (o.sx == move.sx && o.sy == move.sy) continue;
+                if (board.GetPiece(o.sx, o.sy).type != p.type) continue;
+                ambiguous = true;
+                if (o.sx == move.sx) sameFile = true;
+                if (o.sy == move.sy) sameRank = true;
+            }
+            if (ambiguous) {
+                if (!sameFile) san += (char)('a' + move.sx);
+                else if (!sameRank) san += (char)('0' + (8 - move.sy));
+                else san += Notation::SquareName(move.sx, move.sy);
+            }
+
+            if (target.type != PieceType::None) san += 'x';
+            san += Notation::SquareName(move.dx, move.dy);
+        }
+        return san;
+    }
+}
+
+std::string Notation::MoveToSAN(const Board& board, const Move& move, bool isWhiteTurn, GameLogic& logic)
+{
+    // 구분 표기가 필요할 수 있는 기물 수만 합법수를 만듦
+    std::vector<Move> legal;
+    PieceType type = board.GetPiece(move.sx, move.sy).type;
+    if (type != PieceType::Pawn && type != PieceType::King)
+        logic.GenerateLegalMoves(board, isWhiteTurn, legal);
+    std::string san = SanBody(board, move, legal);
+
+    // 체크 / 체크메이트 표시
+    // [변경] 체크 여부는 수를 두지 않고 판정 -> 체크인 수만 둬 보고 메이트인지 확인
+    if (logic.GivesCheck(board, move, isWhiteTurn)) {
+        Board after = board;
+        if (logic.ApplyMove(after, move, isWhiteTurn))
+            san += (logic.CheckGameState(after, !isWhiteTurn) == GameState::Checkmate) ? '#' : '+';
+    }
+    return san;
+}
+
+bool Notation::MoveFromSAN(const Board& board, const std::string& san, bool isWhiteTurn, GameLogic& logic, Move& outMove)
+{
+    std::string want = CanonicalSAN(san);
+    if (want.empty()) return false;
+
+    // [변경] 합법수 목록을 한 번만 만들고 후보마다 그 목록으로 표기를 만듦 (체크 기호는 비교에서 빠지므로 판정 안 함)
+    // 승급 Q/R/B/N은 목록에 각각 들어 있음
+    std::vector<Move> legal;
+    logic.GenerateLegalMoves(board, isWhiteTurn, legal);
+    for (const auto& mv : legal) {
+        if (CanonicalSAN(SanBody(board, mv, legal)) == want) {
+            outMove = mv;
+            return true;
+        }
+    }
+    return false;
+}
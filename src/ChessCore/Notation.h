@@ -0,0 +1,27 @@
+﻿#pragma once
+#include <cstddef>
+#include <string>
+#include "GameLogic.h"
+
+class Board;
+
+// 수 표기 변환 (UCI 좌표 표기 / SAN)
+// 좌표계: x 0..7 = a..h, y 0 = 8랭크 (Board와 동일)
+namespace Notation
+{
+    std::string SquareName(int x, int y);
+
+    // "e2e4", "a7a8q"
+    std::string MoveToUCI(const Move& move);
+    // 형식이 잘못되면 false. 승급 문자가 잘못되면 퀸으로 처리
+    bool MoveFromUCI(const std::string& uci, Move& outMove);
+    // [추가] 널 종료가 아닌 토큰에서 바로 (UCI info 줄 파서: 문자열 복사 없이)
+    bool MoveFromUCI(const char* uci, size_t length, Move& outMove);
+
+    // 표준 대수 기보 (예: "Nbd7", "exd5", "O-O", "e8=Q+")
+    // move는 board에서 합법수여야 함
+    std::string MoveToSAN(const Board& board, const Move& move, bool isWhiteTurn, GameLogic& logic);
+    // [추가] SAN -> 합법수 (EPD bm/am 등). "+", "#", "!", "?", "=" 와 "0-0" 표기 차이는 무시
+    // 합법수 중 일치하는 것이 없으면 false
+    bool MoveFromSAN(const Board& board, const std::string& san, bool isWhiteTurn, GameLogic& logic, Move& outMove);
+}
@@ -0,0 +1,58 @@
+﻿#include "PackedPosition.h"
+#include <array>
+#include <cstring>
+#include "Board.h"
+#include "Fen.h"
+#include "Geometry.h"
+
+bool PackedPosition::Encode(const Board& board, bool isWhiteTurn, PackedPosition& out)
+{
+    uint64_t black = board.Occupancy(false);
+    uint64_t occupied = board.Occupancy(true) | black;
+
+    std::memset(&out, 0, sizeof(out));
+    out.occupied = occupied;
+
+    // 칸마다 분기 없이 니블을 쌓음 (색 비트는 흑 점유 비트에서 바로 얻음)
+    int i = 0;
+    for (uint64_t m = occupied; m; ++i) {
+        if (i == 32) return false;
+        int sq = Geometry::PopLsb(m);
+        uint8_t nibble = (uint8_t)board.GetPiece(sq & 7, sq >> 3).type | (uint8_t)(((black >> sq) & 1) << 3);
+        out.pieces[i >> 1] |= (uint8_t)(nibble << ((i & 1) * 4));
+    }
+
+    out.flags = (uint8_t)((board.m_whiteCanCastleK ? WhiteCastleK : 0) | (board.m_whiteCanCastleQ ? WhiteCastleQ : 0)
+        | (board.m_blackCanCastleK ? BlackCastleK : 0) | (board.m_blackCanCastleQ ? BlackCastleQ : 0)
+        | (isWhiteTurn ? 0 : BlackToMove));
+    out.enPassant = (board.m_enPassantX >= 0) ? (uint8_t)(board.m_enPassantY * 8 + board.m_enPassantX) : k_noEnPassant;
+    return true;
+}
+
+bool PackedPosition::Decode(Board& board, bool& isWhiteTurn) const
+{
+    static const PieceColor k_colors[2] = { PieceColor::White, PieceColor::Black };
+
+    std::array<std::array<Piece, 8>, 8> cells{};
+    int i = 0;
+    for (uint64_t m = occupied; m; ++i) {
+        if (i == 32) return false;
+        int sq = Geometry::PopLsb(m);
+        int nibble = (pieces[i >> 1] >> ((i & 1) * 4)) & 0xF;
+        int type = nibble & 7;
+        if (type < (int)PieceType::Pawn || type > (int)PieceType::King) return false;
+        cells[sq >> 3][sq & 7] = Piece((PieceType)type, k_colors[nibble >> 3]);
+    }
+    if (enPassant != k_noEnPassant && enPassant >= 64) return false;
+
+    board.LoadCells(cells);
+    board.m_whiteCanCastleK = (flags & WhiteCastleK) != 0;
+    board.m_whiteCanCastleQ = (flags & WhiteCastleQ) != 0;
+    board.m_blackCanCastleK = (flags & BlackCastleK) != 0;
+    board.m_blackCanCastleQ = (flags & BlackCastleQ) != 0;
+    board.m_enPassantX = (enPassant == k_noEnPassant) ? -1 : (enPassant & 7);
+    board.m_enPassantY = (enPassant == k_noEnPassant) ? -1 : (enPassant >> 3);
+    Fen::InferHasMoved(board);
+    isWhiteTurn = (flags & BlackToMove) == 0;
+    return true;
+}
@@ -0,0 +1,39 @@
+﻿#pragma once
+#include <cstdint>
+
+class Board;
+
+// [추가] 고정 32바이트 국면 레코드 (대량 저장 / 학습 데이터용)
+// - occupied: 기물이 있는 칸 (비트 인덱스 = y * 8 + x)
+// - pieces: occupied의 비트 순서(낮은 칸부터)대로 기물 하나당 니블 하나 (하위 니블 먼저)
+//   니블 = PieceType(1..6) | 흑이면 8
+// - FEN 문자열과 달리 할당 없음, 크기 고정 -> 파일에서 인덱스로 바로 접근 (PositionFile)
+// hasMoved는 저장하지 않고 디코딩 때 FEN과 같은 규칙으로 추정 (Fen::InferHasMoved)
+struct PackedPosition
+{
+    enum Flags : uint8_t
+    {
+        WhiteCastleK = 1 << 0,
+        WhiteCastleQ = 1 << 1,
+        BlackCastleK = 1 << 2,
+        BlackCastleQ = 1 << 3,
+        BlackToMove = 1 << 4
+    };
+    static const uint8_t k_noEnPassant = 0xFF;
+
+    uint64_t occupied;
+    uint8_t pieces[16];    // 최대 32기물
+    uint8_t flags;
+    uint8_t enPassant;     // 앙파상 타겟 칸 인덱스 (없으면 k_noEnPassant)
+    uint16_t ply;          // 이하 호출부 데이터 (대국 내 수 번호, 평가값, 결과 등). 인코딩은 0으로 채움
+    int16_t score;
+    uint8_t result;
+    uint8_t reserved;
+
+    // 기물이 32개를 넘으면 false
+    static bool Encode(const Board& board, bool isWhiteTurn, PackedPosition& out);
+    // 니블 / 앙파상 칸이 잘못됐으면 false (board는 변경되지 않음)
+    bool Decode(Board& board, bool& isWhiteTurn) const;
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must stay 32 bytes (on-disk record)");
@@ -0,0 +1,101 @@
+﻿#include "PawnStructure.h"
+#include "Geometry.h"
+#include "Zobrist.h"
+
+namespace
+{
+    const uint64_t k_fileA = 0x0101010101010101ull;
+    const uint64_t k_fileH = k_fileA << 7;
+
+    // 백 전진 = y 감소 = 인덱스 감소
+    uint64_t FillUp(uint64_t b) { b |= b >> 8; b |= b >> 16; b |= b >> 32; return b; }
+    uint64_t FillDown(uint64_t b) { b |= b << 8; b |= b << 16; b |= b << 32; return b; }
+    uint64_t ShiftEast(uint64_t b) { return (b << 1) & ~k_fileA; }
+    uint64_t ShiftWest(uint64_t b) { return (b >> 1) & ~k_fileH; }
+    uint64_t Files(uint64_t b) { return FillUp(b) | FillDown(b); }
+
+    uint64_t PawnAttacks(uint64_t pawns, bool white)
+    {
+        return white ? ((pawns >> 9) & ~k_fileH) | ((pawns >> 7) & ~k_fileA)
+                     : ((pawns << 7) & ~k_fileH) | ((pawns << 9) & ~k_fileA);
+    }
+
+    // 폰 앞쪽 칸 (자기 칸 제외)
+    uint64_t FrontSpan(uint64_t pawns, bool white) { return white ? FillUp(pawns >> 8) : FillDown(pawns << 8); }
+
+    int PopCount(uint64_t b)
+    {
+        int n = 0;
+        while (b) { b &= b - 1; ++n; }
+        return n;
+    }
+
+    // 상대 진영 쪽 랭크 (1 = 시작 랭크 .. 6 = 승급 직전)
+    const int k_passedBonus[8] = { 0, 5, 10, 20, 35, 60, 100, 0 };
+    const int k_isolatedPenalty = 12;
+    const int k_doubledPenalty = 12;
+    const int k_backwardPenalty = 8;
+}
+
+void PawnStructure::Analyze(const Board& board, PawnStructure& out)
+{
+    out.key = Zobrist::PawnKey(board);
+    for (int c = 0; c < 2; ++c) {
+        out.pawns[c] = board.Pawns(c == 0);
+        out.attacks[c] = PawnAttacks(out.pawns[c], c == 0);
+    }
+
+    out.score = 0;
+    for (int c = 0; c < 2; ++c) {
+        bool white = c == 0;
+        uint64_t own = out.pawns[c], enemy = out.pawns[c ^ 1];
+
+        // 상대 폰의 앞쪽 칸과 그 옆 파일 = 내 폰이 통과할 수 없는 영역
+        uint64_t enemyFront = FrontSpan(enemy, !white);
+        out.passed[c] = own & ~(enemyFront | ShiftEast(enemyFront) | ShiftWest(enemyFront));
+
+        uint64_t files = Files(own);
+        out.isolated[c] = own & ~(ShiftEast(files) | ShiftWest(files));
+        out.doubled[c] = own & FrontSpan(own, !white); // 다른 자기 폰의 뒤쪽에 있는 폰
+
+        // 앞 칸이 자기 폰 공격 범위(옆 파일 폰이 전진하며 지킬 수 있는 칸)에 없고 상대 폰에게 공격받음
+        uint64_t ownSupport = white ? FillUp(out.attacks[c]) : FillDown(out.attacks[c]);
+        uint64_t stops = white ? own >> 8 : own << 8;
+        uint64_t weakStops = stops & ~ownSupport & out.attacks[c ^ 1];
+        out.backward[c] = (white ? weakStops << 8 : weakStops >> 8) & ~out.isolated[c];
+
+        int sign = white ? 1 : -1;
+        for (uint64_t p = out.passed[c]; p; ) {
+            int y = Geometry::PopLsb(p) / 8;
+            out.score += sign * k_passedBonus[white ? 7 - y : y];
+        }
+        out.score -= sign * (PopCount(out.isolated[c]) * k_isolatedPenalty
+            + PopCount(out.doubled[c]) * k_doubledPenalty
+            + PopCount(out.backward[c]) * k_backwardPenalty);
+    }
+}
+
+// 빈 슬롯은 key 0 + 모두 0 = 폰이 없는 국면의 분석 결과와 같으므로 따로 표시하지 않음
+PawnTable::PawnTable(int sizeBits)
+    : m_entries((size_t)1 << sizeBits), m_mask(((uint64_t)1 << sizeBits) - 1)
+{
+}
+
+const PawnStructure& PawnTable::Probe(const Board& board)
+{
+    uint64_t key = Zobrist::PawnKey(board);
+    PawnStructure& entry = m_entries[key & m_mask];
+    if (entry.key == key) {
+        ++m_hits;
+        return entry;
+    }
+    ++m_misses;
+    PawnStructure::Analyze(board, entry);
+    return entry;
+}
+
+void PawnTable::Clear()
+{
+    for (auto& e : m_entries) e = PawnStructure();
+    m_hits = m_misses = 0;
+}
@@ -0,0 +1,51 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+
+// [추가] 폰 구조 분석 (색 인덱스: 0 = 백, 1 = 흑, 비트 인덱스 = y * 8 + x)
+// 전부 폰 비트보드의 시프트 / 채우기로 계산 (칸별 루프 없음)
+// - passed   : 앞쪽(같은 파일 + 옆 파일)에 상대 폰이 없는 폰
+// - isolated : 옆 파일에 자기 폰이 없는 폰
+// - doubled  : 같은 파일 앞에 자기 폰이 있는 폰 (겹친 폰 중 뒤쪽)
+// - backward : 옆 파일 폰이 더는 지켜 줄 수 없고, 앞 칸이 상대 폰에게 공격받는 폰 (고립 폰은 제외)
+struct PawnStructure
+{
+    uint64_t key = 0;           // Zobrist::PawnKey
+    uint64_t pawns[2] = {};
+    uint64_t attacks[2] = {};   // 폰이 공격하는 칸
+    uint64_t passed[2] = {};
+    uint64_t isolated[2] = {};
+    uint64_t doubled[2] = {};
+    uint64_t backward[2] = {};
+    int score = 0;              // 백 기준 센티폰 (평가 함수에 그대로 더함)
+
+    // 약한 폰 (고립 / 겹침 / 뒤처짐) -> GUI 오버레이, 주석용
+    uint64_t Weak(bool white) const { int c = white ? 0 : 1; return isolated[c] | doubled[c] | backward[c]; }
+    uint64_t Passed(bool white) const { return passed[white ? 0 : 1]; }
+
+    static void Analyze(const Board& board, PawnStructure& out);
+};
+
+// [추가] 폰 해시 캐시
+// 폰 배치는 연속 국면 사이에 거의 바뀌지 않으므로 폰 전용 키로 분석 결과를 재사용
+// 직접 사상(키 하위 비트 = 슬롯), 충돌 시 덮어씀. 할당은 생성 시 한 번
+class PawnTable
+{
+public:
+    explicit PawnTable(int sizeBits = 12);
+
+    // 캐시에 있으면 그대로, 없으면 분석해서 넣고 돌려줌 (다음 Probe 전까지 유효)
+    const PawnStructure& Probe(const Board& board);
+    void Clear();
+
+    uint64_t Hits() const { return m_hits; }
+    uint64_t Misses() const { return m_misses; }
+
+private:
+    std::vector<PawnStructure> m_entries;
+    uint64_t m_mask;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
@@ -0,0 +1,165 @@
+﻿#include "PositionFile.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace
+{
+    const char k_magic[4] = { 'C', 'P', 'O', 'S' };
+    const uint32_t k_version = 1;
+    const uint32_t k_flagIndexed = 1;
+
+    uint64_t Mix(uint64_t h, uint64_t v)
+    {
+        h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        return h ^ (h >> 27);
+    }
+
+    bool SamePosition(const PackedPosition& a, const PackedPosition& b)
+    {
+        // occupied ~ enPassant (호출부 데이터 앞까지)
+        return std::memcmp(&a, &b, offsetof(PackedPosition, ply)) == 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+bool PositionFileWriter::Open(const std::string& path, bool buildIndex)
+{
+    Close();
+    m_file = MappedFile::OpenForWrite(path);
+    if (!m_file) return false;
+    std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+
+    // 자리만 잡아 두고 Close 때 개수/색인 위치를 채워 다시 씀
+    PositionFileHeader header{};
+    if (std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_buildIndex = buildIndex;
+    m_count = 0;
+    m_index.clear();
+    return true;
+}
+
+bool PositionFileWriter::Append(const PackedPosition& record)
+{
+    if (!m_file || std::fwrite(&record, sizeof(record), 1, m_file) != 1) return false;
+    if (m_buildIndex) m_index.push_back(PositionIndexEntry{ PositionFileReader::PositionKey(record), m_count });
+    ++m_count;
+    return true;
+}
+
+bool PositionFileWriter::Append(const Board& board, bool isWhiteTurn)
+{
+    PackedPosition record;
+    return PackedPosition::Encode(board, isWhiteTurn, record) && Append(record);
+}
+
+bool PositionFileWriter::Close()
+{
+    if (!m_file) return true;
+
+    PositionFileHeader header{};
+    std::memcpy(header.magic, k_magic, sizeof(k_magic));
+    header.version = k_version;
+    header.recordSize = sizeof(PackedPosition);
+    header.count = m_count;
+
+    bool ok = true;
+    if (m_buildIndex) {
+        // 같은 키는 레코드 순서 유지 -> Find가 가장 앞 레코드를 돌려줌
+        std::sort(m_index.begin(), m_index.end(), [](const PositionIndexEntry& a, const PositionIndexEntry& b) {
+            return a.key != b.key ? a.key < b.key : a.record < b.record;
+        });
+        header.flags |= k_flagIndexed;
+        header.indexOffset = sizeof(PositionFileHeader) + m_count * sizeof(PackedPosition);
+        if (!m_index.empty()) ok = std::fwrite(m_index.data(), sizeof(PositionIndexEntry), m_index.size(), m_file) == m_index.size();
+    }
+    ok = ok && std::fseek(m_file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    ok = (std::fclose(m_file) == 0) && ok;
+    m_file = nullptr;
+    m_index.clear();
+    m_index.shrink_to_fit();
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+bool PositionFileReader::Open(const std::string& path)
+{
+    Close();
+    if (!m_file.Open(path) || m_file.Size() < sizeof(PositionFileHeader)) {
+        Close();
+        return false;
+    }
+    m_base = m_file.Data();
+    m_size = m_file.Size();
+
+    // 헤더 검증: 레코드 / 색인이 파일 크기 안에 들어와야 함
+    PositionFileHeader header;
+    std::memcpy(&header, m_base, sizeof(header));
+    uint64_t recordsEnd = sizeof(PositionFileHeader) + header.count * sizeof(PackedPosition);
+    bool indexed = (header.flags & k_flagIndexed) != 0;
+    bool valid = std::memcmp(header.magic, k_magic, sizeof(k_magic)) == 0 && header.version == k_version
+        && header.recordSize == sizeof(PackedPosition)
+        && header.count <= (m_size - sizeof(PositionFileHeader)) / sizeof(PackedPosition)
+        && (!indexed || (header.indexOffset == recordsEnd
+            && header.count <= (m_size - recordsEnd) / sizeof(PositionIndexEntry)));
+    if (!valid) {
+        Close();
+        return false;
+    }
+
+    m_count = header.count;
+    m_records = (const PackedPosition*)(m_base + sizeof(PositionFileHeader));
+    m_index = indexed ? (const PositionIndexEntry*)(m_base + header.indexOffset) : nullptr;
+    return true;
+}
+
+void PositionFileReader::Close()
+{
+    m_file.Close();
+    m_base = nullptr;
+    m_size = 0;
+    m_records = nullptr;
+    m_index = nullptr;
+    m_count = 0;
+}
+
+uint64_t PositionFileReader::PositionKey(const PackedPosition& position)
+{
+    uint64_t words[3];
+    std::memcpy(words, position.pieces, sizeof(position.pieces));
+    words[2] = (uint64_t)position.flags | ((uint64_t)position.enPassant << 8);
+    uint64_t h = Mix(0, position.occupied);
+    for (uint64_t w : words) h = Mix(h, w);
+    return h;
+}
+
+int64_t PositionFileReader::Find(const PackedPosition& position) const
+{
+    if (!m_index) return -1;
+    uint64_t key = PositionKey(position);
+    const PositionIndexEntry* end = m_index + m_count;
+    const PositionIndexEntry* it = std::lower_bound(m_index, end, key,
+        [](const PositionIndexEntry& e, uint64_t k) { return e.key < k; });
+    // 키 충돌 대비 실제 레코드와 비교
+    for (; it != end && it->key == key; ++it)
+        if (SamePosition(m_records[it->record], position)) return (int64_t)it->record;
+    return -1;
+}
+
+int64_t PositionFileReader::Find(const Board& board, bool isWhiteTurn) const
+{
+    PackedPosition position;
+    if (!PackedPosition::Encode(board, isWhiteTurn, position)) return -1;
+    return Find(position);
+}
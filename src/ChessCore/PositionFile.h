@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "PackedPosition.h"
+
+// [추가] PackedPosition 레코드 파일 (.cpos)
+// [헤더 32B][레코드 32B x count][색인 16B x count (선택)]
+// - 레코드 크기가 고정이라 i번째 레코드 = 헤더 뒤 i * 32 바이트 -> 메모리 매핑 후 바로 접근
+// - 색인: (국면 키, 레코드 번호)를 키 순으로 정렬 -> 국면으로 레코드를 이진 탐색
+// - 쓰기는 순차 스트리밍 (개수는 Close 때 헤더에 기록). 리틀 엔디언 전용
+struct PositionFileHeader
+{
+    char magic[4];         // "CPOS"
+    uint32_t version;
+    uint32_t recordSize;   // sizeof(PackedPosition)
+    uint32_t flags;        // bit0: 색인 있음
+    uint64_t count;
+    uint64_t indexOffset;  // 색인 시작 위치 (없으면 0)
+};
+
+struct PositionIndexEntry
+{
+    uint64_t key;
+    uint64_t record;
+};
+
+class PositionFileWriter
+{
+public:
+    ~PositionFileWriter() { Close(); }
+
+    // buildIndex면 레코드마다 16바이트를 메모리에 모았다가 Close 때 정렬해서 씀
+    bool Open(const std::string& path, bool buildIndex = true);
+    bool Append(const PackedPosition& record);
+    bool Append(const Board& board, bool isWhiteTurn);
+    bool Close();
+    uint64_t Count() const { return m_count; }
+
+private:
+    std::FILE* m_file = nullptr;
+    bool m_buildIndex = false;
+    uint64_t m_count = 0;
+    std::vector<PositionIndexEntry> m_index;
+};
+
+class PositionFileReader
+{
+public:
+    PositionFileReader() = default;
+    PositionFileReader(const PositionFileReader&) = delete;
+    PositionFileReader& operator=(const PositionFileReader&) = delete;
+    ~PositionFileReader() { Close(); }
+
+    // 파일 전체를 읽기 전용으로 매핑. 헤더/크기가 맞지 않으면 false
+    bool Open(const std::string& path);
+    void Close();
+
+    uint64_t Count() const { return m_count; }
+    const PackedPosition& At(uint64_t i) const { return m_records[i]; }
+    bool HasIndex() const { return m_index != nullptr; }
+
+    // 같은 국면(배치/차례/캐슬링/앙파상)의 첫 레코드 번호. 없거나 색인이 없으면 -1
+    int64_t Find(const PackedPosition& position) const;
+    int64_t Find(const Board& board, bool isWhiteTurn) const;
+
+    // 호출부 데이터(ply/score/result)를 뺀 국면 부분만으로 만든 키
+    static uint64_t PositionKey(const PackedPosition& position);
+
+private:
+    MappedFile m_file;
+    const uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+    const PackedPosition* m_records = nullptr;
+    const PositionIndexEntry* m_index = nullptr;
+    uint64_t m_count = 0;
+};
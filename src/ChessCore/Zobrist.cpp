@@ -0,0 +1,121 @@
+﻿#include "Zobrist.h"
+#include "Board.h"
+#include "GameLogic.h"
+#include "Geometry.h"
+
+namespace
+{
+    struct Tables
+    {
+        uint64_t piece[2][7][64]; // [색][PieceType][칸]
+        uint64_t castling[4];     // 백K, 백Q, 흑K, 흑Q
+        uint64_t enPassantFile[8];
+        uint64_t blackToMove;
+
+        Tables()
+        {
+            // 고정 시드 splitmix64 -> 실행마다 같은 키
+            uint64_t s = 0x9E3779B97F4A7C15ull;
+            auto next = [&s]() {
+                uint64_t z = (s += 0x9E3779B97F4A7C15ull);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            };
+            for (auto& color : piece)
+                for (auto& type : color)
+                    for (auto& sq : type) sq = next();
+            for (auto& c : castling) c = next();
+            for (auto& f : enPassantFile) f = next();
+            blackToMove = next();
+        }
+    };
+
+    const Tables& GetTables()
+    {
+        static const Tables tables;
+        return tables;
+    }
+}
+
+uint64_t Zobrist::Key(const Board& board, bool isWhiteTurn)
+{
+    const Tables& t = GetTables();
+    uint64_t key = 0;
+    for (int c = 0; c < 2; ++c) {
+        uint64_t pieces = board.Occupancy(c == 0);
+        while (pieces) {
+            int sq = Geometry::PopLsb(pieces);
+            key ^= t.piece[c][(int)board.GetPiece(sq % 8, sq / 8).type][sq];
+        }
+    }
+    if (board.m_whiteCanCastleK) key ^= t.castling[0];
+    if (board.m_whiteCanCastleQ) key ^= t.castling[1];
+    if (board.m_blackCanCastleK) key ^= t.castling[2];
+    if (board.m_blackCanCastleQ) key ^= t.castling[3];
+    if (board.m_enPassantX >= 0) key ^= t.enPassantFile[board.m_enPassantX];
+    if (!isWhiteTurn) key ^= t.blackToMove;
+    return key;
+}
+
+uint64_t Zobrist::PawnKey(const Board& board)
+{
+    const Tables& t = GetTables();
+    uint64_t key = 0;
+    for (int c = 0; c < 2; ++c) {
+        uint64_t pawns = board.Pawns(c == 0);
+        while (pawns) key ^= t.piece[c][(int)PieceType::Pawn][Geometry::PopLsb(pawns)];
+    }
+    return key;
+}
+
+uint64_t Zobrist::KeyAfterMove(const Board& board, bool isWhiteTurn, uint64_t key, const Move& move)
+{
+    const Tables& t = GetTables();
+    int us = isWhiteTurn ? 0 : 1;
+    int from = move.sy * 8 + move.sx, to = move.dy * 8 + move.dx;
+    PieceType type = board.GetPiece(move.sx, move.sy).type;
+    const Piece& target = board.GetPiece(move.dx, move.dy);
+
+    key ^= t.blackToMove;
+    if (board.m_enPassantX >= 0) key ^= t.enPassantFile[board.m_enPassantX];
+
+    if (target.type != PieceType::None)
+        key ^= t.piece[us ^ 1][(int)target.type][to];
+
+    PieceType placed = type;
+    if (type == PieceType::Pawn) {
+        int diff = move.dy - move.sy;
+        if (diff == 2 || diff == -2) key ^= t.enPassantFile[move.sx];
+        else if (move.sx != move.dx && target.type == PieceType::None) // 앙파상: 잡히는 폰은 출발 랭크에
+            key ^= t.piece[us ^ 1][(int)PieceType::Pawn][move.sy * 8 + move.dx];
+        if (move.dy == 0 || move.dy == 7)
+            placed = (move.promotion != PieceType::None) ? move.promotion : PieceType::Queen;
+    }
+    key ^= t.piece[us][(int)type][from] ^ t.piece[us][(int)placed][to];
+
+    if (type == PieceType::King) {
+        int diff = move.dx - move.sx;
+        if (diff == 2 || diff == -2) {
+            int rank = move.sy * 8;
+            int rookFrom = rank + (diff > 0 ? 7 : 0), rookTo = rank + (diff > 0 ? 5 : 3);
+            key ^= t.piece[us][(int)PieceType::Rook][rookFrom] ^ t.piece[us][(int)PieceType::Rook][rookTo];
+        }
+        if (isWhiteTurn) {
+            if (board.m_whiteCanCastleK) key ^= t.castling[0];
+            if (board.m_whiteCanCastleQ) key ^= t.castling[1];
+        }
+        else {
+            if (board.m_blackCanCastleK) key ^= t.castling[2];
+            if (board.m_blackCanCastleQ) key ^= t.castling[3];
+        }
+    }
+    else if (type == PieceType::Rook) {
+        // ApplyMove와 같이 출발 칸만 봄 (색 구분 없음)
+        if (from == 56 && board.m_whiteCanCastleQ) key ^= t.castling[1];
+        if (from == 63 && board.m_whiteCanCastleK) key ^= t.castling[0];
+        if (from == 0 && board.m_blackCanCastleQ) key ^= t.castling[3];
+        if (from == 7 && board.m_blackCanCastleK) key ^= t.castling[2];
+    }
+    return key;
+}
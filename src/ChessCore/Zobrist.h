@@ -0,0 +1,17 @@
+﻿#pragma once
+#include <cstdint>
+
+class Board;
+struct Move;
+
+// [추가] 국면 해시 (Zobrist). 기물 배치 + 둘 차례 + 캐슬링 권한 + 앙파상 칸
+// 보드에서 매번 새로 계산 (기물 수만큼 XOR). 치환표 키 용도
+namespace Zobrist
+{
+    uint64_t Key(const Board& board, bool isWhiteTurn);
+    // [추가] key(= Key(board, isWhiteTurn))에서 move를 둔 뒤의 키를 바뀌는 항목만 XOR해 계산 (보드는 수를 두기 전)
+    // GameLogic::ApplyMove가 바꾸는 상태(앙파상 칸, 캐슬링 권한, 승급 기본값 퀸)와 똑같이 맞춤. move는 합법수여야 함
+    uint64_t KeyAfterMove(const Board& board, bool isWhiteTurn, uint64_t key, const Move& move);
+    // [추가] 폰 배치만의 키 (폰 구조 캐시용). Key와 같은 기물 테이블의 폰 항목만 XOR
+    uint64_t PawnKey(const Board& board);
+}
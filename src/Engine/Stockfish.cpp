@@ -1,5 +1,70 @@
 ﻿#include "Stockfish.h"
+#include <chrono>
+#include <cstdlib>
 #include "../Utils/Logger.h"
+#include "../Utils/Trace.h"
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    bool EqualsNoCase(const std::string& a, const std::string& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            char x = a[i], y = b[i];
+            if (x >= 'A' && x <= 'Z') x = (char)(x - 'A' + 'a');
+            if (y >= 'A' && y <= 'Z') y = (char)(y - 'A' + 'a');
+            if (x != y) return false;
+        }
+        return true;
+    }
+
+    int RemainingMs(std::chrono::steady_clock::time_point deadline)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        return left > 0 ? (int)left : 0;
+    }
+
+#ifndef _WIN32
+    // 이 스레드에서만 SIGPIPE를 막고, write가 EPIPE로 실패하며 생긴 신호는 풀기 전에 소비
+    // (이미 대기 중이던 SIGPIPE는 호출자 것이므로 그대로 둠)
+    class SigPipeGuard
+    {
+    public:
+        SigPipeGuard()
+        {
+            sigemptyset(&m_set);
+            sigaddset(&m_set, SIGPIPE);
+            sigset_t pending;
+            sigpending(&pending);
+            m_wasPending = sigismember(&pending, SIGPIPE) == 1;
+            pthread_sigmask(SIG_BLOCK, &m_set, &m_old);
+        }
+        ~SigPipeGuard()
+        {
+            if (m_raised && !m_wasPending) {
+                const timespec zero = { 0, 0 };
+                while (sigtimedwait(&m_set, nullptr, &zero) < 0 && errno == EINTR) {}
+            }
+            pthread_sigmask(SIG_SETMASK, &m_old, nullptr);
+        }
+        void Raised() { m_raised = true; }
+
+    private:
+        sigset_t m_set;
+        sigset_t m_old;
+        bool m_wasPending = false;
+        bool m_raised = false;
+    };
+#endif
+}
 
 StockfishEngine::StockfishEngine() {}
 StockfishEngine::~StockfishEngine()
@@ -7,11 +72,25 @@ StockfishEngine::~StockfishEngine()
     Shutdown();
 }
 
-bool StockfishEngine::Initialize(const std::wstring& enginePath)
+#ifdef _WIN32
+
+bool StockfishEngine::Initialize(const std::wstring& enginePath, int handshakeTimeoutMs)
 {
     if (m_initialized)
         return true;
+    return CompleteStartup(Launch(enginePath), handshakeTimeoutMs);
+}
+
+bool StockfishEngine::Initialize(const std::string& enginePath, int handshakeTimeoutMs)
+{
+    int len = MultiByteToWideChar(CP_UTF8, 0, enginePath.c_str(), -1, nullptr, 0);
+    std::wstring w(len > 0 ? len - 1 : 0, L'\0');
+    if (len > 1) MultiByteToWideChar(CP_UTF8, 0, enginePath.c_str(), -1, &w[0], len);
+    return Initialize(w, handshakeTimeoutMs);
+}
 
+bool StockfishEngine::Launch(const std::wstring& enginePath)
+{
     SECURITY_ATTRIBUTES sa;
     sa.nLength = sizeof(SECURITY_ATTRIBUTES);
     sa.bInheritHandle = TRUE;
@@ -58,41 +137,39 @@ bool StockfishEngine::Initialize(const std::wstring& enginePath)
         &si,
         &m_pi))
     {
-        return false;
+        return false; // 파이프는 StopProcess에서 닫음
     }
 
-    m_initialized = true;
+    // [추가] 자식 쪽 끝은 부모가 들고 있지 않음 -> 엔진이 죽으면 ReadFile이 막히지 않고 실패로 돌아옴
+    CloseHandle(m_hChildStdoutWr);
+    CloseHandle(m_hChildStdinRd);
+    m_hChildStdoutWr = m_hChildStdinRd = nullptr;
 
-    SendCommand("uci");
-    SendCommand("isready");
-    for (;;)
-    {
-        std::string line = ReadLine();
-        if (line.find("readyok") != std::string::npos)
-            break;
-        if (line.empty())
-            break;
-    }
+    m_initialized = true;
     return true;
 }
 
-void StockfishEngine::Shutdown()
+void StockfishEngine::StopProcess()
 {
-    if (!m_initialized)
-        return;
-
-    SendCommand("quit");
-
-    if (m_pi.hProcess)
-    {
-        WaitForSingleObject(m_pi.hProcess, 1000);
-        CloseHandle(m_pi.hProcess);
-    }
-    if (m_pi.hThread)
+    if (m_initialized)
     {
-        CloseHandle(m_pi.hThread);
+        SendCommand("quit");
+
+        if (m_pi.hProcess)
+        {
+            // [추가] 응답 없는 엔진(핸드셰이크 시간 초과)은 강제 종료
+            if (WaitForSingleObject(m_pi.hProcess, 1000) == WAIT_TIMEOUT)
+                TerminateProcess(m_pi.hProcess, 1);
+            CloseHandle(m_pi.hProcess);
+        }
+        if (m_pi.hThread)
+        {
+            CloseHandle(m_pi.hThread);
+        }
+        ZeroMemory(&m_pi, sizeof(m_pi));
     }
 
+    // 프로세스를 만들지 못했어도 파이프는 있을 수 있음
     if (m_hChildStdinRd)  CloseHandle(m_hChildStdinRd);
     if (m_hChildStdinWr)  CloseHandle(m_hChildStdinWr);
     if (m_hChildStdoutRd) CloseHandle(m_hChildStdoutRd);
@@ -100,46 +177,403 @@ void StockfishEngine::Shutdown()
 
     m_hChildStdinRd = m_hChildStdinWr = nullptr;
     m_hChildStdoutRd = m_hChildStdoutWr = nullptr;
+    m_readBuf.clear();
+    m_readPos = 0;
+    m_multiPv = 1;
     m_initialized = false;
 }
 
 void StockfishEngine::SendCommand(const std::string& cmd)
 {
+    TRACE_SCOPE("SendCommand", "engine");
     if (!m_initialized)
         return;
 
     std::string data = cmd + "\n";
     DWORD written = 0;
     WriteFile(m_hChildStdinWr, data.c_str(), (DWORD)data.size(), &written, nullptr);
+    LOG_TRACE("engine >> %s", cmd.c_str());
+}
+
+size_t StockfishEngine::ReadChunk(char* buffer, size_t size)
+{
+    // [변경] 1바이트씩 ReadFile 하지 않고 파이프에 있는 만큼 한 번에 읽음 (info 줄이 몰려 올 때 호출 수 감소)
+    DWORD bytesRead = 0;
+    if (!ReadFile(m_hChildStdoutRd, buffer, (DWORD)size, &bytesRead, nullptr))
+        return 0;
+    return (size_t)bytesRead;
+}
+
+bool StockfishEngine::WaitReadable(int timeoutMs)
+{
+    // 익명 파이프는 대기 가능한 핸들이 아니라 짧게 자며 확인
+    ULONGLONG deadline = GetTickCount64() + (ULONGLONG)timeoutMs;
+    for (;;)
+    {
+        DWORD available = 0;
+        if (!PeekNamedPipe(m_hChildStdoutRd, nullptr, 0, nullptr, &available, nullptr))
+            return true; // 닫힘 -> ReadFile이 바로 실패로 돌아옴
+        if (available > 0)
+            return true;
+        if (GetTickCount64() >= deadline)
+            return false;
+        Sleep(1);
+    }
+}
+
+#else // POSIX
+
+bool StockfishEngine::Initialize(const std::string& enginePath, int handshakeTimeoutMs)
+{
+    if (m_initialized)
+        return true;
+    return CompleteStartup(Launch(enginePath), handshakeTimeoutMs);
+}
+
+bool StockfishEngine::Launch(const std::string& enginePath)
+{
+    // O_CLOEXEC: 다른 스레드가 동시에 띄우는 엔진이 이 파이프를 물려받지 않도록 (생성과 동시에 설정해야 틈이 없음)
+    // 물려받으면 이 엔진이 죽어도 쓰기 끝이 열려 있어 read가 EOF를 받지 못함. 자식의 dup2 사본은 플래그가 풀림
+    int toChild[2], fromChild[2];
+    if (pipe2(toChild, O_CLOEXEC) != 0)
+        return false;
+    if (pipe2(fromChild, O_CLOEXEC) != 0) {
+        close(toChild[0]); close(toChild[1]);
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(toChild[0]); close(toChild[1]);
+        close(fromChild[0]); close(fromChild[1]);
+        return false;
+    }
+    if (pid == 0) {
+        // 자식: stdin/stdout/stderr를 파이프로 연결 후 엔진 실행
+        dup2(toChild[0], STDIN_FILENO);
+        dup2(fromChild[1], STDOUT_FILENO);
+        dup2(fromChild[1], STDERR_FILENO);
+        close(toChild[0]); close(toChild[1]);
+        close(fromChild[0]); close(fromChild[1]);
+        execl(enginePath.c_str(), enginePath.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+
+    close(toChild[0]);
+    close(fromChild[1]);
+    m_pid = pid;
+    m_stdinFd = toChild[1];
+    m_stdoutFd = fromChild[0];
+    m_readBuf.clear();
+    m_readPos = 0;
+
+    m_initialized = true;
+    return true;
+}
+
+void StockfishEngine::StopProcess()
+{
+    if (!m_initialized)
+        return;
+
+    SendCommand("quit");
+    close(m_stdinFd);
+
+    // 최대 1초 대기 후 강제 종료
+    int status = 0;
+    bool exited = false;
+    for (int i = 0; i < 100 && !exited; ++i) {
+        if (waitpid(m_pid, &status, WNOHANG) == m_pid) exited = true;
+        else usleep(10000);
+    }
+    if (!exited) {
+        kill(m_pid, SIGKILL);
+        waitpid(m_pid, &status, 0);
+    }
+    close(m_stdoutFd);
+
+    m_pid = -1;
+    m_stdinFd = m_stdoutFd = -1;
+    m_readBuf.clear();
+    m_readPos = 0;
+    m_multiPv = 1;
+    m_initialized = false;
+}
+
+void StockfishEngine::SendCommand(const std::string& cmd)
+{
+    TRACE_SCOPE("SendCommand", "engine");
+    if (!m_initialized)
+        return;
+
+    LOG_TRACE("engine >> %s", cmd.c_str());
+    std::string data = cmd + "\n";
+    const char* p = data.c_str();
+    size_t left = data.size();
+    // 엔진이 먼저 죽었을 때 write가 프로세스를 종료시키지 않도록 (프로세스 전체 설정은 건드리지 않음)
+    SigPipeGuard guard;
+    while (left > 0) {
+        ssize_t n = write(m_stdinFd, p, left);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EPIPE) guard.Raised();
+        if (n <= 0) return;
+        p += n;
+        left -= (size_t)n;
+    }
+}
+
+size_t StockfishEngine::ReadChunk(char* buffer, size_t size)
+{
+    for (;;)
+    {
+        ssize_t n = read(m_stdoutFd, buffer, size);
+        if (n < 0 && errno == EINTR) continue;
+        return n > 0 ? (size_t)n : 0;
+    }
+}
+
+bool StockfishEngine::WaitReadable(int timeoutMs)
+{
+    pollfd pfd{};
+    pfd.fd = m_stdoutFd;
+    pfd.events = POLLIN;
+    for (;;)
+    {
+        int r = poll(&pfd, 1, timeoutMs);
+        if (r < 0 && errno == EINTR) continue;
+        return r != 0; // 오류 / 닫힘(POLLHUP)도 read가 바로 돌아오므로 true
+    }
+}
+
+#endif
+
+bool StockfishEngine::CompleteStartup(bool launched, int handshakeTimeoutMs)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = launched && Handshake(handshakeTimeoutMs);
+    if (ok) {
+        long long ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        LOG_INFO("engine ready: %s (%zu options) in %lld ms", m_idName.c_str(), m_options.size(), ms);
+    }
+    else {
+        if (launched) LOG_ERROR("engine handshake failed or timed out (%d ms)", handshakeTimeoutMs);
+        else LOG_ERROR("engine launch failed");
+        StopProcess();
+    }
+    m_state = ok ? State::Ready : State::Failed;
+    return ok;
+}
+
+void StockfishEngine::Shutdown()
+{
+    // 백그라운드 시작이 진행 중이면 끝난 뒤에 정리 (핸드셰이크 제한 시간이 상한)
+    std::shared_future<bool> startup = Startup();
+    if (startup.valid())
+        startup.wait();
+    StopProcess();
+    m_state = State::Stopped;
+}
+
+void StockfishEngine::StartAsync(const std::string& enginePath, int handshakeTimeoutMs)
+{
+    State state = m_state.load();
+    if (state == State::Starting || state == State::Ready)
+        return;
+
+    m_state = State::Starting;
+    std::shared_future<bool> startup = std::async(std::launch::async, [this, enginePath, handshakeTimeoutMs]() {
+        TRACE_SCOPE("EngineStartup", "engine");
+        return Initialize(enginePath, handshakeTimeoutMs);
+    }).share();
+    std::lock_guard<std::mutex> lock(m_startupMutex);
+    m_startup = startup;
+}
+
+bool StockfishEngine::WaitUntilReady(int timeoutMs)
+{
+    std::shared_future<bool> startup = Startup();
+    if (startup.valid())
+    {
+        if (timeoutMs < 0)
+            startup.wait();
+        else if (startup.wait_for(std::chrono::milliseconds(timeoutMs)) != std::future_status::ready)
+            return false;
+    }
+    return m_state.load() == State::Ready;
+}
+
+std::shared_future<bool> StockfishEngine::Startup()
+{
+    std::lock_guard<std::mutex> lock(m_startupMutex);
+    return m_startup;
+}
+
+const UciOption* StockfishEngine::FindOption(const std::string& name) const
+{
+    for (const UciOption& opt : m_options)
+        if (EqualsNoCase(opt.name, name))
+            return &opt;
+    return nullptr;
+}
+
+bool StockfishEngine::SetOption(const std::string& name, const std::string& value)
+{
+    bool known = FindOption(name) != nullptr;
+    if (!known)
+        LOG_WARN("engine option not advertised: %s", name.c_str());
+
+    // button 형식은 값 없이 보냄
+    SendCommand(value.empty() ? "setoption name " + name : "setoption name " + name + " value " + value);
+    if (EqualsNoCase(name, "MultiPV"))
+        m_multiPv = std::atoi(value.c_str());
+    return known;
+}
+
+// 이름 / 기본값은 공백을 포함할 수 있어 다음 키워드가 나올 때까지 이어 붙임
+void StockfishEngine::ParseOptionLine(const std::string& line)
+{
+    UciOption opt;
+    std::string* field = nullptr;
+    size_t pos = 0;
+    bool first = true;
+    while (pos < line.size())
+    {
+        while (pos < line.size() && line[pos] == ' ') ++pos;
+        size_t end = line.find(' ', pos);
+        if (end == std::string::npos) end = line.size();
+        std::string tok = line.substr(pos, end - pos);
+        pos = end;
+        if (tok.empty()) continue;
+
+        if (first) { first = false; continue; } // "option"
+        if (tok == "name" && opt.name.empty()) field = &opt.name;
+        else if (tok == "type") field = &opt.type;
+        else if (tok == "default") field = &opt.defaultValue;
+        else if (tok == "min") field = &opt.min;
+        else if (tok == "max") field = &opt.max;
+        else if (tok == "var") { opt.vars.emplace_back(); field = &opt.vars.back(); }
+        else if (field)
+        {
+            if (!field->empty()) *field += ' ';
+            *field += tok;
+        }
+    }
+    if (opt.defaultValue == "<empty>")
+        opt.defaultValue.clear();
+    if (!opt.name.empty())
+        m_options.push_back(std::move(opt));
 }
 
 std::string StockfishEngine::ReadLine()
 {
+    std::string line;
+    ReadLine(line);
+    return line;
+}
+
+bool StockfishEngine::ReadLine(std::string& line, int timeoutMs)
+{
+    TRACE_SCOPE("ReadLine", "engine"); // 파이프 대기 시간 = 엔진 탐색 시간 대부분
+    line.clear();
     if (!m_initialized)
-        return {};
+        return false;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0);
 
-    std::string result;
-    char ch;
-    DWORD bytesRead = 0;
+    // 블록 단위로 읽어 버퍼링. 소비한 앞부분은 줄마다 지우지 않고 다음 read 직전에 한 번에 버림
+    for (;;)
+    {
+        size_t nl = m_readBuf.find('\n', m_readPos);
+        if (nl != std::string::npos) {
+            size_t end = nl;
+            if (end > m_readPos && m_readBuf[end - 1] == '\r') --end;
+            line.assign(m_readBuf, m_readPos, end - m_readPos);
+            m_readPos = nl + 1;
+            LOG_TRACE("engine << %s", line.c_str());
+            return true;
+        }
+
+        m_readBuf.erase(0, m_readPos);
+        m_readPos = 0;
+
+        if (timeoutMs >= 0 && !WaitReadable(RemainingMs(deadline)))
+            return false;
+
+        char chunk[4096];
+        size_t n = ReadChunk(chunk, sizeof(chunk));
+        if (n == 0) {
+            // 닫힘: 개행 없이 남은 마지막 조각
+            line.swap(m_readBuf);
+            m_readBuf.clear();
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return !line.empty();
+        }
+        m_readBuf.append(chunk, n);
+    }
+}
+
+void StockfishEngine::SetMultiPv(int multiPv)
+{
+    if (multiPv == m_multiPv)
+        return;
+    SendCommand("setoption name MultiPV value " + std::to_string(multiPv));
+    m_multiPv = multiPv;
+}
+
+// [변경] readyok까지 제한 시간 안에. 그 사이 오는 id / option 줄을 보관
+bool StockfishEngine::Handshake(int timeoutMs)
+{
+    m_idName.clear();
+    m_idAuthor.clear();
+    m_options.clear();
 
-    while (true)
+    SendCommand("uci");
+    SendCommand("isready");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0);
+    std::string line;
+    for (;;)
     {
-        // 파이프에서 1바이트씩 읽음
-        if (!ReadFile(m_hChildStdoutRd, &ch, 1, &bytesRead, nullptr) || bytesRead == 0)
-            break;
-        if (ch == '\n')
-            break;
-        if (ch != '\r')
-            result.push_back(ch);
+        if (!ReadLine(line, timeoutMs < 0 ? -1 : RemainingMs(deadline)))
+            return false;
+        if (line.rfind("id name ", 0) == 0)
+            m_idName = line.substr(8);
+        else if (line.rfind("id author ", 0) == 0)
+            m_idAuthor = line.substr(10);
+        else if (line.rfind("option ", 0) == 0)
+            ParseOptionLine(line);
+        else if (line.find("readyok") != std::string::npos)
+            return true;
+    }
+}
+
+bool StockfishEngine::NewGame()
+{
+    if (!m_initialized)
+        return false;
+
+    SendCommand("ucinewgame");
+    SendCommand("isready");
+    for (;;)
+    {
+        std::string line = ReadLine();
+        if (line.find("readyok") != std::string::npos)
+            return true;
+        if (line.empty())
+            return false;
     }
-    return result;
 }
 
 std::string StockfishEngine::GetBestMove(const std::string& fen)
 {
+    return GetBestMove(fen, nullptr);
+}
+
+std::string StockfishEngine::GetBestMove(const std::string& fen, const InfoHandler& onInfo)
+{
+    TRACE_SCOPE("GetBestMove", "engine");
     if (!m_initialized)
         return {};
 
+    SetMultiPv(1); // Analyze가 바꿔 놓았으면 되돌림
     SendCommand("position fen " + fen);
     // [수정 전] 고정 깊이 10 (약 Expert 수준, 시간 가변적)
     // SendCommand("go depth 10"); 
@@ -147,11 +581,19 @@ std::string StockfishEngine::GetBestMove(const std::string& fen)
     // [수정 후] 시간 제한 방식 (밀리초 단위, 1000 = 1초)
     // 예: 3초 동안 생각하고 두기
     // go movetime 3000 : Elo 3500~3700, 세계 챔피언(Magnus Carlsen)도 이기기 힘든 수준
-    SendCommand("go movetime 3000");
+    // [변경] 기본값은 그대로 두고 SetSearchCommand로 바꿀 수 있게 함 (대국 러너: "go nodes N" 등)
+    SendCommand(m_goCommand);
 
-    for (;;)
+    bool stopSent = false;
+    std::string line; // [변경] 줄 버퍼 재사용
+    while (ReadLine(line))
     {
-        std::string line = ReadLine();
+        // [추가] 중단 요청 후의 info는 무시하고 bestmove만 기다림
+        if (onInfo && !stopSent && line.rfind("info", 0) == 0 && !onInfo(line))
+        {
+            SendCommand("stop");
+            stopSent = true;
+        }
 
         // bestmove가 나오면 파싱해서 반환
         if (line.rfind("bestmove", 0) == 0)
@@ -163,8 +605,57 @@ std::string StockfishEngine::GetBestMove(const std::string& fen)
                 return line.substr(pos + 1, pos2 - (pos + 1));
             }
         }
-        if (line.empty())
-            break;
     }
     return {};
-}
\ No newline at end of file
+}
+
+std::string StockfishEngine::Analyze(const std::string& fen, int multiPv, std::vector<UciInfo>& outLines,
+    const AnalysisHandler& onInfo)
+{
+    TRACE_SCOPE("Analyze", "engine");
+    outLines.clear();
+    if (!m_initialized)
+        return {};
+    if (multiPv < 1) multiPv = 1;
+
+    SetMultiPv(multiPv);
+    SendCommand("position fen " + fen);
+    SendCommand(m_goCommand);
+
+    // multipv 번호별 최신 줄. 줄 버퍼 / 파싱 레코드는 탐색 내내 재사용
+    std::vector<UciInfo> lines((size_t)multiPv);
+    UciInfo info;
+    std::string line;
+    std::string bestMove;
+    bool stopSent = false;
+    while (ReadLine(line))
+    {
+        if (line.rfind("bestmove", 0) == 0)
+        {
+            size_t pos = line.find(' ');
+            if (pos != std::string::npos)
+            {
+                size_t pos2 = line.find(' ', pos + 1);
+                bestMove = line.substr(pos + 1, pos2 - (pos + 1));
+            }
+            break;
+        }
+        if (stopSent || !UciInfoParser::Parse(line, info))
+            continue;
+
+        // 창 밖(bound) 결과는 같은 깊이에서 다시 나오는 정확한 값으로 덮이므로 이전 정확한 줄을 유지
+        if (info.HasPv() && info.multipv >= 1 && info.multipv <= multiPv
+            && ((!info.score.lowerbound && !info.score.upperbound) || !lines[info.multipv - 1].HasPv()))
+            lines[info.multipv - 1] = info;
+
+        if (onInfo && !onInfo(info))
+        {
+            SendCommand("stop");
+            stopSent = true;
+        }
+    }
+
+    for (const UciInfo& l : lines)
+        if (l.HasPv()) outLines.push_back(l);
+    return bestMove;
+}
@@ -1,26 +1,132 @@
 ﻿#pragma once
+#ifdef _WIN32
 #include <windows.h>
+#else
+#include <sys/types.h>
+#endif
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <string>
+#include <vector>
+#include "UciInfo.h"
+
+// [추가] 엔진이 "uci"에 답한 option 줄 하나 (핸드셰이크 때 읽어 보관)
+// option name <이름> type <check|spin|combo|button|string> [default <값>] [min <n>] [max <n>] [var <값>]*
+struct UciOption
+{
+    std::string name;
+    std::string type;
+    std::string defaultValue;
+    std::string min;
+    std::string max;
+    std::vector<std::string> vars; // combo 선택지
+};
 
 class StockfishEngine
 {
 public:
+    static const int k_defaultHandshakeTimeoutMs = 5000;
+
+    enum class State
+    {
+        Stopped,
+        Starting,   // StartAsync 후 핸드셰이크 중
+        Ready,
+        Failed      // 실행 파일이 없거나 제한 시간 안에 readyok가 오지 않음
+    };
+
     StockfishEngine();
     ~StockfishEngine();
 
-    bool Initialize(const std::wstring& enginePath);
+#ifdef _WIN32
+    bool Initialize(const std::wstring& enginePath, int handshakeTimeoutMs = k_defaultHandshakeTimeoutMs);
+#endif
+    // [추가] 플랫폼 공통 (UTF-8 경로). 대국 러너 등 헤드리스 도구용
+    // [변경] 핸드셰이크(uci -> isready -> readyok)에 제한 시간. 넘기면 프로세스를 정리하고 false
+    bool Initialize(const std::string& enginePath, int handshakeTimeoutMs = k_defaultHandshakeTimeoutMs);
     void Shutdown();
+    bool IsRunning() const { return m_initialized; }
+
+    // [추가] 백그라운드 시작: 프로세스 생성 + 핸드셰이크를 작업 스레드에서 (UI 스레드를 막지 않음)
+    // 이미 시작했거나 시작 중이면 아무것도 안 함. 실패한 뒤 다시 부르면 재시도
+    void StartAsync(const std::string& enginePath, int handshakeTimeoutMs = k_defaultHandshakeTimeoutMs);
+    // 시작 중이면 끝날 때까지 (최대 timeoutMs, 음수 = 끝날 때까지) 기다림. 준비됐으면 true
+    bool WaitUntilReady(int timeoutMs = -1);
+    State GetState() const { return m_state.load(); }
+
+    // [추가] 핸드셰이크 때 받은 id / option 줄 (준비된 뒤에만 읽을 것)
+    const std::string& EngineName() const { return m_idName; }
+    const std::string& EngineAuthor() const { return m_idAuthor; }
+    const std::vector<UciOption>& Options() const { return m_options; }
+    const UciOption* FindOption(const std::string& name) const; // 대소문자 무시 (UCI 규칙)
+    // setoption 전송. 엔진이 알리지 않은 옵션이면 경고 로그 후 false (그래도 보냄)
+    bool SetOption(const std::string& name, const std::string& value);
 
     void SendCommand(const std::string& cmd);
     std::string GetBestMove(const std::string& fen);
+    // [추가] 탐색 중 "info" 줄마다 onInfo 호출. false를 반환하면 stop을 보내고 bestmove까지 읽음
+    // (EPD 스위트 러너: 기대 수가 안정되면 조기 종료)
+    using InfoHandler = std::function<bool(const std::string& infoLine)>;
+    std::string GetBestMove(const std::string& fen, const InfoHandler& onInfo);
+
+    // [추가] 상위 multiPv개 수 분석. 탐색이 끝나면 outLines = multipv 번호 순 (1 = 최선)으로
+    // 번호마다 마지막으로 받은 PV 있는 줄 (합법수가 적으면 multiPv개보다 적을 수 있음). 반환값은 bestmove
+    // onInfo는 파싱된 info마다 호출 (레코드는 재사용되므로 보관하려면 복사). false를 반환하면 stop
+    using AnalysisHandler = std::function<bool(const UciInfo& info)>;
+    std::string Analyze(const std::string& fen, int multiPv, std::vector<UciInfo>& outLines,
+        const AnalysisHandler& onInfo = nullptr);
+
+    // [추가] 탐색 명령 (기본 "go movetime 3000")
+    void SetSearchCommand(const std::string& goCommand) { m_goCommand = goCommand; }
+    // [추가] ucinewgame 후 readyok까지 대기. 엔진이 응답 없이 종료되면 false
+    bool NewGame();
 
 private:
+#ifdef _WIN32
     PROCESS_INFORMATION m_pi{};
     HANDLE m_hChildStdinRd = nullptr;
     HANDLE m_hChildStdinWr = nullptr;
     HANDLE m_hChildStdoutRd = nullptr;
     HANDLE m_hChildStdoutWr = nullptr;
+#else
+    pid_t m_pid = -1;
+    int m_stdinFd = -1;
+    int m_stdoutFd = -1;
+#endif
     bool m_initialized = false;
+    std::atomic<State> m_state{ State::Stopped };
+    // 여러 스레드가 기다릴 수 있으므로 shared_future. 대입 / 복사는 m_startupMutex 안에서, 대기는 복사본으로
+    std::shared_future<bool> m_startup;
+    std::mutex m_startupMutex;
+    std::string m_idName;
+    std::string m_idAuthor;
+    std::vector<UciOption> m_options;
+    std::string m_goCommand = "go movetime 3000";
+    int m_multiPv = 1;         // 엔진에 마지막으로 보낸 MultiPV
+    // [변경] 두 플랫폼 공통 읽기 버퍼. 파이프에서 읽었지만 아직 줄로 소비되지 않은 바이트는 m_readPos부터
+    std::string m_readBuf;
+    size_t m_readPos = 0;
 
+#ifdef _WIN32
+    bool Launch(const std::wstring& enginePath);
+#else
+    bool Launch(const std::string& enginePath);
+#endif
+    // 프로세스 생성 결과를 받아 핸드셰이크까지 마치고 상태를 정함 (실패하면 정리)
+    bool CompleteStartup(bool launched, int handshakeTimeoutMs);
+    void StopProcess();
+    std::shared_future<bool> Startup(); // m_startup의 복사본 (스레드마다 자기 복사본으로 기다림)
+    bool Handshake(int timeoutMs);
     std::string ReadLine();
+    // [추가] line의 용량을 재사용해 한 줄 읽기 (줄마다 새 문자열을 만들지 않음)
+    // 파이프가 닫혔고 남은 바이트도 없으면 false. [추가] timeoutMs(0 이상) 안에 한 줄이 안 오면 false
+    bool ReadLine(std::string& line, int timeoutMs = -1);
+    // 파이프에서 읽을 수 있는 만큼 (최대 size) 읽음. 닫혔거나 오류면 0
+    size_t ReadChunk(char* buffer, size_t size);
+    // [추가] timeoutMs 안에 읽을 데이터가 생기거나 파이프가 닫히면 true (ReadChunk가 막히지 않음)
+    bool WaitReadable(int timeoutMs);
+    void ParseOptionLine(const std::string& line);
+    void SetMultiPv(int multiPv);
 };
@@ -0,0 +1,141 @@
+﻿#include "UciInfo.h"
+#include <cstring>
+#include "../ChessCore/Notation.h"
+
+namespace
+{
+    // 줄 안의 한 토큰 (원본을 가리키기만 함)
+    struct Token
+    {
+        const char* text = nullptr;
+        size_t length = 0;
+    };
+
+    class Tokenizer
+    {
+    public:
+        Tokenizer(const char* line, size_t length) : m_pos(line), m_end(line + length) {}
+
+        bool Next(Token& tok)
+        {
+            while (m_pos < m_end && IsSpace(*m_pos)) ++m_pos;
+            if (m_pos == m_end) return false;
+            tok.text = m_pos;
+            while (m_pos < m_end && !IsSpace(*m_pos)) ++m_pos;
+            tok.length = (size_t)(m_pos - tok.text);
+            return true;
+        }
+
+        // 방금 읽은 토큰을 되돌림 (pv 끝 판정용)
+        void Unread(const Token& tok) { m_pos = tok.text; }
+
+    private:
+        static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+        const char* m_pos;
+        const char* m_end;
+    };
+
+    template <size_t N>
+    bool Is(const Token& tok, const char (&word)[N])
+    {
+        return tok.length == N - 1 && std::memcmp(tok.text, word, N - 1) == 0;
+    }
+
+    bool ToInt(const Token& tok, int64_t& out)
+    {
+        size_t i = 0;
+        bool negative = false;
+        if (tok.length > 0 && (tok.text[0] == '-' || tok.text[0] == '+')) {
+            negative = tok.text[0] == '-';
+            i = 1;
+        }
+        if (i == tok.length) return false;
+        int64_t v = 0;
+        for (; i < tok.length; ++i) {
+            char c = tok.text[i];
+            if (c < '0' || c > '9') return false;
+            v = v * 10 + (c - '0');
+        }
+        out = negative ? -v : v;
+        return true;
+    }
+
+    // 키워드 뒤 정수 인자. 없거나 숫자가 아니면 되돌리고 기존 값 유지
+    template <typename T>
+    void ReadInt(Tokenizer& tz, T& out)
+    {
+        Token tok;
+        int64_t v = 0;
+        if (!tz.Next(tok)) return;
+        if (ToInt(tok, v)) out = (T)v;
+        else tz.Unread(tok);
+    }
+
+    // 레코드 재사용: PV 배열은 pvLength까지만 의미가 있으므로 지우지 않음
+    void Reset(UciInfo& info)
+    {
+        info.depth = info.seldepth = -1;
+        info.multipv = 1;
+        info.score = UciScore();
+        info.nodes = info.nps = info.timeMs = -1;
+        info.hashfull = -1;
+        info.wdl[0] = info.wdl[1] = info.wdl[2] = -1;
+        info.pvLength = 0;
+        info.pvTruncated = false;
+    }
+}
+
+bool UciInfoParser::Parse(const char* line, size_t length, UciInfo& out)
+{
+    Tokenizer tz(line, length);
+    Token tok;
+    if (!tz.Next(tok) || !Is(tok, "info")) return false;
+
+    Reset(out);
+    bool first = true;
+    while (tz.Next(tok)) {
+        if (Is(tok, "string")) {
+            // 자유 형식 문자열: 나머지는 전부 메시지
+            return !first;
+        }
+        first = false;
+
+        if (Is(tok, "depth")) ReadInt(tz, out.depth);
+        else if (Is(tok, "seldepth")) ReadInt(tz, out.seldepth);
+        else if (Is(tok, "multipv")) ReadInt(tz, out.multipv);
+        else if (Is(tok, "nodes")) ReadInt(tz, out.nodes);
+        else if (Is(tok, "nps")) ReadInt(tz, out.nps);
+        else if (Is(tok, "time")) ReadInt(tz, out.timeMs);
+        else if (Is(tok, "hashfull")) ReadInt(tz, out.hashfull);
+        else if (Is(tok, "lowerbound")) out.score.lowerbound = true;
+        else if (Is(tok, "upperbound")) out.score.upperbound = true;
+        else if (Is(tok, "score")) {
+            Token kind;
+            if (!tz.Next(kind)) break;
+            if (Is(kind, "cp")) out.score.type = UciScore::Type::Centipawns;
+            else if (Is(kind, "mate")) out.score.type = UciScore::Type::Mate;
+            else { tz.Unread(kind); continue; }
+            ReadInt(tz, out.score.value);
+        }
+        else if (Is(tok, "wdl")) {
+            for (int& v : out.wdl) ReadInt(tz, v);
+        }
+        else if (Is(tok, "pv")) {
+            // 수가 아닌 토큰이 나올 때까지가 PV
+            Token mv;
+            while (tz.Next(mv)) {
+                Move move;
+                if (!Notation::MoveFromUCI(mv.text, mv.length, move)) {
+                    tz.Unread(mv);
+                    break;
+                }
+                if (out.pvLength < UciInfo::k_maxPv) out.pv[out.pvLength++] = move;
+                else out.pvTruncated = true;
+            }
+        }
+        // 그 밖의 키워드(currmove, currmovenumber, tbhits, cpuload, refutation, currline ...)와
+        // 인자는 다음 루프에서 모르는 토큰으로 흘려보냄
+    }
+    return true;
+}
@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../ChessCore/GameLogic.h"
+
+// [추가] UCI "info" 줄 파서
+// 줄을 제자리에서 토큰으로 나눠 고정 크기 레코드에 채움 (문자열 복사 / 힙 할당 없음)
+// -> 힌트 화살표, 평가 그래프, 일괄 주석처럼 초당 수천 줄을 받는 곳에서 레코드 하나를 재사용
+struct UciScore
+{
+    enum class Type : uint8_t
+    {
+        None = 0,   // score 없음
+        Centipawns,
+        Mate        // value = 메이트까지 수 (음수면 탐색하는 쪽이 메이트 당함)
+    };
+
+    Type type = Type::None;
+    int value = 0;              // 탐색하는 쪽(차례인 쪽) 기준
+    bool lowerbound = false;    // 탐색 창 밖 결과: 실제 값은 value 이상 / 이하
+    bool upperbound = false;
+
+    bool IsExact() const { return type != Type::None && !lowerbound && !upperbound; }
+};
+
+struct UciInfo
+{
+    static const int k_maxPv = 64;   // 넘는 PV는 잘라 냄 (pvTruncated)
+
+    int depth = -1;             // -1 = 줄에 없음 (아래 정수 필드 모두 같음)
+    int seldepth = -1;
+    int multipv = 1;            // 1 = 최선
+    UciScore score;
+    int64_t nodes = -1;
+    int64_t nps = -1;
+    int64_t timeMs = -1;
+    int hashfull = -1;          // 천분율
+    int wdl[3] = { -1, -1, -1 }; // UCI_ShowWDL: 승/무/패 천분율
+    int pvLength = 0;
+    bool pvTruncated = false;
+    Move pv[k_maxPv];
+
+    bool HasPv() const { return pvLength > 0; }
+};
+
+namespace UciInfoParser
+{
+    // "info ..." 줄이면 out을 채우고 true. "info string ..."이나 info가 아닌 줄은 false
+    // 모르는 키워드(currmove, tbhits, refutation 등)와 그 인자는 건너뜀
+    bool Parse(const char* line, size_t length, UciInfo& out);
+    inline bool Parse(const std::string& line, UciInfo& out) { return Parse(line.data(), line.size(), out); }
+}
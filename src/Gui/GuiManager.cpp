@@ -1,10 +1,20 @@
 ﻿#include "GuiManager.h"
 #include "../Utils/Logger.h"
 #include "../ChessCore/Fen.h"
+#include "../ChessCore/Notation.h"
+#include "../Utils/Trace.h"
+
+namespace
+{
+    const char* k_enginePath = "../extern/stockfish/stockfish-windows-x86-64-avx2.exe";
+}
 
 GuiManager::GuiManager() {}
 
 GuiManager::~GuiManager() {
+    // 탐색 작업이 엔진 파이프를 쓰는 중일 수 있으므로 먼저 끝나기를 기다린 뒤 종료
+    if (m_aiFuture.valid())
+        m_aiFuture.wait();
     m_engine.Shutdown();
 }
 
@@ -16,15 +26,16 @@ void GuiManager::Initialize(HWND hWnd)
     GetClientRect(m_hWnd, &rc);
     OnSize(rc.right - rc.left, rc.bottom - rc.top);
 
-    m_board.ResetToStartPosition();
+    m_tree.Reset();
     m_renderer.Initialize();
 
-    if (!m_engine.Initialize(L"../extern/stockfish/stockfish-windows-x86-64-avx2.exe")) {
-        Log(L"Stockfish 초기화 실패");
-    }
+    // [변경] 엔진은 여기서 띄우지 않음 (WM_CREATE 안에서 핸드셰이크를 기다리면 첫 화면이 늦어짐)
+    // 사람이 첫 기물을 집을 때 미리, 늦어도 첫 AI 차례에 백그라운드로 시작 -> EnsureEngineStarted
 
     InitGame();
-    SetTimer(m_hWnd, TIMER_ANIM, 16, nullptr);
+    Redraw();
+    // [변경] 상시 16ms 타이머 대신, 애니메이션/드래그/엔진 탐색 중일 때만 FrameScheduler가 타이머를 예약
+    ScheduleNextFrame();
 }
 
 void GuiManager::InitGame()
@@ -36,6 +47,9 @@ void GuiManager::InitGame()
     m_anim.active = false;
     m_isAIThinking = false;
     m_isPromoting = false;
+    m_moveCache.Invalidate();
+    PrepareLegalMoves();
+    SetActivity(FrameScheduler::Activity_Animation | FrameScheduler::Activity_Drag | FrameScheduler::Activity_Engine, false);
 }
 
 void GuiManager::OnSize(int width, int height)
@@ -43,64 +57,117 @@ void GuiManager::OnSize(int width, int height)
     int minDim = (width < height) ? width : height;
     m_tileSize = (int)((minDim * 0.9) / 8.0);
     if (m_tileSize < 10) m_tileSize = 10;
+    m_renderer.OnSize(width, height, m_tileSize);
     Redraw();
 }
 
+// [변경] 씬을 오프스크린 프레임버퍼에 바로 합성하고, 바뀐 영역만 무효화
 void GuiManager::Redraw()
 {
-    InvalidateRect(m_hWnd, nullptr, FALSE);
+    TRACE_SCOPE("Redraw", "gui");
+    BoardScene scene;
+    scene.board = &m_tree.CurrentBoard();
+    scene.selX = m_selX; scene.selY = m_selY; scene.hasSelection = m_pieceSelected;
+    scene.hints = m_moveHints;
+    scene.anim = m_anim;
+    scene.dragging = m_dragging;
+    scene.dragScreenX = m_dragScreenX; scene.dragScreenY = m_dragScreenY;
+    scene.dragPiece = m_dragPiece;
+    // [추가] 공격 비트맵이 보드에 유지되므로 탐색 없이 비트 연산만으로 계산
+    if (m_showThreats)
+        scene.threatMask = m_gameLogic.HangingPieces(m_tree.CurrentBoard(), true) | m_gameLogic.HangingPieces(m_tree.CurrentBoard(), false);
+    if (m_showPawns) {
+        const PawnStructure& pawns = m_pawnTable.Probe(m_tree.CurrentBoard());
+        scene.passedPawnMask = pawns.Passed(true) | pawns.Passed(false);
+        scene.weakPawnMask = pawns.Weak(true) | pawns.Weak(false);
+    }
+
+    const std::vector<cv::Rect>& dirty = m_renderer.Compose(scene);
+
+    // 승급 메뉴가 나타나거나 사라질 때는 전체를 다시 그림
+    if (m_isPromoting != m_promotionMenuShown) {
+        m_promotionMenuShown = m_isPromoting;
+        InvalidateRect(m_hWnd, nullptr, FALSE);
+        return;
+    }
+    for (const auto& r : dirty) {
+        RECT rc{ r.x, r.y, r.x + r.width, r.y + r.height };
+        InvalidateRect(m_hWnd, &rc, FALSE);
+    }
 }
 
 void GuiManager::UndoMove()
 {
     if (m_isAIThinking || m_isPromoting) return;
 
-    if (m_board.PopState()) {
-        m_isWhiteTurn = !m_isWhiteTurn;
-        m_pieceSelected = false;
-        m_moveHints.clear();
-
-        if (m_blackIsAI && m_isWhiteTurn == false) {
-            if (m_board.PopState()) m_isWhiteTurn = !m_isWhiteTurn;
-        }
-        Redraw();
+    // [변경] 트리에서 한 수 뒤로 (둔 수는 지우지 않음 -> RedoMove로 다시 갈 수 있음)
+    if (m_tree.Back()) {
+        if (m_blackIsAI && m_tree.IsWhiteTurn() == false) m_tree.Back();
+        OnPositionChanged();
     }
 }
 
-void GuiManager::OnKeyDown(UINT nChar)
+void GuiManager::RedoMove()
 {
-    if (nChar == VK_BACK) UndoMove();
+    if (m_isAIThinking || m_isPromoting) return;
+
+    if (m_tree.Forward()) {
+        if (m_blackIsAI && m_tree.IsWhiteTurn() == false) m_tree.Forward();
+        OnPositionChanged();
+        // [추가] 응수가 없는 노드(메이트 수, 엔진 실패 뒤 등)에서 멈추면 사람이 둔 수와 같이 처리
+        if (!CheckAndHandleGameOver() && !m_isWhiteTurn && m_blackIsAI) RequestAIMove();
+    }
 }
 
-void GuiManager::OnPaint(HDC hdc)
+// 트리에서 다른 노드로 옮긴 뒤 화면 / 합법수 상태를 맞춤
+void GuiManager::OnPositionChanged()
 {
-    RECT rc;
-    GetClientRect(m_hWnd, &rc);
-    int width = rc.right - rc.left;
-    int height = rc.bottom - rc.top;
+    m_isWhiteTurn = m_tree.IsWhiteTurn();
+    m_pieceSelected = false;
+    m_moveHints.clear();
+    // [추가] 되돌린 국면의 합법수를 다시 준비
+    m_moveCache.Invalidate();
+    PrepareLegalMoves();
+    Redraw();
+}
 
-    HDC memDC = CreateCompatibleDC(hdc);
-    HBITMAP memBmp = CreateCompatibleBitmap(hdc, width, height);
-    HGDIOBJ oldBmp = SelectObject(memDC, memBmp);
+void GuiManager::OnKeyDown(UINT nChar)
+{
+    if (nChar == VK_BACK || nChar == VK_LEFT) UndoMove();
+    else if (nChar == VK_RIGHT) RedoMove();
+    // [추가] F9: 타임라인 기록 시작 / 종료 (종료 시 Chrome trace JSON 저장)
+    else if (nChar == VK_F9) ToggleTrace();
+    // [추가] T: 위협(걸린 기물) 오버레이 켜기 / 끄기
+    else if (nChar == 'T') { m_showThreats = !m_showThreats; Redraw(); }
+    // [추가] P: 폰 구조 오버레이 켜기 / 끄기
+    else if (nChar == 'P') { m_showPawns = !m_showPawns; Redraw(); }
+}
 
-    HBRUSH bg = CreateSolidBrush(RGB(40, 30, 20));
-    FillRect(memDC, &rc, bg);
-    DeleteObject(bg);
+void GuiManager::ToggleTrace()
+{
+    if (!Trace::IsEnabled()) {
+        Trace::Enable();
+        LOG_INFO("trace started");
+        return;
+    }
+    Trace::Disable();
+    const char* path = "ChessProject.trace.json";
+    if (Trace::DumpChromeJson(path))
+        LOG_INFO("trace saved: %s (%zu events, %zu dropped)", path, Trace::EventCount(), Trace::DroppedCount());
+    else
+        LOG_ERROR("trace save failed: %s", path);
+}
 
-    m_renderer.DrawBoard(memDC, m_board, m_tileSize,
-        m_selX, m_selY, m_pieceSelected,
-        m_moveHints, m_anim, m_dragging,
-        m_dragScreenX, m_dragScreenY, m_dragPiece);
+// [변경] 합성은 Redraw()에서 끝났으므로 무효화된 영역(rcPaint)만 프레임버퍼에서 복사
+void GuiManager::OnPaint(HDC hdc, const RECT& rcPaint)
+{
+    TRACE_SCOPE("OnPaint", "gui");
+    m_renderer.Present(hdc, rcPaint);
 
-    // [승급 메뉴 그리기]
+    // [승급 메뉴 그리기] (GDI로 프레임버퍼 위에 직접)
     if (m_isPromoting) {
-        DrawPromotionMenu(memDC);
+        DrawPromotionMenu(hdc);
     }
-
-    BitBlt(hdc, 0, 0, width, height, memDC, 0, 0, SRCCOPY);
-    SelectObject(memDC, oldBmp);
-    DeleteObject(memBmp);
-    DeleteDC(memDC);
 }
 
 void GuiManager::DrawPromotionMenu(HDC hdc)
@@ -186,12 +253,9 @@ void GuiManager::HandlePromotionClick(int x, int y)
     PieceType types[] = { PieceType::Queen, PieceType::Rook, PieceType::Bishop, PieceType::Knight };
     m_pendingPromotionMove.promotion = types[idx];
 
-    // 승급 확정 및 이동 적용
+    // 승급 확정 및 이동 적용 (메뉴를 띄우기 전에 이미 합법수 표에서 확인함)
     m_isPromoting = false;
-    m_board.PushState(m_isWhiteTurn);
-
-    Piece moving = m_board.GetPiece(m_pendingPromotionMove.sx, m_pendingPromotionMove.sy);
-    m_gameLogic.ApplyMove(m_board, m_pendingPromotionMove, m_isWhiteTurn);
+    m_tree.Play(m_pendingPromotionMove);
 
     // 애니메이션은 이미 끝난 상태라고 가정하거나 여기서 다시 시작 (보통은 바로 변함)
     // 드래그 드롭의 경우 애니메이션이 필요 없을 수 있음.
@@ -199,9 +263,10 @@ void GuiManager::HandlePromotionClick(int x, int y)
     m_pieceSelected = false;
     m_moveHints.clear();
     m_isWhiteTurn = !m_isWhiteTurn;
+    PrepareLegalMoves();
     Redraw();
 
-    CheckAndHandleGameOver(); // 게임 종료 확인
+    if (CheckAndHandleGameOver()) return; // 메이트/스테일메이트면 엔진에 묻지 않음
     if (!m_isWhiteTurn && m_blackIsAI) RequestAIMove();
 }
 
@@ -215,6 +280,7 @@ void GuiManager::OnLButtonUp(int x, int y)
     int boardY = (y - offset) / m_tileSize;
 
     m_dragging = false;
+    SetActivity(FrameScheduler::Activity_Drag, false);
 
     if (boardX < 0 || boardX >= 8 || boardY < 0 || boardY >= 8) {
         m_pieceSelected = false; m_moveHints.clear(); Redraw(); return;
@@ -223,33 +289,33 @@ void GuiManager::OnLButtonUp(int x, int y)
     Move mv;
     mv.sx = m_selX; mv.sy = m_selY; mv.dx = boardX; mv.dy = boardY;
 
-    // 승급 여부 확인 (폰이 끝에 도달)
-    Piece p = m_board.GetPiece(m_selX, m_selY);
-    if (p.type == PieceType::Pawn && p.color == PieceColor::White && boardY == 0) { // 백 폰 승급
-        // 유효한 이동인지 먼저 확인 (기본 로직상)
-        Board temp = m_board;
-        if (m_gameLogic.ApplyMove(temp, mv, m_isWhiteTurn)) {
-            m_isPromoting = true;
-            m_pendingPromotionMove = mv;
-            Redraw(); // 메뉴 표시
-            return;
-        }
+    if (!TryPlayerMove(mv, m_dragPiece)) {
+        m_pieceSelected = false; m_moveHints.clear(); Redraw();
     }
+}
 
-    Board temp = m_board;
-    if (m_gameLogic.ApplyMove(temp, mv, m_isWhiteTurn)) {
-        m_board.PushState(m_isWhiteTurn);
-        m_gameLogic.ApplyMove(m_board, mv, m_isWhiteTurn);
-        StartAnimation(mv.sx, mv.sy, mv.dx, mv.dy, m_dragPiece);
-        m_pieceSelected = false; m_moveHints.clear(); m_isWhiteTurn = !m_isWhiteTurn;
-        Redraw();
-
-        CheckAndHandleGameOver();
-        if (!m_isWhiteTurn && m_blackIsAI) RequestAIMove();
-    }
-    else {
-        m_pieceSelected = false; m_moveHints.clear(); Redraw();
+// [변경] 임시 보드에 두 번 두어 보던 검증을 합법수 표 조회로 대체
+bool GuiManager::TryPlayerMove(const Move& mv, const Piece& moving)
+{
+    const LegalMoveSet& legal = m_moveCache.Get(m_tree.CurrentBoard(), m_isWhiteTurn);
+    if (!legal.IsLegal(mv.sx, mv.sy, mv.dx, mv.dy)) return false;
+
+    // 승급 여부 확인 (폰이 끝에 도달) -> 기물 선택 메뉴
+    if (legal.IsPromotion(mv.sx, mv.sy, mv.dx, mv.dy)) {
+        m_isPromoting = true;
+        m_pendingPromotionMove = mv;
+        Redraw(); // 메뉴 표시
+        return true;
     }
+
+    m_tree.Play(mv);
+    StartAnimation(mv.sx, mv.sy, mv.dx, mv.dy, moving);
+    m_pieceSelected = false; m_moveHints.clear(); m_isWhiteTurn = !m_isWhiteTurn;
+    PrepareLegalMoves();
+    Redraw();
+
+    if (!CheckAndHandleGameOver() && !m_isWhiteTurn && m_blackIsAI) RequestAIMove();
+    return true;
 }
 
 void GuiManager::OnMouseMove(int x, int y, bool leftDown)
@@ -259,7 +325,8 @@ void GuiManager::OnMouseMove(int x, int y, bool leftDown)
     if (m_pieceSelected && leftDown && !m_dragging) {
         m_dragging = true; m_dragX = m_selX; m_dragY = m_selY;
         m_dragScreenX = x; m_dragScreenY = y;
-        m_dragPiece = m_board.GetPiece(m_dragX, m_dragY);
+        m_dragPiece = m_tree.CurrentBoard().GetPiece(m_dragX, m_dragY);
+        SetActivity(FrameScheduler::Activity_Drag, true);
         Redraw(); return;
     }
     if (m_dragging) {
@@ -270,9 +337,51 @@ void GuiManager::OnMouseMove(int x, int y, bool leftDown)
 void GuiManager::OnTimer(UINT id)
 {
     if (id == TIMER_ANIM) {
-        UpdateAnimation();
-        CheckAIState();
+        if (m_scheduler.BeginTick()) {
+            UpdateAnimation();
+            CheckAIState();
+        }
+        ScheduleNextFrame();
+    }
+}
+
+// 엔진 스레드가 탐색을 마치면 WM_ENGINE_DONE으로 깨움 (폴링 없이 바로 처리)
+void GuiManager::OnEngineDone()
+{
+    // PostMessage 직후 람다가 반환되므로 future는 곧바로 준비됨
+    if (m_isAIThinking && m_aiFuture.valid()) m_aiFuture.wait();
+    m_scheduler.Wake();
+    CheckAIState();
+    ScheduleNextFrame();
+}
+
+void GuiManager::SetActivity(uint32_t activity, bool active)
+{
+    m_scheduler.SetActive(activity, active);
+    ScheduleNextFrame();
+}
+
+// 다음 틱 시각에 맞춰 타이머를 다시 걸거나, 할 일이 없으면 타이머를 끔
+void GuiManager::ScheduleNextFrame()
+{
+    if (!m_hWnd) return;
+
+    int64_t waitUs = m_scheduler.TimeUntilNextTick();
+    if (waitUs < 0) {
+        KillTimer(m_hWnd, TIMER_ANIM);
+        return;
     }
+    UINT waitMs = (UINT)((waitUs + 999) / 1000);
+    SetTimer(m_hWnd, TIMER_ANIM, (waitMs > 0) ? waitMs : 1, nullptr);
+}
+
+// [추가] 엔진 프로세스를 백그라운드로 시작 (이미 시작했거나 시작 중이면 아무것도 안 함)
+// retryFailed: 앞서 실패했어도 다시 시도 (AI 차례에만. 클릭마다 다시 띄우지 않도록)
+void GuiManager::EnsureEngineStarted(bool retryFailed)
+{
+    StockfishEngine::State state = m_engine.GetState();
+    if (state == StockfishEngine::State::Stopped || (retryFailed && state == StockfishEngine::State::Failed))
+        m_engine.StartAsync(k_enginePath);
 }
 
 void GuiManager::HandlePlayerClick(int boardX, int boardY, bool withShift)
@@ -280,8 +389,10 @@ void GuiManager::HandlePlayerClick(int boardX, int boardY, bool withShift)
     if (!m_isWhiteTurn || !m_whiteIsHuman) return;
 
     if (!m_pieceSelected) {
-        const Piece& p = m_board.GetPiece(boardX, boardY);
+        const Piece& p = m_tree.CurrentBoard().GetPiece(boardX, boardY);
         if (p.type != PieceType::None && p.color == PieceColor::White) {
+            // 사람이 수를 고르는 동안 엔진 핸드셰이크를 끝내 둠
+            if (m_blackIsAI) EnsureEngineStarted(false);
             m_pieceSelected = true; m_selX = boardX; m_selY = boardY;
             UpdateMoveHints(boardX, boardY);
             Redraw();
@@ -294,32 +405,10 @@ void GuiManager::HandlePlayerClick(int boardX, int boardY, bool withShift)
 
         Move mv{ m_selX, m_selY, boardX, boardY };
 
-        // 승급 체크 (클릭 이동 시)
-        Piece p = m_board.GetPiece(m_selX, m_selY);
-        if (p.type == PieceType::Pawn && p.color == PieceColor::White && boardY == 0) {
-            Board temp = m_board;
-            if (m_gameLogic.ApplyMove(temp, mv, m_isWhiteTurn)) {
-                m_isPromoting = true;
-                m_pendingPromotionMove = mv;
-                Redraw();
-                return;
-            }
-        }
-
-        Board temp = m_board;
-        if (m_gameLogic.ApplyMove(temp, mv, m_isWhiteTurn)) {
-            m_board.PushState(m_isWhiteTurn);
-            Piece moving = m_board.GetPiece(m_selX, m_selY);
-            m_gameLogic.ApplyMove(m_board, mv, m_isWhiteTurn);
-            StartAnimation(mv.sx, mv.sy, mv.dx, mv.dy, moving);
-            m_pieceSelected = false; m_moveHints.clear(); m_isWhiteTurn = !m_isWhiteTurn;
-            Redraw();
-
-            CheckAndHandleGameOver();
-            if (!m_isWhiteTurn && m_blackIsAI) RequestAIMove();
-        }
-        else {
-            const Piece& target = m_board.GetPiece(boardX, boardY);
+        // 승급 체크 포함 (클릭 이동 시)
+        Piece moving = m_tree.CurrentBoard().GetPiece(m_selX, m_selY);
+        if (!TryPlayerMove(mv, moving)) {
+            const Piece& target = m_tree.CurrentBoard().GetPiece(boardX, boardY);
             if (target.color == PieceColor::White) {
                 m_pieceSelected = true; m_selX = boardX; m_selY = boardY;
                 UpdateMoveHints(boardX, boardY); Redraw();
@@ -333,51 +422,55 @@ void GuiManager::HandlePlayerClick(int boardX, int boardY, bool withShift)
 
 void GuiManager::RequestAIMove()
 {
+    TRACE_SCOPE("RequestAIMove", "gui");
     if (m_isAIThinking) return;
     // CheckAndHandleGameOver에서 이미 게임 끝났으면 호출 안됨
 
-    std::string fen = Fen::BoardToFEN(m_board, m_isWhiteTurn);
+    EnsureEngineStarted(true);
+    std::string fen = Fen::BoardToFEN(m_tree.CurrentBoard(), m_isWhiteTurn);
     m_isAIThinking = true;
-    m_aiFuture = std::async(std::launch::async, [this, fen]() {
-        return m_engine.GetBestMove(fen);
+    SetActivity(FrameScheduler::Activity_Engine, true);
+    HWND hWnd = m_hWnd;
+    m_aiFuture = std::async(std::launch::async, [this, fen, hWnd]() {
+        // 아직 시작 중이면 여기서(UI 스레드 밖) 핸드셰이크를 기다림
+        if (!m_engine.WaitUntilReady()) {
+            PostMessageW(hWnd, WM_ENGINE_DONE, 0, 0);
+            return std::string();
+        }
+        auto t0 = std::chrono::steady_clock::now();
+        std::string bestMove = m_engine.GetBestMove(fen);
+        long long ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t0).count();
+        LOG_INFO("engine move %s in %lld ms (%s)", bestMove.c_str(), ms, fen.c_str());
+        PostMessageW(hWnd, WM_ENGINE_DONE, 0, 0);
+        return bestMove;
         });
 }
 
 void GuiManager::CheckAIState()
 {
+    TRACE_SCOPE("CheckAIState", "gui");
     if (!m_isAIThinking) return;
 
     if (m_aiFuture.valid() && m_aiFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
     {
         std::string bestMove = m_aiFuture.get();
         m_isAIThinking = false;
+        SetActivity(FrameScheduler::Activity_Engine, false);
 
-        if (bestMove.size() >= 4)
-        {
-            Move mv{};
-            mv.sx = bestMove[0] - 'a';
-            mv.sy = 8 - (bestMove[1] - '0');
-            mv.dx = bestMove[2] - 'a';
-            mv.dy = 8 - (bestMove[3] - '0');
-
-            // [승급 파싱] e.g. a7a8q
-            if (bestMove.size() >= 5) {
-                char promoChar = bestMove[4];
-                switch (promoChar) {
-                case 'q': mv.promotion = PieceType::Queen; break;
-                case 'r': mv.promotion = PieceType::Rook; break;
-                case 'b': mv.promotion = PieceType::Bishop; break;
-                case 'n': mv.promotion = PieceType::Knight; break;
-                default: mv.promotion = PieceType::Queen; break;
-                }
-            }
+        if (bestMove.empty() && m_engine.GetState() == StockfishEngine::State::Failed) {
+            MessageBoxW(m_hWnd, L"Chess engine is not available.", L"Engine", MB_OK | MB_ICONWARNING);
+            return;
+        }
 
-            m_board.PushState(m_isWhiteTurn);
-            Piece moving = m_board.GetPiece(mv.sx, mv.sy);
-            if (m_gameLogic.ApplyMove(m_board, mv, m_isWhiteTurn))
+        Move mv{};
+        if (Notation::MoveFromUCI(bestMove, mv))
+        {
+            Piece moving = m_tree.CurrentBoard().GetPiece(mv.sx, mv.sy);
+            if (m_tree.Play(mv) != GameTree::k_none)
             {
                 StartAnimation(mv.sx, mv.sy, mv.dx, mv.dy, moving);
                 m_isWhiteTurn = !m_isWhiteTurn;
+                PrepareLegalMoves();
                 Redraw();
                 CheckAndHandleGameOver();
             }
@@ -385,9 +478,9 @@ void GuiManager::CheckAIState()
     }
 }
 
-void GuiManager::CheckAndHandleGameOver()
+bool GuiManager::CheckAndHandleGameOver()
 {
-    GameState state = m_gameLogic.CheckGameState(m_board, m_isWhiteTurn);
+    GameState state = m_gameLogic.CheckGameState(m_tree.CurrentBoard(), m_isWhiteTurn);
     if (state == GameState::Checkmate) {
         std::wstring msg = m_isWhiteTurn ? L"Checkmate! Black Wins!" : L"Checkmate! White Wins!";
         MessageBoxW(m_hWnd, msg.c_str(), L"Game Over", MB_OK | MB_ICONINFORMATION);
@@ -396,25 +489,33 @@ void GuiManager::CheckAndHandleGameOver()
     else if (state == GameState::Stalemate) {
         MessageBoxW(m_hWnd, L"Stalemate! Draw!", L"Game Over", MB_OK | MB_ICONINFORMATION);
     }
+    return state != GameState::Playing;
 }
 
+// [변경] 선택할 때마다 의사 합법수를 만들어 시험해 보던 방식 -> 미리 계산된 도착 칸 비트 조회
+// [추가] 도착 칸마다 SEE로 교환 득실을 매겨 힌트 색을 나눔 (엔진 호출 없이 칸당 수십 ns)
 void GuiManager::UpdateMoveHints(int x, int y)
 {
     m_moveHints.clear();
-    std::vector<Move> moves;
-    m_gameLogic.GeneratePseudoLegalMoves(m_board, x, y, m_isWhiteTurn, moves);
-    for (const auto& mv : moves) {
-        // 힌트 표시할 때, 실제로 둬봐서 체크가 안되는지 확인해야 완벽함
-        // GeneratePseudoLegalMoves는 체크를 고려하지 않은 의사 합법수
-        // 여기서 체크 필터링
-        Board temp = m_board;
-        if (m_gameLogic.ApplyMove(temp, mv, m_isWhiteTurn)) {
-            MoveHint h; h.x = mv.dx; h.y = mv.dy;
-            m_moveHints.push_back(h);
-        }
+    const Board& board = m_tree.CurrentBoard();
+    uint64_t targets = m_moveCache.Get(board, m_isWhiteTurn).targets[y * 8 + x];
+    for (int sq = 0; sq < 64; ++sq) {
+        if (!((targets >> sq) & 1)) continue;
+        MoveHint h; h.x = sq % 8; h.y = sq / 8;
+        Move mv;
+        mv.sx = x; mv.sy = y; mv.dx = h.x; mv.dy = h.y;
+        int see = m_gameLogic.See(board, mv);
+        h.exchange = (see > 0) ? 1 : (see < 0 ? -1 : 0);
+        m_moveHints.push_back(h);
     }
 }
 
+// 사람 차례가 되면 그 국면의 합법수를 미리 계산 (첫 클릭 전에 표가 준비됨)
+void GuiManager::PrepareLegalMoves()
+{
+    if (m_isWhiteTurn && m_whiteIsHuman) m_moveCache.Prepare(m_tree.CurrentBoard(), m_isWhiteTurn);
+}
+
 void GuiManager::StartAnimation(int sx, int sy, int dx, int dy, const Piece& p)
 {
     m_anim.active = true;
@@ -422,6 +523,7 @@ void GuiManager::StartAnimation(int sx, int sy, int dx, int dy, const Piece& p)
     m_anim.progress = 0.0;
     m_anim.startTick = GetTickCount64();
     m_anim.movingPiece = p;
+    SetActivity(FrameScheduler::Activity_Animation, true);
 }
 
 void GuiManager::UpdateAnimation()
@@ -431,6 +533,9 @@ void GuiManager::UpdateAnimation()
     ULONGLONG elapsed = now - m_anim.startTick;
     const double duration = 200.0;
     m_anim.progress = (double)elapsed / duration;
-    if (m_anim.progress >= 1.0) { m_anim.progress = 1.0; m_anim.active = false; }
+    if (m_anim.progress >= 1.0) {
+        m_anim.progress = 1.0; m_anim.active = false;
+        SetActivity(FrameScheduler::Activity_Animation, false);
+    }
     Redraw();
 }
\ No newline at end of file
@@ -5,10 +5,15 @@
 #include <future>
 #include "../ChessCore/Board.h"
 #include "../ChessCore/GameLogic.h"
+#include "../ChessCore/GameTree.h"
+#include "../ChessCore/LegalMoveCache.h"
+#include "../ChessCore/PawnStructure.h"
 #include "../Engine/Stockfish.h"
+#include "../Utils/FrameScheduler.h"
 #include "Renderer.h"
 
 #define TIMER_ANIM 1
+#define WM_ENGINE_DONE (WM_APP + 1) // 엔진 스레드 -> UI 스레드: 탐색 완료
 
 class GuiManager
 {
@@ -23,18 +28,23 @@ public:
     void OnLButtonDown(int x, int y, bool withShift);
     void OnLButtonUp(int x, int y);
     void OnMouseMove(int x, int y, bool leftDown);
-    void OnPaint(HDC hdc);
+    void OnPaint(HDC hdc, const RECT& rcPaint);
     void OnTimer(UINT id);
     void OnSize(int width, int height);
     void OnKeyDown(UINT nChar);
+    void OnEngineDone();
     void UndoMove();
+    void RedoMove(); // [추가] 무른 수를 본선 따라 다시 두기
 
 private:
     HWND        m_hWnd = nullptr;
     Renderer    m_renderer;
     GameLogic   m_gameLogic;
-    Board       m_board;
+    GameTree    m_tree;     // [변경] Board 히스토리 스택 대신 변화수 트리 (무르기 후 다른 수를 두면 변화수로 남음)
+    LegalMoveCache m_moveCache; // [추가] 현재 국면 합법수 (선택/힌트/드롭 검증/승급 판정)
+    PawnTable   m_pawnTable{ 8 }; // [추가] 폰 구조 캐시 (기보를 오가도 폰 배치가 같으면 재분석 안 함)
     StockfishEngine m_engine;
+    FrameScheduler m_scheduler;
 
     int m_tileSize = 80;
     bool m_pieceSelected = false;
@@ -46,6 +56,8 @@ private:
     int  m_dragScreenX = 0;
     int  m_dragScreenY = 0;
     Piece m_dragPiece;
+    bool m_showThreats = false; // [추가] T: 걸린 기물(hanging) 표시
+    bool m_showPawns = false;   // [추가] P: 통과한 폰 / 약한 폰 표시
 
     bool m_isWhiteTurn = true;
     bool m_whiteIsHuman = true;
@@ -59,6 +71,7 @@ private:
 
     // [추가] 승급 선택 UI 관련
     bool m_isPromoting = false; // 승급 선택 중인가?
+    bool m_promotionMenuShown = false; // 마지막으로 무효화할 때의 승급 메뉴 표시 여부
     Move m_pendingPromotionMove; // 승급 대기 중인 이동 정보
 
 private:
@@ -66,13 +79,24 @@ private:
     void StartAnimation(int sx, int sy, int dx, int dy, const Piece& p);
     void UpdateAnimation();
     void UpdateMoveHints(int selX, int selY);
+    void PrepareLegalMoves();
+    void OnPositionChanged();
+    // [추가] 사람이 고른 수를 캐시로 검증 후 적용 (승급이면 메뉴를 띄우고 true)
+    bool TryPlayerMove(const Move& mv, const Piece& moving);
 
     void CheckAIState();
     void RequestAIMove();
+    void EnsureEngineStarted(bool retryFailed);
 
-    // [추가] 게임 상태 확인 및 종료 처리
-    void CheckAndHandleGameOver();
+    // [추가] 프레임 스케줄링 (활성 상태가 바뀔 때마다 타이머 재예약)
+    void SetActivity(uint32_t activity, bool active);
+    void ScheduleNextFrame();
+
+    // [추가] 게임 상태 확인 및 종료 처리 (끝났으면 true)
+    bool CheckAndHandleGameOver();
     // [추가] 승급 UI 그리기 및 입력 처리
     void DrawPromotionMenu(HDC hdc);
     void HandlePromotionClick(int x, int y);
+    // [추가] 타임라인 기록 토글 (F9)
+    void ToggleTrace();
 };
\ No newline at end of file
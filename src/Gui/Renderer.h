@@ -1,33 +1,17 @@
 ﻿#pragma once
 #include <windows.h>
-#include <map>
 #include <string>
 #include <vector>
 #include <opencv2/core.hpp>
 #include "../ChessCore/Board.h"
 #include "../ChessCore/GameLogic.h"
 #include "../ChessCore/Piece.h"
+#include "../Render/BoardCompositor.h"
+#include "../Render/BoardScene.h"
+#include "../Render/SpriteSet.h"
 
-// GuiManager_fwd.h 대체
-struct MoveHint
-{
-    int x;
-    int y;
-};
-
-struct MoveAnim
-{
-    bool active = false;
-    bool isAnimating = false;
-    int fromX = 0;
-    int fromY = 0;
-    int toX = 0;
-    int toY = 0;
-    double progress = 0.0;
-    ULONGLONG startTick = 0; // [변경] DWORD -> ULONGLONG
-    Piece movingPiece;
-};
-
+// [변경] 보드 그리기는 플랫폼 독립 BoardCompositor가 담당하고,
+// Renderer는 에셋 로드 + 프레임버퍼를 HDC로 내보내는(Win32) 역할만 함
 class Renderer
 {
 public:
@@ -35,40 +19,24 @@ public:
     ~Renderer();
 
     void Initialize();
-    // (x, y 인자 제거됨)
-    void DrawBoard(HDC hdc,
-        const Board& board,
-        int tileSize,
-        int selX, int selY, bool hasSelection,
-        const std::vector<MoveHint>& hints,
-        const MoveAnim& anim,
-        bool dragging,
-        int dragScreenX, int dragScreenY,
-        const Piece& dragPiece);
+    // 클라이언트 크기 / 타일 크기 변경 시 프레임버퍼와 스프라이트 캐시 재생성
+    void OnSize(int width, int height, int tileSize);
+
+    // 씬을 오프스크린 프레임버퍼에 합성하고, 화면에 다시 복사해야 할 영역을 반환
+    const std::vector<cv::Rect>& Compose(const BoardScene& scene);
+    // 프레임버퍼의 rc 영역을 hdc의 같은 위치로 복사
+    void Present(HDC hdc, const RECT& rc);
 
 private:
-    std::map<std::wstring, cv::Mat> m_pieceImages;
+    SpriteSet m_sprites;
+    BoardCompositor m_compositor;
     cv::Mat m_boardImage;
 
     void LoadPieceImages();
+    bool AttachEmbeddedAtlas(); // [추가] 실행 파일에 넣은 PieceAtlas 리소스
     void LoadBoardImage();
-    void DrawWoodenTiles(HDC hdc, int tileSize);
 
     void DrawBoardTexture(HDC hdc,
         int tileSize,
         int offsetX, int offsetY);
-    void DrawPieces(HDC hdc,
-        const Board& board,
-        int tileSize,
-        const MoveAnim& anim,
-        bool dragging,
-        int dragScreenX, int dragScreenY,
-        const Piece& dragPiece);
-    void DrawSelectionAndHints(HDC hdc,
-        int tileSize,
-        int selX, int selY, bool hasSelection,
-        const std::vector<MoveHint>& hints);
-
-    HBITMAP MatToHBITMAP(const cv::Mat& src);
-    void DrawMat(HDC hdc, int x, int y, const cv::Mat& mat, int width, int height);
 };
\ No newline at end of file
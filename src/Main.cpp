@@ -1,6 +1,7 @@
 ﻿#include <windowsx.h>
 #include <windows.h>
 #include "Gui/GuiManager.h"
+#include "Utils/Logger.h"
 
 #pragma comment(lib, "user32.lib")
 #pragma comment(lib, "gdi32.lib")
@@ -55,11 +56,15 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
         g_GuiManager.OnTimer((UINT)wParam);
         return 0;
 
+    case WM_ENGINE_DONE:
+        g_GuiManager.OnEngineDone();
+        return 0;
+
     case WM_PAINT:
     {
         PAINTSTRUCT ps;
         HDC hdc = BeginPaint(hWnd, &ps);
-        g_GuiManager.OnPaint(hdc);
+        g_GuiManager.OnPaint(hdc, ps.rcPaint);
         EndPaint(hWnd, &ps);
         return 0;
     }
@@ -78,6 +83,12 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
     _In_ LPWSTR    lpCmdLine,
     _In_ int       nCmdShow)
 {
+    // [추가] 비동기 로거 시작 (UI / 엔진 스레드는 버퍼에 넣기만 하고, 파일 기록은 백그라운드 스레드)
+    Logger::Options logOptions;
+    logOptions.filePath = "ChessProject.log";
+    logOptions.toStderr = false;
+    Logger::Start(logOptions);
+
     const wchar_t CLASS_NAME[] = L"ChessWindowClass";
 
     WNDCLASSEXW wc{};
@@ -118,5 +129,6 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
         DispatchMessageW(&msg);
     }
 
+    Logger::Shutdown();
     return (int)msg.wParam;
 }
\ No newline at end of file
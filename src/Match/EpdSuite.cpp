@@ -0,0 +1,283 @@
+﻿#include "EpdSuite.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/GameLogic.h"
+#include "../ChessCore/Notation.h"
+#include "../Engine/Stockfish.h"
+#include "../Utils/Trace.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double MsSince(Clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+    }
+
+    bool IsNumber(const std::string& s)
+    {
+        return !s.empty() && s.find_first_not_of("0123456789") == std::string::npos;
+    }
+
+    // "bm Nf3 Qd2; id \"WAC.001\";" -> 연산 단위로 자름 (따옴표 안의 ';'는 유지)
+    std::vector<std::string> SplitOperations(const std::string& rest)
+    {
+        std::vector<std::string> ops;
+        std::string cur;
+        bool quoted = false;
+        for (char c : rest) {
+            if (c == '"') quoted = !quoted;
+            if (c == ';' && !quoted) { ops.push_back(cur); cur.clear(); }
+            else cur += c;
+        }
+        if (cur.find_first_not_of(" \t") != std::string::npos) ops.push_back(cur);
+        return ops;
+    }
+
+    // 공백으로 나누되 따옴표로 감싼 피연산자는 하나로 (따옴표 제거)
+    std::vector<std::string> SplitOperands(const std::string& op)
+    {
+        std::vector<std::string> tokens;
+        std::string cur;
+        bool quoted = false, any = false;
+        for (char c : op) {
+            if (c == '"') { quoted = !quoted; any = true; continue; }
+            if ((c == ' ' || c == '\t') && !quoted) {
+                if (any) tokens.push_back(cur);
+                cur.clear(); any = false;
+                continue;
+            }
+            cur += c; any = true;
+        }
+        if (any) tokens.push_back(cur);
+        return tokens;
+    }
+
+    double Percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty()) return 0.0;
+        // nearest-rank
+        size_t rank = (size_t)std::ceil(p * sorted.size());
+        return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    EpdResult SearchPosition(StockfishEngine& engine, const EpdPosition& pos, int index, int stableIterations)
+    {
+        TRACE_SCOPE("EpdSuite::SearchPosition", "match");
+        EpdResult r;
+        r.index = index;
+        r.id = pos.id;
+
+        // 정답 수가 PV 첫 수로 유지된 연속 깊이 수 (반복 심화 한 번 = 깊이 하나)
+        int streak = 0, streakDepth = -1;
+        double streakMs = 0.0;
+        uint64_t streakNodes = 0;
+
+        Clock::time_point t0 = Clock::now();
+        std::vector<UciInfo> lines;
+        r.bestMove = engine.Analyze(pos.fen, 1, lines, [&](const UciInfo& info) {
+            if (info.nodes >= 0) r.nodes = (uint64_t)info.nodes;
+            if (info.depth > r.depth) r.depth = info.depth;
+            // lowerbound / upperbound: 탐색 창 밖 결과라 PV가 확정이 아님
+            if (info.depth < 0 || !info.HasPv() || info.multipv != 1 || info.score.lowerbound || info.score.upperbound)
+                return true;
+
+            if (!pos.Accepts(Notation::MoveToUCI(info.pv[0]))) {
+                streak = 0;
+                return true;
+            }
+            if (streak == 0) {
+                streak = 1;
+                streakDepth = info.depth;
+                streakMs = MsSince(t0);
+                streakNodes = r.nodes;
+            }
+            else if (info.depth > streakDepth) {
+                ++streak;
+                streakDepth = info.depth;
+            }
+            if (stableIterations > 0 && streak >= stableIterations) {
+                r.stoppedEarly = true;
+                return false;
+            }
+            return true;
+        });
+        r.totalMs = MsSince(t0);
+
+        r.solved = !r.bestMove.empty() && pos.Accepts(r.bestMove);
+        if (r.solved) {
+            // info 없이 bestmove만 온 경우는 전체 시간을 해결 시간으로 봄
+            r.solveMs = (streak > 0) ? streakMs : r.totalMs;
+            r.solveNodes = (streak > 0) ? streakNodes : r.nodes;
+        }
+        return r;
+    }
+}
+
+bool EpdPosition::Accepts(const std::string& uciMove) const
+{
+    if (!bestMoves.empty() && std::find(bestMoves.begin(), bestMoves.end(), uciMove) == bestMoves.end())
+        return false;
+    return std::find(avoidMoves.begin(), avoidMoves.end(), uciMove) == avoidMoves.end();
+}
+
+EpdSuiteRunner::EpdSuiteRunner(std::string enginePath, EpdSuiteOptions options)
+    : m_path(std::move(enginePath)), m_options(std::move(options))
+{
+    if (m_options.sessions < 1) m_options.sessions = 1;
+}
+
+bool EpdSuiteRunner::ParseLine(const std::string& line, EpdPosition& outPosition, std::string& outError)
+{
+    std::istringstream iss(line);
+    std::string fields[4];
+    for (auto& f : fields) {
+        if (!(iss >> f)) { outError = "too few fields"; return false; }
+    }
+    std::string rest;
+    std::getline(iss, rest);
+
+    // 6필드 FEN 뒤에 연산이 붙은 파일도 허용 (수 카운터는 그대로 사용)
+    std::string counters = " 0 1";
+    {
+        std::istringstream probe(rest);
+        std::string a, b;
+        if (probe >> a >> b && IsNumber(a) && IsNumber(b)) {
+            counters = " " + a + " " + b;
+            std::getline(probe, rest);
+        }
+    }
+
+    EpdPosition pos;
+    pos.fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3] + counters;
+    if (!Fen::FENToBoard(pos.fen, pos.board, pos.isWhiteTurn)) { outError = "invalid FEN"; return false; }
+
+    GameLogic logic;
+    for (const auto& op : SplitOperations(rest)) {
+        std::vector<std::string> tokens = SplitOperands(op);
+        if (tokens.empty()) continue;
+        const std::string& opcode = tokens[0];
+        if (opcode == "id" && tokens.size() > 1) pos.id = tokens[1];
+        if (opcode != "bm" && opcode != "am") continue;
+
+        std::vector<std::string>& target = (opcode == "bm") ? pos.bestMoves : pos.avoidMoves;
+        for (size_t i = 1; i < tokens.size(); ++i) {
+            // 표준은 SAN. 좌표 표기(e2e4)로 적힌 스위트도 있어 합법이면 받아 줌
+            Move mv{};
+            bool ok = Notation::MoveFromSAN(pos.board, tokens[i], pos.isWhiteTurn, logic, mv);
+            if (!ok && Notation::MoveFromUCI(tokens[i], mv)) {
+                std::vector<Move> legal;
+                logic.GenerateLegalMoves(pos.board, pos.isWhiteTurn, legal);
+                for (const auto& l : legal)
+                    if (l.sx == mv.sx && l.sy == mv.sy && l.dx == mv.dx && l.dy == mv.dy) ok = true;
+            }
+            if (!ok) { outError = "illegal " + opcode + " move " + tokens[i]; return false; }
+            target.push_back(Notation::MoveToUCI(mv));
+        }
+    }
+    if (pos.bestMoves.empty() && pos.avoidMoves.empty()) { outError = "no bm/am operation"; return false; }
+
+    outPosition = std::move(pos);
+    return true;
+}
+
+bool EpdSuiteRunner::LoadSuite(const std::string& path, std::vector<EpdPosition>& outPositions, std::vector<std::string>* outErrors)
+{
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        EpdPosition pos;
+        std::string error;
+        if (!ParseLine(line, pos, error)) {
+            if (outErrors) outErrors->push_back("line " + std::to_string(lineNo) + ": " + error);
+            continue;
+        }
+        if (pos.id.empty()) pos.id = "#" + std::to_string(lineNo);
+        outPositions.push_back(std::move(pos));
+    }
+    return true;
+}
+
+EpdSummary EpdSuiteRunner::Run(const std::vector<EpdPosition>& positions, const ProgressCallback& onResult)
+{
+    TRACE_SCOPE("EpdSuiteRunner::Run", "match");
+    EpdSummary summary;
+    summary.total = (int)positions.size();
+    summary.results.resize(positions.size());
+    m_stop = false;
+
+    std::atomic<size_t> next{ 0 };
+    std::mutex mutex;
+    int done = 0;
+    Clock::time_point t0 = Clock::now();
+
+    auto worker = [&]() {
+        StockfishEngine engine;
+        if (!engine.Initialize(m_path)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            summary.error = "cannot start engine: " + m_path;
+            m_stop = true;
+            return;
+        }
+        for (const auto& opt : m_options.engineOptions)
+            engine.SetOption(opt.first, opt.second);
+        engine.SetSearchCommand(m_options.goCommand);
+
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= positions.size() || m_stop) break;
+
+            if (m_options.newGamePerPosition && !engine.NewGame()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                summary.error = "engine stopped responding";
+                m_stop = true;
+                break;
+            }
+            EpdResult r = SearchPosition(engine, positions[i], (int)i, m_options.stableIterations);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            summary.results[i] = r;
+            ++done;
+            if (r.solved) ++summary.solved;
+            if (onResult) onResult(r, summary.solved, done);
+        }
+    };
+
+    int threads = std::min<int>(m_options.sessions, std::max<int>(summary.total, 1));
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    summary.wallMs = MsSince(t0);
+
+    std::vector<double> times;
+    std::vector<uint64_t> nodes;
+    for (const auto& r : summary.results) {
+        summary.totalNodes += r.nodes;
+        if (!r.solved) continue;
+        times.push_back(r.solveMs);
+        nodes.push_back(r.solveNodes);
+    }
+    std::sort(times.begin(), times.end());
+    std::sort(nodes.begin(), nodes.end());
+    summary.p50Ms = Percentile(times, 0.50);
+    summary.p90Ms = Percentile(times, 0.90);
+    summary.p99Ms = Percentile(times, 0.99);
+    summary.maxMs = times.empty() ? 0.0 : times.back();
+    summary.solveNodesP50 = nodes.empty() ? 0 : nodes[(nodes.size() - 1) / 2];
+    return summary;
+}
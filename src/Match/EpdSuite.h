@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../ChessCore/Board.h"
+
+// EPD 테스트 스위트 한 줄 (bm / am 연산자). 기대 수는 파싱 시 SAN -> UCI로 바꿔 둠
+struct EpdPosition
+{
+    std::string fen;
+    std::string id;                     // id 연산자 (없으면 "#줄번호")
+    Board board;
+    bool isWhiteTurn = true;
+    std::vector<std::string> bestMoves;  // bm: 이 중 하나를 두면 정답
+    std::vector<std::string> avoidMoves; // am: 이 수들만 아니면 정답
+
+    // uci 수가 정답인지 (bm이 있으면 bm 포함, am이 있으면 am 제외)
+    bool Accepts(const std::string& uciMove) const;
+};
+
+struct EpdSuiteOptions
+{
+    int sessions = 1;                   // 동시에 띄울 엔진 프로세스 수 (스레드 = 세션)
+    std::string goCommand = "go movetime 10000"; // 국면당 탐색 상한
+    int stableIterations = 3;           // 정답 수가 연속 K 깊이 PV 첫 수면 stop (0이면 조기 종료 없음)
+    bool newGamePerPosition = true;     // 국면마다 ucinewgame (해시 초기화)
+    std::vector<std::pair<std::string, std::string>> engineOptions; // setoption name / value
+};
+
+struct EpdResult
+{
+    int index = 0;
+    std::string id;
+    std::string bestMove;               // 엔진이 마지막에 낸 수 (UCI)
+    bool solved = false;
+    bool stoppedEarly = false;          // 안정 조건으로 stop을 보냈음
+    double solveMs = 0.0;               // 정답 수가 마지막으로 PV에 자리 잡은 시각 (풀렸을 때만 의미)
+    uint64_t solveNodes = 0;            // 그 시점의 노드 수
+    double totalMs = 0.0;               // 국면 하나에 쓴 전체 시간
+    uint64_t nodes = 0;                 // 마지막 info의 노드 수
+    int depth = 0;                      // 마지막 info의 깊이
+};
+
+struct EpdSummary
+{
+    int total = 0;
+    int solved = 0;
+    double p50Ms = 0.0, p90Ms = 0.0, p99Ms = 0.0, maxMs = 0.0; // 풀린 국면의 해결 시간 백분위
+    uint64_t totalNodes = 0;
+    uint64_t solveNodesP50 = 0;
+    double wallMs = 0.0;
+    std::vector<EpdResult> results;     // 입력 순서
+    std::string error;                  // 엔진 시작 실패 등 (비어 있으면 정상)
+};
+
+// 헤드리스 EPD 스위트 러너
+// - 세션(스레드 + 엔진 프로세스)마다 국면을 하나씩 가져가 탐색 (원자적 인덱스)
+// - info 줄을 따라가며 정답 수가 K 깊이 연속 PV 첫 수면 바로 stop -> 상한 시간까지 기다리지 않음
+class EpdSuiteRunner
+{
+public:
+    using ProgressCallback = std::function<void(const EpdResult&, int solved, int done)>;
+
+    EpdSuiteRunner(std::string enginePath, EpdSuiteOptions options);
+
+    EpdSummary Run(const std::vector<EpdPosition>& positions, const ProgressCallback& onResult = nullptr);
+    void Stop() { m_stop = true; }
+
+    // 한 줄에 EPD 하나 ('#' 주석 / 빈 줄 무시). bm/am 수가 합법이 아니거나 둘 다 없는 줄은 건너뜀
+    static bool LoadSuite(const std::string& path, std::vector<EpdPosition>& outPositions, std::vector<std::string>* outErrors = nullptr);
+    static bool ParseLine(const std::string& line, EpdPosition& outPosition, std::string& outError);
+
+private:
+    std::string m_path;
+    EpdSuiteOptions m_options;
+    std::atomic<bool> m_stop{ false };
+};
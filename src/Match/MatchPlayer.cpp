@@ -0,0 +1,77 @@
+﻿#include "MatchPlayer.h"
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/Notation.h"
+
+UciPlayer::UciPlayer(std::string name, std::string enginePath, std::string goCommand,
+    std::vector<std::pair<std::string, std::string>> options)
+    : m_name(std::move(name)), m_path(std::move(enginePath)), m_goCommand(std::move(goCommand)), m_options(std::move(options))
+{
+}
+
+bool UciPlayer::Start()
+{
+    if (!m_engine.Initialize(m_path))
+        return false;
+
+    for (const auto& opt : m_options)
+        m_engine.SetOption(opt.first, opt.second);
+    m_engine.SetSearchCommand(m_goCommand);
+    return true;
+}
+
+bool UciPlayer::NewGame()
+{
+    return m_engine.NewGame();
+}
+
+std::string UciPlayer::BestMove(const std::string& fen)
+{
+    return m_engine.GetBestMove(fen);
+}
+
+namespace
+{
+    int PieceValue(PieceType t)
+    {
+        switch (t) {
+        case PieceType::Pawn:   return 1;
+        case PieceType::Knight: return 3;
+        case PieceType::Bishop: return 3;
+        case PieceType::Rook:   return 5;
+        case PieceType::Queen:  return 9;
+        default:                return 0;
+        }
+    }
+}
+
+RandomPlayer::RandomPlayer(std::string name, uint32_t seed, bool greedy)
+    : m_name(std::move(name)), m_greedy(greedy), m_rng(seed)
+{
+}
+
+std::string RandomPlayer::BestMove(const std::string& fen)
+{
+    bool isWhiteTurn = true;
+    if (!Fen::FENToBoard(fen, m_board, isWhiteTurn))
+        return {};
+
+    m_logic.GenerateLegalMoves(m_board, isWhiteTurn, m_moves);
+    if (m_moves.empty())
+        return {};
+
+    if (m_greedy) {
+        // 잡는 기물 가치가 가장 큰 수들 중에서 무작위 (승급은 퀸만)
+        int best = -1;
+        std::vector<Move> top;
+        for (const auto& mv : m_moves) {
+            if (mv.promotion != PieceType::None && mv.promotion != PieceType::Queen) continue;
+            int v = PieceValue(m_board.GetPiece(mv.dx, mv.dy).type) + (mv.promotion == PieceType::Queen ? 8 : 0);
+            if (v > best) { best = v; top.clear(); }
+            if (v == best) top.push_back(mv);
+        }
+        m_moves.swap(top);
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, m_moves.size() - 1);
+    return Notation::MoveToUCI(m_moves[pick(m_rng)]);
+}
@@ -0,0 +1,69 @@
+﻿#pragma once
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../ChessCore/Board.h"
+#include "../ChessCore/GameLogic.h"
+#include "../Engine/Stockfish.h"
+
+// 대국 러너에서 한쪽을 맡는 플레이어
+// 스레드 하나가 플레이어 인스턴스 하나를 독점하므로 구현은 스레드 안전할 필요 없음
+class MatchPlayer
+{
+public:
+    virtual ~MatchPlayer() = default;
+
+    virtual bool Start() = 0;
+    // 새 대국 시작 (엔진 해시 초기화 등). 실패하면 false
+    virtual bool NewGame() = 0;
+    // 주어진 국면에서 둘 수 (UCI 좌표 표기). 응답이 없으면 빈 문자열
+    virtual std::string BestMove(const std::string& fen) = 0;
+    virtual std::string Name() const = 0;
+};
+
+using PlayerFactory = std::function<std::unique_ptr<MatchPlayer>()>;
+
+// UCI 엔진 프로세스 (StockfishEngine 파이프 재사용)
+class UciPlayer : public MatchPlayer
+{
+public:
+    UciPlayer(std::string name, std::string enginePath, std::string goCommand,
+        std::vector<std::pair<std::string, std::string>> options = {});
+
+    bool Start() override;
+    bool NewGame() override;
+    std::string BestMove(const std::string& fen) override;
+    std::string Name() const override { return m_name; }
+
+private:
+    std::string m_name;
+    std::string m_path;
+    std::string m_goCommand;
+    std::vector<std::pair<std::string, std::string>> m_options; // setoption name / value
+    StockfishEngine m_engine;
+};
+
+// 엔진 없이 러너를 돌려보기 위한 모의 플레이어
+// - 합법수 중 무작위 (시드 고정 -> 재현 가능)
+// - greedy이면 가장 비싼 기물을 잡는 수를 우선 (약한 기준선과 실력 차를 만들기 위함)
+class RandomPlayer : public MatchPlayer
+{
+public:
+    RandomPlayer(std::string name, uint32_t seed, bool greedy = false);
+
+    bool Start() override { return true; }
+    bool NewGame() override { return true; }
+    std::string BestMove(const std::string& fen) override;
+    std::string Name() const override { return m_name; }
+
+private:
+    std::string m_name;
+    bool m_greedy;
+    std::mt19937 m_rng;
+    GameLogic m_logic;
+    Board m_board;
+    std::vector<Move> m_moves;
+};
@@ -0,0 +1,324 @@
+﻿#include "MatchRunner.h"
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/Notation.h"
+
+namespace
+{
+    const char* kStartFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    const char* ResultString(GameResult r)
+    {
+        switch (r) {
+        case GameResult::WhiteWins: return "1-0";
+        case GameResult::BlackWins: return "0-1";
+        default:                    return "1/2-1/2";
+        }
+    }
+
+    // 반복 판정용 키: 기물 배치 + 차례 + 캐슬링 + 앙파상 (수 카운터 제외)
+    std::string PositionKey(const Board& board, bool isWhiteTurn)
+    {
+        std::string fen = Fen::BoardToFEN(board, isWhiteTurn);
+        size_t cut = fen.rfind(" 0 1");
+        return (cut != std::string::npos) ? fen.substr(0, cut) : fen;
+    }
+
+    // 어느 쪽도 메이트를 만들 수 없는 기물 구성 (K vs K, K+경기물 vs K, 같은 색 칸 비숍만)
+    bool IsInsufficientMaterial(const Board& board)
+    {
+        int minors = 0, knights = 0;
+        int bishopSquareColors = 0; // bit0: 밝은 칸, bit1: 어두운 칸
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                const Piece& p = board.GetPiece(x, y);
+                switch (p.type) {
+                case PieceType::Pawn:
+                case PieceType::Rook:
+                case PieceType::Queen:
+                    return false;
+                case PieceType::Knight:
+                    ++minors; ++knights;
+                    break;
+                case PieceType::Bishop:
+                    ++minors;
+                    bishopSquareColors |= ((x + y) % 2 == 0) ? 1 : 2;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        if (minors <= 1) return true;
+        return knights == 0 && bishopSquareColors != 3;
+    }
+
+    // FEN의 5/6번째 필드 (없으면 0 / 1)
+    void ReadCounters(const std::string& fen, int& halfmove, int& fullmove)
+    {
+        std::istringstream iss(fen);
+        std::string field;
+        for (int i = 0; i < 4; ++i) iss >> field;
+        halfmove = 0; fullmove = 1;
+        iss >> halfmove >> fullmove;
+        if (fullmove < 1) fullmove = 1;
+    }
+
+    bool SameMove(const Move& a, const Move& b)
+    {
+        if (a.sx != b.sx || a.sy != b.sy || a.dx != b.dx || a.dy != b.dy) return false;
+        // UCI에 승급 문자가 없으면 퀸 승급으로 간주 (ApplyMove와 동일)
+        PieceType pa = (a.promotion == PieceType::None) ? PieceType::Queen : a.promotion;
+        PieceType pb = (b.promotion == PieceType::None) ? PieceType::Queen : b.promotion;
+        return pa == pb;
+    }
+}
+
+MatchRunner::MatchRunner(PlayerFactory engineA, PlayerFactory engineB, MatchOptions options)
+    : m_factoryA(std::move(engineA)), m_factoryB(std::move(engineB)), m_options(std::move(options))
+{
+    if (m_options.concurrency < 1) m_options.concurrency = 1;
+    if (m_options.rounds < 1) m_options.rounds = 1;
+}
+
+bool MatchRunner::LoadOpenings(const std::string& path, std::vector<std::string>& outFens)
+{
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream iss(line);
+        std::string fields[6];
+        int n = 0;
+        while (n < 6 && iss >> fields[n]) ++n;
+        if (n < 4) continue;
+
+        // EPD는 4필드 뒤에 연산자(bm, id ...)가 오므로 숫자일 때만 카운터로 취급
+        std::string fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+        bool counters = n == 6 && fields[4].find_first_not_of("0123456789") == std::string::npos
+            && fields[5].find_first_not_of("0123456789") == std::string::npos;
+        fen += counters ? " " + fields[4] + " " + fields[5] : " 0 1";
+
+        Board probe;
+        bool turn = true;
+        if (Fen::FENToBoard(fen, probe, turn)) outFens.push_back(fen);
+    }
+    return true;
+}
+
+GameRecord MatchRunner::PlayGame(MatchPlayer& white, MatchPlayer& black, const std::string& startFen)
+{
+    GameRecord game;
+    game.startFen = startFen;
+
+    GameLogic logic;
+    Board board;
+    bool isWhiteTurn = true;
+    if (!Fen::FENToBoard(startFen, board, isWhiteTurn)) {
+        game.termination = "invalid start position";
+        return game;
+    }
+
+    int halfmove = 0, fullmove = 1;
+    ReadCounters(startFen, halfmove, fullmove);
+
+    std::map<std::string, int> seen;
+    std::vector<Move> legal;
+
+    auto finish = [&](GameResult r, const char* why) {
+        game.result = r;
+        game.termination = why;
+    };
+    auto sideLoses = [](bool whiteLoses) { return whiteLoses ? GameResult::BlackWins : GameResult::WhiteWins; };
+
+    for (int ply = 0;; ++ply) {
+        GameState state = logic.CheckGameState(board, isWhiteTurn);
+        if (state == GameState::Checkmate) { finish(sideLoses(isWhiteTurn), "checkmate"); break; }
+        if (state == GameState::Stalemate) { finish(GameResult::Draw, "stalemate"); break; }
+        if (++seen[PositionKey(board, isWhiteTurn)] >= 3) { finish(GameResult::Draw, "threefold repetition"); break; }
+        if (halfmove >= 100) { finish(GameResult::Draw, "fifty-move rule"); break; }
+        if (IsInsufficientMaterial(board)) { finish(GameResult::Draw, "insufficient material"); break; }
+        if (ply >= m_options.maxPlies) { finish(GameResult::Draw, "max plies"); break; }
+        if (m_stop) { finish(GameResult::Draw, "aborted"); break; }
+
+        // 엔진에는 러너가 관리하는 수 카운터를 담아 보냄
+        std::string fen = Fen::BoardToFEN(board, isWhiteTurn);
+        fen = fen.substr(0, fen.rfind(" 0 1")) + " " + std::to_string(halfmove) + " " + std::to_string(fullmove);
+
+        MatchPlayer& mover = isWhiteTurn ? white : black;
+        std::string uci = mover.BestMove(fen);
+
+        Move mv{};
+        bool ok = Notation::MoveFromUCI(uci, mv);
+        if (ok) {
+            logic.GenerateLegalMoves(board, isWhiteTurn, legal);
+            ok = false;
+            for (const auto& lm : legal) {
+                if (SameMove(lm, mv)) { mv = lm; ok = true; break; }
+            }
+        }
+        if (!ok) {
+            finish(sideLoses(isWhiteTurn), uci.empty() ? "no move" : "illegal move");
+            break;
+        }
+
+        game.sanMoves.push_back(Notation::MoveToSAN(board, mv, isWhiteTurn, logic));
+
+        const Piece& moving = board.GetPiece(mv.sx, mv.sy);
+        bool resetsClock = moving.type == PieceType::Pawn || board.GetPiece(mv.dx, mv.dy).type != PieceType::None;
+        logic.ApplyMove(board, mv, isWhiteTurn);
+
+        halfmove = resetsClock ? 0 : halfmove + 1;
+        if (!isWhiteTurn) ++fullmove;
+        isWhiteTurn = !isWhiteTurn;
+    }
+    return game;
+}
+
+std::string MatchRunner::FormatPgn(const GameRecord& game, const std::string& white, const std::string& black) const
+{
+    std::ostringstream out;
+    out << "[Event \"" << m_options.eventName << "\"]\n";
+    out << "[Site \"?\"]\n";
+    out << "[Date \"" << m_date << "\"]\n";
+    out << "[Round \"" << (game.index + 1) << "\"]\n";
+    out << "[White \"" << white << "\"]\n";
+    out << "[Black \"" << black << "\"]\n";
+    out << "[Result \"" << ResultString(game.result) << "\"]\n";
+    if (game.startFen != kStartFen) {
+        out << "[SetUp \"1\"]\n";
+        out << "[FEN \"" << game.startFen << "\"]\n";
+    }
+    out << "[PlyCount \"" << game.sanMoves.size() << "\"]\n";
+    out << "[Termination \"" << game.termination << "\"]\n\n";
+
+    int halfmove = 0, fullmove = 1;
+    ReadCounters(game.startFen, halfmove, fullmove);
+    bool whiteToMove = game.startFen.find(" b ") == std::string::npos;
+
+    // 80열에서 줄바꿈
+    std::string line;
+    auto emit = [&](const std::string& token) {
+        if (!line.empty() && line.size() + 1 + token.size() > 79) {
+            out << line << "\n";
+            line.clear();
+        }
+        if (!line.empty()) line += ' ';
+        line += token;
+    };
+
+    for (size_t i = 0; i < game.sanMoves.size(); ++i) {
+        if (whiteToMove) emit(std::to_string(fullmove) + ".");
+        else if (i == 0) emit(std::to_string(fullmove) + "...");
+        emit(game.sanMoves[i]);
+        if (!whiteToMove) ++fullmove;
+        whiteToMove = !whiteToMove;
+    }
+    emit(ResultString(game.result));
+    out << line << "\n\n";
+    return out.str();
+}
+
+MatchSummary MatchRunner::Run(const std::vector<std::string>& openings, const ProgressCallback& onGame)
+{
+    MatchSummary summary;
+    m_stop = false;
+
+    std::vector<std::string> suite = openings;
+    if (suite.empty()) suite.push_back(kStartFen);
+
+    {
+        std::time_t now = std::time(nullptr);
+        char buf[16];
+        std::strftime(buf, sizeof(buf), "%Y.%m.%d", std::localtime(&now));
+        m_date = buf;
+    }
+
+    std::ofstream pgn;
+    if (!m_options.pgnPath.empty()) {
+        pgn.open(m_options.pgnPath, std::ios::out | std::ios::app);
+        if (!pgn) {
+            summary.error = "cannot open " + m_options.pgnPath;
+            return summary;
+        }
+    }
+
+    const int totalGames = (int)suite.size() * 2 * m_options.rounds;
+    std::atomic<int> next{ 0 };
+    std::mutex mtx; // summary / pgn / onGame 보호
+
+    auto worker = [&]() {
+        std::unique_ptr<MatchPlayer> a = m_factoryA();
+        std::unique_ptr<MatchPlayer> b = m_factoryB();
+        if (!a || !b || !a->Start() || !b->Start()) {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (summary.error.empty()) summary.error = "failed to start player";
+            m_stop = true;
+            return;
+        }
+
+        for (;;) {
+            if (m_stop) break;
+            int index = next.fetch_add(1);
+            if (index >= totalGames) break;
+
+            // 같은 오프닝을 연속 두 판, 색을 바꿔서 진행
+            int openingIndex = (index / 2) % (int)suite.size();
+            bool aIsWhite = (index % 2) == 0;
+            MatchPlayer& white = aIsWhite ? *a : *b;
+            MatchPlayer& black = aIsWhite ? *b : *a;
+
+            if (!white.NewGame() || !black.NewGame()) {
+                std::lock_guard<std::mutex> lock(mtx);
+                if (summary.error.empty()) summary.error = "player did not respond to ucinewgame";
+                m_stop = true;
+                break;
+            }
+
+            GameRecord game = PlayGame(white, black, suite[openingIndex]);
+            if (game.termination == "aborted") break;
+            game.index = index;
+            game.openingIndex = openingIndex;
+            game.engineAIsWhite = aIsWhite;
+
+            std::lock_guard<std::mutex> lock(mtx);
+            MatchScore& s = summary.score;
+            if (game.result == GameResult::Draw) ++s.draws;
+            else if ((game.result == GameResult::WhiteWins) == aIsWhite) ++s.wins;
+            else ++s.losses;
+            ++summary.gamesPlayed;
+
+            if (pgn.is_open()) {
+                pgn << FormatPgn(game, white.Name(), black.Name());
+                pgn.flush();
+            }
+            if (onGame) onGame(game, s);
+
+            if (m_options.sprt) {
+                summary.sprtResult = MatchStats::SprtCheck(s, m_options.sprtParams, &summary.llr);
+                if (summary.sprtResult != MatchStats::SprtResult::Continue) {
+                    summary.stoppedBySprt = true;
+                    m_stop = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < m_options.concurrency; ++i) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+
+    if (m_options.sprt && !summary.stoppedBySprt)
+        summary.sprtResult = MatchStats::SprtCheck(summary.score, m_options.sprtParams, &summary.llr);
+    return summary;
+}
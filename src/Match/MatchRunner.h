@@ -0,0 +1,77 @@
+﻿#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "MatchPlayer.h"
+#include "MatchStats.h"
+
+enum class GameResult
+{
+    WhiteWins,
+    BlackWins,
+    Draw
+};
+
+struct GameRecord
+{
+    int index = 0;              // 0부터 시작하는 대국 번호
+    int openingIndex = 0;
+    bool engineAIsWhite = true;
+    std::string startFen;
+    std::vector<std::string> sanMoves;
+    GameResult result = GameResult::Draw;
+    std::string termination;    // "checkmate", "stalemate", "threefold repetition" ...
+};
+
+struct MatchOptions
+{
+    int concurrency = 1;        // 동시에 진행할 대국 수 (스레드 = 플레이어 쌍)
+    int rounds = 1;             // 오프닝 하나당 색을 바꿔 2판씩 x rounds
+    int maxPlies = 600;         // 초과하면 무승부 판정
+    std::string pgnPath;        // 비어 있으면 PGN 미기록
+    std::string eventName = "Engine Match";
+
+    bool sprt = false;          // true이면 경계를 넘는 순간 조기 종료
+    MatchStats::SprtParams sprtParams;
+};
+
+struct MatchSummary
+{
+    MatchScore score;           // 엔진 A 기준
+    int gamesPlayed = 0;
+    bool stoppedBySprt = false;
+    MatchStats::SprtResult sprtResult = MatchStats::SprtResult::Continue;
+    double llr = 0.0;
+    std::string error;          // 플레이어 시작 실패 등 (비어 있으면 정상)
+};
+
+// 헤드리스 엔진 대 엔진 대국 러너
+// - 작업 스레드마다 플레이어 쌍 / GameLogic 을 따로 가짐 (공유 상태는 점수/PGN뿐)
+// - 판정: 체크메이트/스테일메이트(CheckGameState), 3회 반복, 50수, 기물 부족, 최대 수,
+//   불법수/무응답은 해당 쪽 패배
+class MatchRunner
+{
+public:
+    using ProgressCallback = std::function<void(const GameRecord&, const MatchScore&)>;
+
+    MatchRunner(PlayerFactory engineA, PlayerFactory engineB, MatchOptions options);
+
+    // openings가 비어 있으면 초기 국면 하나로 진행
+    MatchSummary Run(const std::vector<std::string>& openings, const ProgressCallback& onGame = nullptr);
+    void Stop() { m_stop = true; }
+
+    // 한 줄에 FEN/EPD 하나 (EPD 연산자는 무시, '#' 주석 / 빈 줄 무시)
+    static bool LoadOpenings(const std::string& path, std::vector<std::string>& outFens);
+
+private:
+    PlayerFactory m_factoryA;
+    PlayerFactory m_factoryB;
+    MatchOptions m_options;
+    std::atomic<bool> m_stop{ false };
+    std::string m_date; // PGN Date 태그 (Run 시작 시각)
+
+    GameRecord PlayGame(MatchPlayer& white, MatchPlayer& black, const std::string& startFen);
+    std::string FormatPgn(const GameRecord& game, const std::string& white, const std::string& black) const;
+};
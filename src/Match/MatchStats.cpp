@@ -0,0 +1,77 @@
+﻿#include "MatchStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    double EloToScore(double elo)
+    {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+
+    double ScoreToElo(double s)
+    {
+        s = std::min(std::max(s, 1e-6), 1.0 - 1e-6);
+        return -400.0 * std::log10(1.0 / s - 1.0);
+    }
+
+    // 한 판당 득점의 평균 / 분산
+    bool ScoreMoments(const MatchScore& score, double& mean, double& var)
+    {
+        int n = score.Games();
+        if (n == 0) return false;
+        double w = (double)score.wins / n, l = (double)score.losses / n, d = (double)score.draws / n;
+        mean = w + 0.5 * d;
+        var = w * (1.0 - mean) * (1.0 - mean) + l * mean * mean + d * (0.5 - mean) * (0.5 - mean);
+        return true;
+    }
+}
+
+MatchStats::EloEstimate MatchStats::Estimate(const MatchScore& score)
+{
+    EloEstimate e;
+    double mean = 0.5, var = 0.0;
+    if (!ScoreMoments(score, mean, var)) return e;
+
+    e.score = mean;
+    e.elo = ScoreToElo(mean);
+
+    double se = std::sqrt(var / score.Games());
+    double lo = ScoreToElo(mean - 1.959964 * se);
+    double hi = ScoreToElo(mean + 1.959964 * se);
+    e.margin95 = (hi - lo) / 2.0;
+
+    int decisive = score.wins + score.losses;
+    if (decisive > 0)
+        e.los = 0.5 * (1.0 + std::erf((score.wins - score.losses) / std::sqrt(2.0 * decisive)));
+    return e;
+}
+
+double MatchStats::SprtLLR(const MatchScore& score, double elo0, double elo1)
+{
+    // 정규 근사: LLR = N (s1 - s0)(2s - s0 - s1) / (2 var)
+    // 한쪽 결과만 나온 초반(var == 0)에는 판정을 보류
+    double mean = 0.5, var = 0.0;
+    if (!ScoreMoments(score, mean, var) || var <= 0.0) return 0.0;
+
+    double s0 = EloToScore(elo0), s1 = EloToScore(elo1);
+    return score.Games() * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * var);
+}
+
+void MatchStats::SprtBounds(const SprtParams& params, double& lower, double& upper)
+{
+    lower = std::log(params.beta / (1.0 - params.alpha));
+    upper = std::log((1.0 - params.beta) / params.alpha);
+}
+
+MatchStats::SprtResult MatchStats::SprtCheck(const MatchScore& score, const SprtParams& params, double* outLLR)
+{
+    double llr = SprtLLR(score, params.elo0, params.elo1);
+    if (outLLR) *outLLR = llr;
+
+    double lower = 0.0, upper = 0.0;
+    SprtBounds(params, lower, upper);
+    if (llr >= upper) return SprtResult::AcceptH1;
+    if (llr <= lower) return SprtResult::AcceptH0;
+    return SprtResult::Continue;
+}
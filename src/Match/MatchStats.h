@@ -0,0 +1,44 @@
+﻿#pragma once
+
+// 대국 결과 통계 (엔진 A 기준 승/패/무)
+struct MatchScore
+{
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+
+    int Games() const { return wins + losses + draws; }
+};
+
+namespace MatchStats
+{
+    struct EloEstimate
+    {
+        double elo = 0.0;      // 로지스틱 Elo 차이 (A - B)
+        double margin95 = 0.0; // 95% 신뢰 구간 반폭
+        double los = 0.5;      // Likelihood of superiority (무승부 제외)
+        double score = 0.5;    // 득점률
+    };
+
+    EloEstimate Estimate(const MatchScore& score);
+
+    struct SprtParams
+    {
+        double elo0 = 0.0;  // H0: Elo 차이 <= elo0
+        double elo1 = 5.0;  // H1: Elo 차이 >= elo1
+        double alpha = 0.05;
+        double beta = 0.05;
+    };
+
+    enum class SprtResult
+    {
+        Continue,
+        AcceptH0,
+        AcceptH1
+    };
+
+    // 3항(승/무/패) 분포에 대한 GSPRT 로그 우도비 근사
+    double SprtLLR(const MatchScore& score, double elo0, double elo1);
+    void SprtBounds(const SprtParams& params, double& lower, double& upper);
+    SprtResult SprtCheck(const MatchScore& score, const SprtParams& params, double* outLLR = nullptr);
+}
@@ -0,0 +1,273 @@
+﻿#include "BoardCompositor.h"
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+#include "PixelOps.h"
+#include "../ChessCore/Geometry.h"
+
+namespace
+{
+    // BGRA 순서
+    const cv::Scalar k_background(20, 30, 40, 255);   // RGB(40, 30, 20)
+    const cv::Scalar k_frameColor(40, 80, 140, 255);  // RGB(140, 80, 40)
+    const cv::Scalar k_lightTile(180, 220, 240, 255); // RGB(240, 220, 180)
+    const cv::Scalar k_darkTile(70, 120, 180, 255);   // RGB(180, 120, 70)
+    const cv::Scalar k_hintColor(0, 200, 0, 255);     // RGB(0, 200, 0)
+    const cv::Scalar k_hintGainColor(230, 150, 30, 255); // RGB(30, 150, 230)
+    const cv::Scalar k_hintLossColor(30, 60, 230, 255);  // RGB(230, 60, 30)
+    const cv::Scalar k_threatColor(40, 40, 220, 255); // RGB(220, 40, 40)
+    const cv::Scalar k_passedColor(40, 200, 240, 255); // RGB(240, 200, 40)
+    const cv::Scalar k_weakColor(160, 60, 140, 255);   // RGB(140, 60, 160)
+
+    const int k_selectionPen = 3;
+
+    void FillClipped(cv::Mat& m, cv::Rect r, const cv::Scalar& color)
+    {
+        r &= cv::Rect(0, 0, m.cols, m.rows);
+        if (r.area() > 0) m(r).setTo(color);
+    }
+}
+
+void BoardCompositor::Resize(int width, int height, int tileSize)
+{
+    if (width == m_width && height == m_height && tileSize == m_tileSize) return;
+    m_width = (width > 0) ? width : 0;
+    m_height = (height > 0) ? height : 0;
+    m_tileSize = tileSize;
+
+    if (m_width > 0 && m_height > 0) {
+        m_staticLayer.create(m_height, m_width, CV_8UC4);
+        m_pieceLayer.create(m_height, m_width, CV_8UC4);
+        m_frame.create(m_height, m_width, CV_8UC4);
+    }
+    else {
+        m_staticLayer.release();
+        m_pieceLayer.release();
+        m_frame.release();
+    }
+    InvalidateAll();
+}
+
+void BoardCompositor::SetSprites(const SpriteSet* sprites)
+{
+    m_sprites = sprites;
+    InvalidateAll();
+}
+
+void BoardCompositor::InvalidateAll()
+{
+    m_fullInvalid = true;
+}
+
+cv::Rect BoardCompositor::SquareRect(int x, int y) const
+{
+    int origin = BoardOrigin();
+    return cv::Rect(origin + x * m_tileSize, origin + y * m_tileSize, m_tileSize, m_tileSize);
+}
+
+void BoardCompositor::RenderStaticLayer()
+{
+    m_staticLayer.setTo(k_background);
+
+    int boardSize = m_tileSize * 8;
+    int frameThickness = BoardOrigin();
+    FillClipped(m_staticLayer, cv::Rect(0, 0, boardSize + frameThickness * 2, boardSize + frameThickness * 2), k_frameColor);
+
+    for (int y = 0; y < 8; ++y)
+        for (int x = 0; x < 8; ++x) {
+            bool isDark = ((x + y) % 2) != 0;
+            FillClipped(m_staticLayer, SquareRect(x, y), isDark ? k_darkTile : k_lightTile);
+        }
+}
+
+void BoardCompositor::RenderPieceSquare(int x, int y, int sprite)
+{
+    cv::Rect sq = SquareRect(x, y);
+    cv::Rect r = sq & cv::Rect(0, 0, m_width, m_height);
+    if (r.area() > 0) {
+        cv::Mat dst = m_pieceLayer(r);
+        m_staticLayer(r).copyTo(dst);
+    }
+    if (sprite >= 0 && m_sprites)
+        BlendSprite(m_pieceLayer, m_sprites->Get(sprite), sq.x, sq.y);
+    m_layerSprites[y * 8 + x] = sprite;
+}
+
+// 그리는 순서대로: 위협 칸 -> 폰 구조 표시 -> 이동 애니메이션 -> 드래그 기물 -> 선택 테두리 -> 힌트
+void BoardCompositor::CollectOverlays(const BoardScene& scene, std::vector<OverlayItem>& out) const
+{
+    out.clear();
+    int origin = BoardOrigin();
+    int t = m_tileSize;
+
+    for (uint64_t mask = scene.threatMask; mask; ) {
+        int sq = Geometry::PopLsb(mask);
+        out.push_back({ OverlayKind::Threat, SquareRect(sq % 8, sq / 8), -1 });
+    }
+
+    // 폰 구조: 칸 왼쪽 위 모서리의 작은 사각형 (통과한 폰은 약한 폰이기도 할 수 있어 통과 표시를 우선)
+    int mark = t / 6 > 2 ? t / 6 : 2;
+    for (uint64_t mask = scene.passedPawnMask | scene.weakPawnMask; mask; ) {
+        int sq = Geometry::PopLsb(mask);
+        cv::Rect r = SquareRect(sq % 8, sq / 8);
+        OverlayKind kind = ((scene.passedPawnMask >> sq) & 1) ? OverlayKind::PassedPawn : OverlayKind::WeakPawn;
+        out.push_back({ kind, cv::Rect(r.x + k_selectionPen + 1, r.y + k_selectionPen + 1, mark, mark), -1 });
+    }
+
+    if (scene.anim.active) {
+        double p = scene.anim.progress;
+        int px = (int)((scene.anim.fromX + (scene.anim.toX - scene.anim.fromX) * p) * t);
+        int py = (int)((scene.anim.fromY + (scene.anim.toY - scene.anim.fromY) * p) * t);
+        int idx = SpriteSet::Index(scene.anim.movingPiece);
+        if (idx >= 0) out.push_back({ OverlayKind::Sprite, cv::Rect(origin + px, origin + py, t, t), idx });
+    }
+
+    if (scene.dragging && scene.dragPiece.type != PieceType::None) {
+        int px = scene.dragScreenX - t / 2;
+        int py = scene.dragScreenY - t / 2;
+        out.push_back({ OverlayKind::Sprite, cv::Rect(origin + px, origin + py, t, t), SpriteSet::Index(scene.dragPiece) });
+    }
+
+    if (scene.hasSelection && scene.selX >= 0 && scene.selY >= 0) {
+        // GDI 3px 펜처럼 사각형 경계선 중심으로 두께를 줌
+        cv::Rect sq = SquareRect(scene.selX, scene.selY);
+        int half = k_selectionPen / 2;
+        out.push_back({ OverlayKind::Selection, cv::Rect(sq.x - half, sq.y - half, sq.width + half * 2, sq.height + half * 2), -1 });
+    }
+
+    int r = t / 6;
+    for (const auto& h : scene.hints) {
+        int cx = origin + h.x * t + t / 2;
+        int cy = origin + h.y * t + t / 2;
+        OverlayKind kind = h.exchange > 0 ? OverlayKind::HintGain : (h.exchange < 0 ? OverlayKind::HintLoss : OverlayKind::Hint);
+        out.push_back({ kind, cv::Rect(cx - r, cy - r, r * 2 + 1, r * 2 + 1), -1 });
+    }
+}
+
+void BoardCompositor::DrawOverlays(cv::Mat& roi, const cv::Rect& area, const std::vector<OverlayItem>& overlays) const
+{
+    for (const auto& item : overlays) {
+        if ((item.rect & area).area() <= 0) continue;
+
+        int x = item.rect.x - area.x;
+        int y = item.rect.y - area.y;
+        int w = item.rect.width;
+        int h = item.rect.height;
+
+        switch (item.kind) {
+        case OverlayKind::Threat:
+            // 선택 테두리와 겹치지 않도록 칸 안쪽에 그림
+            FillClipped(roi, cv::Rect(x + 1, y + 1, w - 2, k_selectionPen), k_threatColor);
+            FillClipped(roi, cv::Rect(x + 1, y + h - 1 - k_selectionPen, w - 2, k_selectionPen), k_threatColor);
+            FillClipped(roi, cv::Rect(x + 1, y + 1, k_selectionPen, h - 2), k_threatColor);
+            FillClipped(roi, cv::Rect(x + w - 1 - k_selectionPen, y + 1, k_selectionPen, h - 2), k_threatColor);
+            break;
+        case OverlayKind::PassedPawn:
+        case OverlayKind::WeakPawn:
+            FillClipped(roi, cv::Rect(x, y, w, h), item.kind == OverlayKind::PassedPawn ? k_passedColor : k_weakColor);
+            break;
+        case OverlayKind::Sprite:
+            if (m_sprites) BlendSprite(roi, m_sprites->Get(item.sprite), x, y);
+            break;
+        case OverlayKind::Selection:
+            FillClipped(roi, cv::Rect(x, y, w, k_selectionPen), k_hintColor);
+            FillClipped(roi, cv::Rect(x, y + h - k_selectionPen, w, k_selectionPen), k_hintColor);
+            FillClipped(roi, cv::Rect(x, y, k_selectionPen, h), k_hintColor);
+            FillClipped(roi, cv::Rect(x + w - k_selectionPen, y, k_selectionPen, h), k_hintColor);
+            break;
+        case OverlayKind::Hint:
+        case OverlayKind::HintGain:
+        case OverlayKind::HintLoss:
+        {
+            int r = w / 2;
+            const cv::Scalar& color = item.kind == OverlayKind::HintGain ? k_hintGainColor
+                : (item.kind == OverlayKind::HintLoss ? k_hintLossColor : k_hintColor);
+            cv::circle(roi, cv::Point(x + r, y + r), r, color, cv::FILLED, cv::LINE_8);
+            break;
+        }
+        }
+    }
+}
+
+const std::vector<cv::Rect>& BoardCompositor::Compose(const BoardScene& scene)
+{
+    m_dirty.clear();
+    if (m_frame.empty() || !scene.board) return m_dirty;
+
+    if (m_fullInvalid) {
+        RenderStaticLayer();
+        m_staticLayer.copyTo(m_pieceLayer);
+        m_layerSprites.fill(-1);
+        m_overlays.clear();
+        AddDirty(cv::Rect(0, 0, m_width, m_height));
+        m_fullInvalid = false;
+    }
+
+    // 1. 기물 레이어: 내용이 바뀐 칸만 다시 그림
+    //    (애니메이션 도착 칸은 움직이는 스프라이트가 대신 그리므로 비워 둠)
+    for (int y = 0; y < 8; ++y)
+        for (int x = 0; x < 8; ++x) {
+            int sprite = SpriteSet::Index(scene.board->GetPiece(x, y));
+            if (scene.anim.active && x == scene.anim.toX && y == scene.anim.toY) sprite = -1;
+            if (sprite == m_layerSprites[y * 8 + x]) continue;
+            RenderPieceSquare(x, y, sprite);
+            AddDirty(SquareRect(x, y));
+        }
+
+    // 2. 오버레이: 이전 프레임과 달라진 항목의 영역(이전 위치 + 새 위치)
+    std::vector<OverlayItem> overlays;
+    CollectOverlays(scene, overlays);
+    for (const auto& prev : m_overlays)
+        if (std::find(overlays.begin(), overlays.end(), prev) == overlays.end()) AddDirty(prev.rect);
+    for (const auto& cur : overlays)
+        if (std::find(m_overlays.begin(), m_overlays.end(), cur) == m_overlays.end()) AddDirty(cur.rect);
+
+    MergeDirty();
+
+    // 3. dirty 영역만 pieces 레이어 복사 + 오버레이 합성
+    for (const auto& r : m_dirty) {
+        cv::Mat roi = m_frame(r);
+        m_pieceLayer(r).copyTo(roi);
+        DrawOverlays(roi, r, overlays);
+    }
+
+    m_overlays.swap(overlays);
+    return m_dirty;
+}
+
+void BoardCompositor::AddDirty(const cv::Rect& r)
+{
+    cv::Rect clipped = r & cv::Rect(0, 0, m_width, m_height);
+    if (clipped.area() > 0) m_dirty.push_back(clipped);
+}
+
+// 겹치는 사각형을 합쳐서 각 픽셀이 한 번만 합성되도록 함
+void BoardCompositor::MergeDirty()
+{
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t i = 0; i < m_dirty.size() && !merged; ++i)
+            for (size_t j = i + 1; j < m_dirty.size(); ++j) {
+                if ((m_dirty[i] & m_dirty[j]).area() <= 0) continue;
+                m_dirty[i] |= m_dirty[j];
+                m_dirty.erase(m_dirty.begin() + j);
+                merged = true;
+                break;
+            }
+    }
+}
+
+// 프리멀티플라이된 스프라이트를 (x, y)에 source-over 합성 (dst 범위로 클리핑)
+void BoardCompositor::BlendSprite(cv::Mat& dst, const cv::Mat& sprite, int x, int y)
+{
+    if (sprite.empty() || dst.empty()) return;
+
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + sprite.cols, dst.cols);
+    int y1 = std::min(y + sprite.rows, dst.rows);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int row = y0; row < y1; ++row)
+        PixelOps::BlendOverSpan(dst.ptr(row) + x0 * 4, sprite.ptr(row - y) + (x0 - x) * 4, (size_t)(x1 - x0));
+}
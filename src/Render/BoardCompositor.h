@@ -0,0 +1,72 @@
+﻿#pragma once
+#include <array>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "BoardScene.h"
+#include "SpriteSet.h"
+
+// 오프스크린 보드 합성기 (플랫폼 독립, BGRA cv::Mat 프레임버퍼)
+//
+// 레이어 구성
+//  1. static : 배경 + 나무 프레임 + 타일 (크기 변경 시에만 다시 그림)
+//  2. pieces : static + 정지해 있는 기물 (기물이 바뀐 칸만 다시 그림)
+//  3. frame  : pieces + 오버레이(애니메이션/드래그 스프라이트, 선택, 힌트)
+//
+// Compose()는 이전 프레임과 달라진 영역만 frame에 다시 합성하고,
+// 그 영역 목록(dirty rect)을 돌려주므로 호출자는 해당 영역만 화면에 복사하면 됩니다.
+class BoardCompositor
+{
+public:
+    // width/height: 프레임버퍼(클라이언트 영역) 크기
+    void Resize(int width, int height, int tileSize);
+    void SetSprites(const SpriteSet* sprites);
+    void InvalidateAll();
+
+    const std::vector<cv::Rect>& Compose(const BoardScene& scene);
+
+    const cv::Mat& Framebuffer() const { return m_frame; }
+    int TileSize() const { return m_tileSize; }
+
+private:
+    enum class OverlayKind : uint8_t { Threat, PassedPawn, WeakPawn, Sprite, Selection, Hint, HintGain, HintLoss };
+
+    struct OverlayItem
+    {
+        OverlayKind kind;
+        cv::Rect rect;
+        int sprite; // OverlayKind::Sprite일 때 SpriteSet 인덱스
+
+        bool operator==(const OverlayItem& o) const
+        {
+            return kind == o.kind && sprite == o.sprite && rect.x == o.rect.x && rect.y == o.rect.y
+                && rect.width == o.rect.width && rect.height == o.rect.height;
+        }
+    };
+
+    const SpriteSet* m_sprites = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    int m_tileSize = 0;
+    bool m_fullInvalid = true;
+
+    cv::Mat m_staticLayer;
+    cv::Mat m_pieceLayer;
+    cv::Mat m_frame;
+
+    std::array<int, 64> m_layerSprites{}; // pieces 레이어에 그려진 스프라이트 인덱스 (-1 = 빈칸)
+    std::vector<OverlayItem> m_overlays;  // 직전 프레임의 오버레이
+    std::vector<cv::Rect> m_dirty;
+
+    int BoardOrigin() const { return m_tileSize / 3; }
+    cv::Rect SquareRect(int x, int y) const;
+
+    void RenderStaticLayer();
+    void RenderPieceSquare(int x, int y, int sprite);
+    void CollectOverlays(const BoardScene& scene, std::vector<OverlayItem>& out) const;
+    void DrawOverlays(cv::Mat& roi, const cv::Rect& area, const std::vector<OverlayItem>& overlays) const;
+
+    void AddDirty(const cv::Rect& r);
+    void MergeDirty();
+
+    static void BlendSprite(cv::Mat& dst, const cv::Mat& sprite, int x, int y);
+};
@@ -0,0 +1,47 @@
+﻿#pragma once
+#include <cstdint>
+#include <vector>
+#include "../ChessCore/Board.h"
+#include "../ChessCore/Piece.h"
+
+// (Renderer.h에서 이동) 플랫폼 독립 렌더링 입력 구조체
+
+struct MoveHint
+{
+    int x;
+    int y;
+    int exchange = 0; // [추가] 그 칸으로 갈 때 교환 득실(SEE) 부호: +1 이득, -1 기물을 잃음, 0 본전 / 안전
+};
+
+struct MoveAnim
+{
+    bool active = false;
+    bool isAnimating = false;
+    int fromX = 0;
+    int fromY = 0;
+    int toX = 0;
+    int toY = 0;
+    double progress = 0.0;
+    uint64_t startTick = 0; // GetTickCount64() 값 (ms)
+    Piece movingPiece;
+};
+
+// 한 프레임을 그리는 데 필요한 모든 상태
+struct BoardScene
+{
+    const Board* board = nullptr;
+    int  selX = -1;
+    int  selY = -1;
+    bool hasSelection = false;
+    std::vector<MoveHint> hints;
+    MoveAnim anim;
+    bool dragging = false;
+    int  dragScreenX = 0;
+    int  dragScreenY = 0;
+    Piece dragPiece;
+    // [추가] 위협 오버레이: 비트 (y * 8 + x) 가 켜진 칸에 빨간 테두리
+    uint64_t threatMask = 0;
+    // [추가] 폰 구조 오버레이: 통과한 폰 / 약한 폰(고립, 겹침, 뒤처짐) 칸 모서리에 표시
+    uint64_t passedPawnMask = 0;
+    uint64_t weakPawnMask = 0;
+};
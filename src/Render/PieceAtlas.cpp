@@ -0,0 +1,84 @@
+﻿#include "PieceAtlas.h"
+#include <cstring>
+
+namespace
+{
+    const uint32_t k_align = 16;
+    const int k_maxTileSize = 1024;
+
+    size_t SpriteBytes(uint32_t tileSize) { return (size_t)tileSize * tileSize * 4; }
+    size_t LevelBytes(uint32_t tileSize) { return SpriteBytes(tileSize) * PieceAtlas::k_spriteCount; }
+    size_t AlignUp(size_t n) { return (n + k_align - 1) & ~(size_t)(k_align - 1); }
+}
+
+bool PieceAtlas::Attach(const void* data, size_t size)
+{
+    Detach();
+    if (!data || size < sizeof(Header)) return false;
+
+    // 리소스 메모리는 정렬이 보장되지 않으므로 헤더는 복사해서 읽음
+    Header h;
+    std::memcpy(&h, data, sizeof(h));
+    if (h.magic != k_magic || h.version != k_version || h.spriteCount != k_spriteCount) return false;
+    if (h.levelCount == 0 || h.levelCount > (uint32_t)k_maxLevels) return false;
+
+    for (uint32_t i = 0; i < h.levelCount; ++i)
+    {
+        const Level& lv = h.levels[i];
+        if (lv.tileSize == 0 || lv.tileSize > (uint32_t)k_maxTileSize) return false;
+        if (i > 0 && lv.tileSize <= h.levels[i - 1].tileSize) return false; // FindLevel은 오름차순을 가정
+        if (lv.offset < sizeof(Header) || lv.offset > size || size - lv.offset < LevelBytes(lv.tileSize)) return false;
+    }
+
+    m_data = (const uint8_t*)data;
+    m_levelCount = h.levelCount;
+    std::memcpy(m_levels, h.levels, sizeof(m_levels));
+    return true;
+}
+
+void PieceAtlas::Detach()
+{
+    m_data = nullptr;
+    m_levelCount = 0;
+}
+
+int PieceAtlas::FindLevel(int tileSize) const
+{
+    if (m_levelCount == 0) return -1;
+    for (uint32_t i = 0; i < m_levelCount; ++i)
+        if ((int)m_levels[i].tileSize >= tileSize) return (int)i;
+    return (int)m_levelCount - 1;
+}
+
+size_t PieceAtlas::PixelOffset(int level, int sprite) const
+{
+    const Level& lv = m_levels[level];
+    return lv.offset + SpriteBytes(lv.tileSize) * sprite;
+}
+
+bool PieceAtlas::Create(const std::vector<int>& tileSizes, std::vector<uint8_t>& out)
+{
+    out.clear();
+    if (tileSizes.empty() || tileSizes.size() > (size_t)k_maxLevels) return false;
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    h.magic = k_magic;
+    h.version = k_version;
+    h.spriteCount = k_spriteCount;
+    h.levelCount = (uint32_t)tileSizes.size();
+
+    size_t offset = AlignUp(sizeof(Header));
+    for (size_t i = 0; i < tileSizes.size(); ++i)
+    {
+        int t = tileSizes[i];
+        if (t <= 0 || t > k_maxTileSize || (i > 0 && t <= tileSizes[i - 1])) return false;
+        h.levels[i].tileSize = (uint32_t)t;
+        h.levels[i].offset = (uint32_t)offset;
+        offset = AlignUp(offset + LevelBytes((uint32_t)t));
+    }
+
+    out.assign(offset, 0);
+    std::memcpy(out.data(), &h, sizeof(h));
+    return true;
+}
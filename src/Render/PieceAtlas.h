@@ -0,0 +1,57 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// [추가] 빌드 때 구운 기물 아틀라스 (플랫폼 독립, OpenCV 불필요)
+// src/Tools/AtlasBaker가 assets/pieces의 PNG를 여러 타일 크기로 미리 프리멀티플라이 + 리샘플링해
+// 한 덩어리로 만들고, 실행 파일에 리소스로 넣습니다. 런타임은 그 메모리를 복사 없이 그대로 씀 (디코딩 없음).
+//
+// 배치 (리틀 엔디안):
+//   Header | 레벨 0 스프라이트 0..11 | 레벨 1 ... (레벨 시작은 16바이트 정렬)
+//   스프라이트 하나 = tileSize x tileSize BGRA, 행 사이 여백 없음. 스프라이트 순서는 SpriteSet::Index()와 같음
+class PieceAtlas
+{
+public:
+    static const uint32_t k_magic = 0x31415043; // "CPA1"
+    static const uint16_t k_version = 1;
+    static const int k_spriteCount = 12;        // SpriteSet::COUNT
+    static const int k_maxLevels = 16;
+
+    // 덩어리의 헤더와 크기를 검사하고 참조 (복사하지 않으므로 data는 이 객체보다 오래 살아야 함)
+    bool Attach(const void* data, size_t size);
+    void Detach();
+    bool Empty() const { return m_data == nullptr; }
+
+    int LevelCount() const { return (int)m_levelCount; }
+    int LevelTileSize(int level) const { return (int)m_levels[level].tileSize; }
+    // tileSize와 같은 레벨, 없으면 그보다 큰 것 중 가장 작은 레벨 (축소가 확대보다 깨끗함), 그것도 없으면 가장 큰 레벨
+    int FindLevel(int tileSize) const;
+
+    size_t PixelOffset(int level, int sprite) const;
+    const uint8_t* Pixels(int level, int sprite) const { return m_data + PixelOffset(level, sprite); }
+
+    // 베이커용: tileSizes(오름차순) 레벨의 헤더 + 0으로 채운 픽셀 영역을 만듦. 크기가 잘못되면 false
+    // 픽셀은 Attach 후 PixelOffset 위치에 채움
+    static bool Create(const std::vector<int>& tileSizes, std::vector<uint8_t>& out);
+
+private:
+    struct Level
+    {
+        uint32_t tileSize;
+        uint32_t offset;    // 덩어리 시작부터
+    };
+    struct Header
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t spriteCount;
+        uint32_t levelCount;
+        uint32_t reserved;
+        Level levels[k_maxLevels];
+    };
+
+    const uint8_t* m_data = nullptr;
+    uint32_t m_levelCount = 0;
+    Level m_levels[k_maxLevels] = {};
+};
@@ -0,0 +1,307 @@
+﻿#include "PixelOps.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXELOPS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang는 함수 단위로 명령어 집합을 켜야 함 (전체 빌드는 기본 ISA 유지)
+#if defined(__GNUC__) || defined(__clang__)
+#define PIXELOPS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PIXELOPS_TARGET(isa)
+#endif
+
+namespace
+{
+    // x / 255 (버림)의 나눗셈 없는 정확한 형태. 0 <= x <= 255*255 범위에서 x / 255와 항상 같음.
+    inline uint32_t Div255(uint32_t x)
+    {
+        x += 1;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    void PremultiplyScalar(uint8_t* p, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, p += 4)
+        {
+            uint32_t a = p[3];
+            p[0] = (uint8_t)Div255(p[0] * a);
+            p[1] = (uint8_t)Div255(p[1] * a);
+            p[2] = (uint8_t)Div255(p[2] * a);
+        }
+    }
+
+    void BlendOverScalar(uint8_t* d, const uint8_t* s, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i, d += 4, s += 4)
+        {
+            uint32_t inv = 255u - s[3];
+            d[0] = (uint8_t)(s[0] + Div255(d[0] * inv));
+            d[1] = (uint8_t)(s[1] + Div255(d[1] * inv));
+            d[2] = (uint8_t)(s[2] + Div255(d[2] * inv));
+            d[3] = (uint8_t)(s[3] + Div255(d[3] * inv));
+        }
+    }
+
+#if PIXELOPS_X86
+    // ---- SSE2 (4픽셀 단위) ----
+    // 16비트 레인 배치: 픽셀 하나 = [B, G, R, A], 레지스터 하나에 2픽셀
+
+    PIXELOPS_TARGET("sse2")
+    inline __m128i Div255Sse2(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(1));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    PIXELOPS_TARGET("sse2")
+    inline __m128i BroadcastAlphaSse2(__m128i px16)
+    {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(px16, 0xFF), 0xFF);
+    }
+
+    PIXELOPS_TARGET("sse2")
+    void PremultiplySse2(uint8_t* p, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, p += 16)
+        {
+            __m128i px = _mm_loadu_si128((const __m128i*)p);
+            __m128i lo = _mm_unpacklo_epi8(px, zero);
+            __m128i hi = _mm_unpackhi_epi8(px, zero);
+
+            // 알파 레인은 255를 곱해 원래 값을 유지 (Div255(a*255) == a)
+            __m128i aLo = _mm_or_si128(_mm_andnot_si128(alphaLanes, BroadcastAlphaSse2(lo)), alphaOne);
+            __m128i aHi = _mm_or_si128(_mm_andnot_si128(alphaLanes, BroadcastAlphaSse2(hi)), alphaOne);
+
+            lo = Div255Sse2(_mm_mullo_epi16(lo, aLo));
+            hi = Div255Sse2(_mm_mullo_epi16(hi, aHi));
+            _mm_storeu_si128((__m128i*)p, _mm_packus_epi16(lo, hi));
+        }
+        PremultiplyScalar(p, count - i);
+    }
+
+    PIXELOPS_TARGET("sse2")
+    void BlendOverSse2(uint8_t* d, const uint8_t* s, size_t count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i full = _mm_set1_epi16(255);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, d += 16, s += 16)
+        {
+            __m128i sp = _mm_loadu_si128((const __m128i*)s);
+            __m128i dp = _mm_loadu_si128((const __m128i*)d);
+
+            __m128i sLo = _mm_unpacklo_epi8(sp, zero);
+            __m128i sHi = _mm_unpackhi_epi8(sp, zero);
+            __m128i dLo = _mm_unpacklo_epi8(dp, zero);
+            __m128i dHi = _mm_unpackhi_epi8(dp, zero);
+
+            __m128i invLo = _mm_sub_epi16(full, BroadcastAlphaSse2(sLo));
+            __m128i invHi = _mm_sub_epi16(full, BroadcastAlphaSse2(sHi));
+
+            __m128i outLo = _mm_add_epi16(sLo, Div255Sse2(_mm_mullo_epi16(dLo, invLo)));
+            __m128i outHi = _mm_add_epi16(sHi, Div255Sse2(_mm_mullo_epi16(dHi, invHi)));
+            _mm_storeu_si128((__m128i*)d, _mm_packus_epi16(outLo, outHi));
+        }
+        BlendOverScalar(d, s, count - i);
+    }
+
+    // ---- AVX2 (8픽셀 단위) ----
+    // unpack/pack이 128비트 레인 안에서만 동작하므로 순서가 그대로 보존됨
+
+    PIXELOPS_TARGET("avx2")
+    inline __m256i Div255Avx2(__m256i x)
+    {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(1));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    PIXELOPS_TARGET("avx2")
+    inline __m256i BroadcastAlphaAvx2(__m256i px16)
+    {
+        return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(px16, 0xFF), 0xFF);
+    }
+
+    PIXELOPS_TARGET("avx2")
+    void PremultiplyAvx2(uint8_t* p, size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alphaLanes = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+        const __m256i alphaOne = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, p += 32)
+        {
+            __m256i px = _mm256_loadu_si256((const __m256i*)p);
+            __m256i lo = _mm256_unpacklo_epi8(px, zero);
+            __m256i hi = _mm256_unpackhi_epi8(px, zero);
+
+            __m256i aLo = _mm256_or_si256(_mm256_andnot_si256(alphaLanes, BroadcastAlphaAvx2(lo)), alphaOne);
+            __m256i aHi = _mm256_or_si256(_mm256_andnot_si256(alphaLanes, BroadcastAlphaAvx2(hi)), alphaOne);
+
+            lo = Div255Avx2(_mm256_mullo_epi16(lo, aLo));
+            hi = Div255Avx2(_mm256_mullo_epi16(hi, aHi));
+            _mm256_storeu_si256((__m256i*)p, _mm256_packus_epi16(lo, hi));
+        }
+        PremultiplySse2(p, count - i);
+    }
+
+    PIXELOPS_TARGET("avx2")
+    void BlendOverAvx2(uint8_t* d, const uint8_t* s, size_t count)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i full = _mm256_set1_epi16(255);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, d += 32, s += 32)
+        {
+            __m256i sp = _mm256_loadu_si256((const __m256i*)s);
+            __m256i dp = _mm256_loadu_si256((const __m256i*)d);
+
+            __m256i sLo = _mm256_unpacklo_epi8(sp, zero);
+            __m256i sHi = _mm256_unpackhi_epi8(sp, zero);
+            __m256i dLo = _mm256_unpacklo_epi8(dp, zero);
+            __m256i dHi = _mm256_unpackhi_epi8(dp, zero);
+
+            __m256i invLo = _mm256_sub_epi16(full, BroadcastAlphaAvx2(sLo));
+            __m256i invHi = _mm256_sub_epi16(full, BroadcastAlphaAvx2(sHi));
+
+            __m256i outLo = _mm256_add_epi16(sLo, Div255Avx2(_mm256_mullo_epi16(dLo, invLo)));
+            __m256i outHi = _mm256_add_epi16(sHi, Div255Avx2(_mm256_mullo_epi16(dHi, invHi)));
+            _mm256_storeu_si256((__m256i*)d, _mm256_packus_epi16(outLo, outHi));
+        }
+        BlendOverSse2(d, s, count - i);
+    }
+
+    bool CpuHasAvx2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return false;
+        // OS가 YMM 레지스터 상태를 저장하는지 확인
+        if ((_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+    bool CpuHasSse2()
+    {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true; // x64는 SSE2가 기본
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse2") != 0;
+#endif
+    }
+#endif // PIXELOPS_X86
+
+    PixelOps::Isa DetectIsa()
+    {
+#if PIXELOPS_X86
+        if (CpuHasAvx2()) return PixelOps::Isa::AVX2;
+        if (CpuHasSse2()) return PixelOps::Isa::SSE2;
+#endif
+        return PixelOps::Isa::Scalar;
+    }
+
+    // 요청한 ISA가 지원되지 않으면 한 단계씩 낮춤
+    PixelOps::Isa Clamp(PixelOps::Isa isa)
+    {
+        PixelOps::Isa best = PixelOps::BestIsa();
+        return ((int)isa > (int)best) ? best : isa;
+    }
+}
+
+PixelOps::Isa PixelOps::BestIsa()
+{
+    static const Isa s_isa = DetectIsa();
+    return s_isa;
+}
+
+const char* PixelOps::IsaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::SSE2: return "sse2";
+    case Isa::AVX2: return "avx2";
+    default:        return "scalar";
+    }
+}
+
+void PixelOps::PremultiplySpan(uint8_t* bgra, size_t pixelCount)
+{
+    PremultiplySpan(BestIsa(), bgra, pixelCount);
+}
+
+void PixelOps::BlendOverSpan(uint8_t* dst, const uint8_t* src, size_t pixelCount)
+{
+    BlendOverSpan(BestIsa(), dst, src, pixelCount);
+}
+
+void PixelOps::PremultiplySpan(Isa isa, uint8_t* bgra, size_t pixelCount)
+{
+    switch (Clamp(isa)) {
+#if PIXELOPS_X86
+    case Isa::AVX2: PremultiplyAvx2(bgra, pixelCount); break;
+    case Isa::SSE2: PremultiplySse2(bgra, pixelCount); break;
+#endif
+    default:        PremultiplyScalar(bgra, pixelCount); break;
+    }
+}
+
+void PixelOps::BlendOverSpan(Isa isa, uint8_t* dst, const uint8_t* src, size_t pixelCount)
+{
+    switch (Clamp(isa)) {
+#if PIXELOPS_X86
+    case Isa::AVX2: BlendOverAvx2(dst, src, pixelCount); break;
+    case Isa::SSE2: BlendOverSse2(dst, src, pixelCount); break;
+#endif
+    default:        BlendOverScalar(dst, src, pixelCount); break;
+    }
+}
+
+void PixelOps::PremultiplySpanReference(uint8_t* bgra, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        uint8_t* pixel = bgra + i * 4;
+        int a = pixel[3];
+        pixel[0] = (uint8_t)(pixel[0] * a / 255);
+        pixel[1] = (uint8_t)(pixel[1] * a / 255);
+        pixel[2] = (uint8_t)(pixel[2] * a / 255);
+    }
+}
+
+void PixelOps::BlendOverSpanReference(uint8_t* dst, const uint8_t* src, size_t pixelCount)
+{
+    for (size_t i = 0; i < pixelCount; ++i)
+    {
+        uint8_t* d = dst + i * 4;
+        const uint8_t* s = src + i * 4;
+        int inv = 255 - s[3];
+        for (int c = 0; c < 4; ++c)
+            d[c] = (uint8_t)(s[c] + d[c] * inv / 255);
+    }
+}
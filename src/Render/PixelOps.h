@@ -0,0 +1,38 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// BGRA(8bit x 4) 픽셀 스팬 연산 커널
+// - 보드 프레임 합성과 헤드리스 썸네일 렌더링의 최내곽 루프
+// - SSE2 / AVX2 / 스칼라 구현은 모두 Reference 구현과 비트 단위로 동일한 결과를 냄
+// - 플랫폼 독립 (windows.h / OpenCV 의존 없음)
+namespace PixelOps
+{
+    enum class Isa
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // 현재 CPU에서 사용할 수 있는 가장 빠른 구현
+    Isa BestIsa();
+    const char* IsaName(Isa isa);
+
+    // 알파 프리멀티플라이 (in-place)
+    // (B,G,R) = (B*A/255, G*A/255, R*A/255), A는 유지. 나눗셈은 버림(truncate).
+    void PremultiplySpan(uint8_t* bgra, size_t pixelCount);
+
+    // 프리멀티플라이된 src를 dst 위에 합성 (Porter-Duff source-over)
+    // dst = src + dst * (255 - srcA) / 255 (네 채널 모두, 버림)
+    // src는 올바른 프리멀티플라이 값(B,G,R <= A)이어야 함 (결과가 255를 넘지 않음)
+    void BlendOverSpan(uint8_t* dst, const uint8_t* src, size_t pixelCount);
+
+    // 특정 구현을 강제로 사용 (벤치마크/검증용). 지원하지 않는 ISA면 BestIsa()로 낮춤.
+    void PremultiplySpan(Isa isa, uint8_t* bgra, size_t pixelCount);
+    void BlendOverSpan(Isa isa, uint8_t* dst, const uint8_t* src, size_t pixelCount);
+
+    // 기준(Reference) 구현: 정수 나눗셈을 그대로 사용하는 가장 단순한 형태
+    void PremultiplySpanReference(uint8_t* bgra, size_t pixelCount);
+    void BlendOverSpanReference(uint8_t* dst, const uint8_t* src, size_t pixelCount);
+}
@@ -0,0 +1,139 @@
+﻿#include "SpriteSet.h"
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include "PixelOps.h"
+
+namespace
+{
+    const cv::Mat k_empty;
+
+    // Index() 순서와 동일
+    const char* const k_fileNames[SpriteSet::COUNT] = {
+        "Pawn_white.png", "Knight_white.png", "Bishop_white.png", "Rook_white.png", "Queen_white.png", "King_white.png",
+        "Pawn_black.png", "Knight_black.png", "Bishop_black.png", "Rook_black.png", "Queen_black.png", "King_black.png",
+    };
+
+    void Premultiply(cv::Mat& bgra)
+    {
+        if (bgra.isContinuous())
+        {
+            PixelOps::PremultiplySpan(bgra.data, (size_t)bgra.rows * bgra.cols);
+            return;
+        }
+        for (int y = 0; y < bgra.rows; ++y)
+            PixelOps::PremultiplySpan(bgra.ptr(y), (size_t)bgra.cols);
+    }
+}
+
+int SpriteSet::Index(const Piece& p)
+{
+    if (p.type == PieceType::None) return -1;
+    int base = (p.color == PieceColor::White) ? 0 : 6;
+    return base + (int)p.type - (int)PieceType::Pawn;
+}
+
+const char* SpriteSet::SourceFileName(int index)
+{
+    return (index >= 0 && index < COUNT) ? k_fileNames[index] : "";
+}
+
+bool SpriteSet::LoadFromDirectory(const std::string& dir, std::vector<std::string>* missing)
+{
+    bool any = false;
+    for (int i = 0; i < COUNT; ++i)
+    {
+        std::string path = dir;
+        if (!path.empty() && path.back() != '/' && path.back() != '\\') path += '/';
+        path += k_fileNames[i];
+
+        // [중요] 알파 채널(투명도)을 포함하여 로드 (IMREAD_UNCHANGED)
+        cv::Mat img = cv::imread(path, cv::IMREAD_UNCHANGED);
+        if (img.empty())
+        {
+            if (missing) missing->push_back(path);
+            continue;
+        }
+        Piece p((PieceType)((int)PieceType::Pawn + i % 6), (i < 6) ? PieceColor::White : PieceColor::Black);
+        SetSource(p, img);
+        any = true;
+    }
+    return any;
+}
+
+void SpriteSet::SetSource(const Piece& p, const cv::Mat& image)
+{
+    int idx = Index(p);
+    if (idx < 0) return;
+
+    // 이미지가 3채널(BGR)이라면 4채널(BGRA)로 변환하여 통일
+    if (image.channels() == 3)
+        cv::cvtColor(image, m_sources[idx], cv::COLOR_BGR2BGRA);
+    else
+        m_sources[idx] = image;
+}
+
+bool SpriteSet::HasSources() const
+{
+    for (const auto& src : m_sources)
+        if (!src.empty()) return true;
+    return false;
+}
+
+// 원본 BGRA -> 프리멀티플라이 -> tileSize로 리샘플링
+// 프리멀티플라이를 리샘플링보다 먼저 해야 투명 영역의 색이 가장자리로 번지지 않습니다.
+void SpriteSet::Build(int tileSize)
+{
+    m_tileSize = tileSize;
+    if (HasAtlas())
+    {
+        BuildFromAtlas(tileSize);
+        return;
+    }
+    for (int i = 0; i < COUNT; ++i)
+    {
+        m_sprites[i].release();
+        if (tileSize <= 0 || m_sources[i].empty()) continue;
+
+        cv::Mat premul = m_sources[i].clone();
+        Premultiply(premul);
+
+        int interp = (premul.cols > tileSize) ? cv::INTER_AREA : cv::INTER_LINEAR;
+        cv::resize(premul, m_sprites[i], cv::Size(tileSize, tileSize), 0, 0, interp);
+    }
+}
+
+bool SpriteSet::AttachAtlas(const void* data, size_t size)
+{
+    if (!m_atlas.Attach(data, size)) return false;
+    if (m_tileSize > 0) Build(m_tileSize);
+    return true;
+}
+
+// 아틀라스 레벨은 이미 프리멀티플라이 + 리샘플링된 상태
+// 같은 크기 레벨이 있으면 그 메모리를 그대로 가리키고 (읽기 전용: BoardCompositor는 스프라이트를 쓰지 않음),
+// 없으면 가장 가까운 큰 레벨을 리샘플링 (프리멀티플라이된 데이터라 바로 보간해도 됨)
+void SpriteSet::BuildFromAtlas(int tileSize)
+{
+    int level = m_atlas.FindLevel(tileSize);
+    int levelSize = m_atlas.LevelTileSize(level);
+    for (int i = 0; i < COUNT; ++i)
+    {
+        m_sprites[i].release();
+        if (tileSize <= 0) continue;
+
+        cv::Mat view(levelSize, levelSize, CV_8UC4, const_cast<uint8_t*>(m_atlas.Pixels(level, i)));
+        if (levelSize == tileSize)
+        {
+            m_sprites[i] = view;
+            continue;
+        }
+        int interp = (levelSize > tileSize) ? cv::INTER_AREA : cv::INTER_LINEAR;
+        cv::resize(view, m_sprites[i], cv::Size(tileSize, tileSize), 0, 0, interp);
+    }
+}
+
+const cv::Mat& SpriteSet::Get(const Piece& p) const
+{
+    int idx = Index(p);
+    return (idx < 0) ? k_empty : m_sprites[idx];
+}
@@ -0,0 +1,51 @@
+﻿#pragma once
+#include <array>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+#include "../ChessCore/Piece.h"
+#include "PieceAtlas.h"
+
+// 기물 스프라이트 캐시 (플랫폼 독립)
+// 원본 이미지를 프리멀티플라이 + tileSize로 리샘플링(INTER_AREA)해 둔 BGRA(CV_8UC4) 이미지.
+// tileSize가 바뀔 때만 Build()로 재생성합니다.
+// [추가] 구운 아틀라스가 붙어 있으면 원본 이미지 대신 아틀라스를 씀 (같은 크기 레벨이면 복사 없이 참조)
+class SpriteSet
+{
+public:
+    static const int COUNT = 12;
+
+    // 백 0~5, 흑 6~11 (Pawn, Knight, Bishop, Rook, Queen, King 순). None이면 -1
+    static int Index(const Piece& p);
+
+    // assets/pieces 의 파일 이름 (예: "Pawn_white.png")
+    static const char* SourceFileName(int index);
+
+    // dir 아래의 12개 기물 PNG를 원본으로 로드. 실패한 파일 경로는 missing에 추가.
+    // 하나라도 로드되면 true
+    bool LoadFromDirectory(const std::string& dir, std::vector<std::string>* missing = nullptr);
+
+    // 원본 이미지 등록 (BGR 또는 BGRA, 프리멀티플라이 전)
+    void SetSource(const Piece& p, const cv::Mat& image);
+    bool HasSources() const;
+
+    // [추가] PieceAtlas 덩어리를 원본으로 사용 (data는 SpriteSet보다 오래 살아야 함, 예: 실행 파일 리소스)
+    // 형식이 맞지 않으면 false (기존 원본 유지)
+    bool AttachAtlas(const void* data, size_t size);
+    bool HasAtlas() const { return !m_atlas.Empty(); }
+
+    void Build(int tileSize);
+    int TileSize() const { return m_tileSize; }
+
+    // 현재 tileSize의 프리멀티플라이된 스프라이트 (없으면 빈 Mat)
+    const cv::Mat& Get(const Piece& p) const;
+    const cv::Mat& Get(int index) const { return m_sprites[index]; }
+
+private:
+    std::array<cv::Mat, COUNT> m_sources;
+    std::array<cv::Mat, COUNT> m_sprites;
+    PieceAtlas m_atlas;
+    int m_tileSize = 0;
+
+    void BuildFromAtlas(int tileSize);
+};
@@ -0,0 +1,114 @@
+﻿#include "ThumbnailRenderer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+#include "BoardCompositor.h"
+#include "../ChessCore/Board.h"
+#include "../ChessCore/Fen.h"
+
+// 작업 스레드별 스크래치 버퍼
+struct ThumbnailRenderer::Worker
+{
+    Board board;
+    BoardCompositor compositor;
+    cv::Mat bgr;
+};
+
+ThumbnailRenderer::ThumbnailRenderer(const SpriteSet& sources, const ThumbnailOptions& options)
+    : m_sprites(sources), m_options(options)
+{
+    // 이미지 = 타일 8개 + 양쪽 프레임(tileSize / 3)
+    m_tileSize = std::max(4, m_options.size * 3 / 26);
+    m_imageSize = m_tileSize * 8 + (m_tileSize / 3) * 2;
+    m_sprites.Build(m_tileSize);
+
+    if (m_options.format == "jpg" || m_options.format == "jpeg") {
+        m_options.format = "jpg";
+        m_encodeParams = { cv::IMWRITE_JPEG_QUALITY, m_options.jpegQuality };
+    }
+    else {
+        m_options.format = "png";
+        m_encodeParams = { cv::IMWRITE_PNG_COMPRESSION, m_options.pngCompression };
+    }
+}
+
+const char* ThumbnailRenderer::Extension() const
+{
+    return (m_options.format == "jpg") ? ".jpg" : ".png";
+}
+
+bool ThumbnailRenderer::RenderWith(Worker& worker, const std::string& fen, std::vector<unsigned char>& encoded) const
+{
+    bool isWhiteTurn = true;
+    if (!Fen::FENToBoard(fen, worker.board, isWhiteTurn)) return false;
+
+    BoardScene scene;
+    scene.board = &worker.board;
+    worker.compositor.Compose(scene);
+
+    // 프레임버퍼는 불투명하므로 알파를 버리고 3채널로 인코딩 (파일 크기/속도)
+    cv::cvtColor(worker.compositor.Framebuffer(), worker.bgr, cv::COLOR_BGRA2BGR);
+    return cv::imencode(Extension(), worker.bgr, encoded, m_encodeParams);
+}
+
+bool ThumbnailRenderer::Render(const std::string& fen, std::vector<unsigned char>& encoded) const
+{
+    Worker worker;
+    worker.compositor.Resize(m_imageSize, m_imageSize, m_tileSize);
+    worker.compositor.SetSprites(&m_sprites);
+    return RenderWith(worker, fen, encoded);
+}
+
+ThumbnailBatchResult ThumbnailRenderer::RenderBatch(const std::vector<std::string>& fens, const Sink& sink) const
+{
+    ThumbnailBatchResult result;
+    auto t0 = std::chrono::steady_clock::now();
+
+    int threadCount = m_options.threads;
+    if (threadCount <= 0) threadCount = (int)std::max(1u, std::thread::hardware_concurrency());
+    threadCount = (int)std::min<size_t>((size_t)threadCount, std::max<size_t>(1, fens.size()));
+
+    // 작은 청크 단위로 가져가서 스레드 간 부하를 맞춤
+    const size_t chunk = 16;
+    std::atomic<size_t> next{ 0 };
+    std::atomic<size_t> rendered{ 0 };
+    std::atomic<size_t> failed{ 0 };
+
+    auto run = [&]() {
+        Worker worker;
+        worker.compositor.Resize(m_imageSize, m_imageSize, m_tileSize);
+        worker.compositor.SetSprites(&m_sprites);
+        std::vector<unsigned char> encoded;
+        size_t ok = 0, bad = 0;
+
+        for (;;) {
+            size_t begin = next.fetch_add(chunk);
+            if (begin >= fens.size()) break;
+            size_t end = std::min(begin + chunk, fens.size());
+            for (size_t i = begin; i < end; ++i) {
+                if (RenderWith(worker, fens[i], encoded)) {
+                    if (sink) sink(i, encoded);
+                    ++ok;
+                }
+                else {
+                    ++bad;
+                }
+            }
+        }
+        rendered += ok;
+        failed += bad;
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threadCount; ++i) pool.emplace_back(run);
+    run(); // 호출 스레드도 작업에 참여
+    for (auto& t : pool) t.join();
+
+    result.rendered = rendered;
+    result.failed = failed;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return result;
+}
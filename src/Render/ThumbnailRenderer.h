@@ -0,0 +1,57 @@
+﻿#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "SpriteSet.h"
+
+// 헤드리스 FEN -> PNG/JPEG 보드 썸네일 렌더러 (디스플레이 불필요)
+// - 스프라이트는 생성 시 한 번 스케일링한 뒤 모든 스레드가 읽기 전용으로 공유
+// - 작업 스레드마다 Board / BoardCompositor / 인코딩 버퍼를 재사용
+//   (연속된 포지션은 바뀐 칸만 다시 합성됨)
+struct ThumbnailOptions
+{
+    int size = 256;             // 출력 이미지 한 변의 대략적인 크기 (px)
+    std::string format = "png"; // "png" 또는 "jpg"
+    int jpegQuality = 90;
+    int pngCompression = 1;     // 0~9, 처리량 우선으로 낮게
+    int threads = 0;            // 0이면 std::thread::hardware_concurrency()
+};
+
+struct ThumbnailBatchResult
+{
+    size_t rendered = 0;
+    size_t failed = 0;   // FEN 파싱/인코딩 실패
+    double seconds = 0.0;
+};
+
+class ThumbnailRenderer
+{
+public:
+    // 인코딩된 이미지 하나를 받는 콜백 (작업 스레드에서 동시에 호출됨)
+    using Sink = std::function<void(size_t index, const std::vector<unsigned char>& encoded)>;
+
+    // sources: 원본 이미지가 로드된 SpriteSet (SpriteSet::LoadFromDirectory)
+    ThumbnailRenderer(const SpriteSet& sources, const ThumbnailOptions& options);
+
+    int TileSize() const { return m_tileSize; }
+    int ImageSize() const { return m_imageSize; }
+    const char* Extension() const;
+
+    // 단일 FEN 렌더링 (스레드 스크래치 없이, 호출 스레드에서)
+    bool Render(const std::string& fen, std::vector<unsigned char>& encoded) const;
+
+    // fens[i]를 병렬로 렌더링해서 sink(i, bytes)로 전달
+    ThumbnailBatchResult RenderBatch(const std::vector<std::string>& fens, const Sink& sink) const;
+
+private:
+    struct Worker;
+
+    SpriteSet m_sprites; // 생성 후 불변 (스레드 간 공유)
+    ThumbnailOptions m_options;
+    std::vector<int> m_encodeParams;
+    int m_tileSize = 0;
+    int m_imageSize = 0;
+
+    bool RenderWith(Worker& worker, const std::string& fen, std::vector<unsigned char>& encoded) const;
+};
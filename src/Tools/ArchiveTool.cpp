@@ -0,0 +1,282 @@
+﻿// 이진 기보 보관 파일(.cgar) 도구: PGN 변환 / 병렬 디코딩 통계 / 대국 하나 꺼내기
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 -pthread src/Tools/ArchiveTool.cpp src/ChessCore/*.cpp src/Utils/Trace.cpp -o game_archive
+// 실행:
+//   ./game_archive pack <in.pgn> <out.cgar> [--block 1024]
+//   ./game_archive stats <in.cgar> [--threads 0]
+//   ./game_archive show <in.cgar> <game-number>
+//
+// PGN은 FEN / Result 태그와 본문 수만 사용 (주석, 변화수, NAG는 건너뜀).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ChessCore/Board.h"
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/GameArchive.h"
+#include "../ChessCore/Notation.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: game_archive pack <in.pgn> <out.cgar> [--block N]\n"
+            "       game_archive stats <in.cgar> [--threads N]\n"
+            "       game_archive show <in.cgar> <game-number>\n");
+    }
+
+    ArchiveResult ParseResult(const std::string& s)
+    {
+        if (s == "1-0") return ArchiveResult::WhiteWins;
+        if (s == "0-1") return ArchiveResult::BlackWins;
+        if (s == "1/2-1/2") return ArchiveResult::Draw;
+        return ArchiveResult::Unknown;
+    }
+
+    const char* ResultString(ArchiveResult r)
+    {
+        switch (r) {
+        case ArchiveResult::WhiteWins: return "1-0";
+        case ArchiveResult::BlackWins: return "0-1";
+        case ArchiveResult::Draw:      return "1/2-1/2";
+        default:                       return "*";
+        }
+    }
+
+    // 태그 한 줄: [Name "Value"]
+    bool ParseTag(const std::string& line, std::string& name, std::string& value)
+    {
+        size_t q1 = line.find('"');
+        size_t q2 = line.rfind('"');
+        if (line.size() < 4 || q1 == std::string::npos || q2 <= q1) return false;
+        std::istringstream iss(line.substr(1, q1 - 1));
+        iss >> name;
+        value = line.substr(q1 + 1, q2 - q1 - 1);
+        return true;
+    }
+
+    // PGN 대국 하나씩 읽기. 수는 SAN -> 합법수로 바꾸며 둬 봄
+    class PgnReader
+    {
+    public:
+        explicit PgnReader(std::istream& in) : m_in(in) {}
+
+        // 더 읽을 대국이 없으면 false. 불법수를 만나면 error에 적고 그 대국은 수를 비움
+        bool Next(ArchivedGame& game, std::string& error)
+        {
+            game = ArchivedGame();
+            error.clear();
+            std::string line, movetext;
+            bool inTags = false, any = false;
+
+            while (std::getline(m_in, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] == '[') {
+                    // 본문이 끝난 뒤 새 태그가 오면 (결과 토큰이 없던 대국) 다음 대국의 시작
+                    if (!movetext.empty() && !inTags) { m_pendingTag = line; break; }
+                    if (!m_pendingTag.empty()) { ApplyTag(m_pendingTag, game); m_pendingTag.clear(); }
+                    ApplyTag(line, game);
+                    inTags = any = true;
+                    continue;
+                }
+                if (!m_pendingTag.empty()) { ApplyTag(m_pendingTag, game); m_pendingTag.clear(); any = true; }
+                inTags = false;
+                if (line.empty() || line[0] == '%') continue;
+                movetext += line;
+                movetext += '\n';
+                any = true;
+                if (EndsWithResult(line)) break;
+            }
+            if (!any && m_pendingTag.empty()) return false;
+            if (!m_pendingTag.empty() && movetext.empty()) { ApplyTag(m_pendingTag, game); m_pendingTag.clear(); }
+            ParseMoves(movetext, game, error);
+            return true;
+        }
+
+    private:
+        static void ApplyTag(const std::string& line, ArchivedGame& game)
+        {
+            std::string name, value;
+            if (!ParseTag(line, name, value)) return;
+            if (name == "FEN") game.startFen = value;
+            else if (name == "Result") game.result = ParseResult(value);
+        }
+
+        static bool EndsWithResult(const std::string& line)
+        {
+            std::istringstream iss(line);
+            std::string tok, last;
+            while (iss >> tok) last = tok;
+            return last == "1-0" || last == "0-1" || last == "1/2-1/2" || last == "*";
+        }
+
+        void ParseMoves(const std::string& text, ArchivedGame& game, std::string& error)
+        {
+            Board board;
+            bool isWhiteTurn = true;
+            if (!game.startFen.empty() && !Fen::FENToBoard(game.startFen, board, isWhiteTurn)) {
+                error = "invalid FEN tag";
+                return;
+            }
+
+            std::string token;
+            int depth = 0;       // 변화수 ( ) 깊이
+            bool comment = false;
+            auto flush = [&]() {
+                if (token.empty() || !error.empty()) { token.clear(); return; }
+                std::string t = token;
+                token.clear();
+                if (t[0] == '$' || ParseResult(t) != ArchiveResult::Unknown || t == "*") return;
+                size_t dot = t.find_last_of('.');
+                if (dot != std::string::npos) t = t.substr(dot + 1); // "12.e4" / "12..."
+                if (t.empty()) return;
+
+                Move mv{};
+                if (!Notation::MoveFromSAN(board, t, isWhiteTurn, m_logic, mv)) {
+                    error = "illegal move " + t;
+                    return;
+                }
+                game.moves.push_back(mv);
+                m_logic.ApplyMove(board, mv, isWhiteTurn);
+                isWhiteTurn = !isWhiteTurn;
+            };
+
+            for (size_t i = 0; i < text.size(); ++i) {
+                char c = text[i];
+                if (comment) { if (c == '}') comment = false; continue; }
+                if (c == '{') { flush(); comment = true; continue; }
+                if (c == ';') { flush(); while (i < text.size() && text[i] != '\n') ++i; continue; }
+                if (c == '(') { flush(); ++depth; continue; }
+                if (c == ')') { flush(); if (depth > 0) --depth; continue; }
+                if (depth > 0) continue;
+                if (c == ' ' || c == '\t' || c == '\n') { flush(); continue; }
+                token += c;
+            }
+            flush();
+            if (!error.empty()) game.moves.clear();
+        }
+
+        std::istream& m_in;
+        std::string m_pendingTag;
+        GameLogic m_logic;
+    };
+
+    int Pack(const std::string& inPath, const std::string& outPath, uint32_t gamesPerBlock)
+    {
+        std::ifstream in(inPath);
+        if (!in) { std::fprintf(stderr, "cannot read %s\n", inPath.c_str()); return 1; }
+        GameArchiveWriter writer;
+        if (!writer.Open(outPath, gamesPerBlock)) { std::fprintf(stderr, "cannot write %s\n", outPath.c_str()); return 1; }
+
+        PgnReader reader(in);
+        ArchivedGame game;
+        std::string error;
+        uint64_t index = 0, skipped = 0;
+        while (reader.Next(game, error)) {
+            ++index;
+            if (!error.empty() || !writer.Append(game)) {
+                std::fprintf(stderr, "game %llu skipped: %s\n", (unsigned long long)index, error.empty() ? "cannot encode" : error.c_str());
+                ++skipped;
+            }
+        }
+        uint64_t games = writer.GameCount(), moves = writer.MoveCount();
+        if (!writer.Close()) { std::fprintf(stderr, "write failed\n"); return 1; }
+
+        in.clear();
+        in.seekg(0, std::ios::end);
+        double pgnBytes = (double)in.tellg();
+        std::ifstream out(outPath, std::ios::binary | std::ios::ate);
+        double outBytes = (double)out.tellg();
+        std::printf("%llu games, %llu moves (%llu skipped)\n", (unsigned long long)games, (unsigned long long)moves, (unsigned long long)skipped);
+        std::printf("PGN %.0f bytes -> %.0f bytes (%.1fx), %.2f bits/move\n", pgnBytes, outBytes,
+            outBytes > 0 ? pgnBytes / outBytes : 0.0, moves ? outBytes * 8.0 / moves : 0.0);
+        return 0;
+    }
+
+    int Stats(const std::string& path, int threads)
+    {
+        GameArchiveReader reader;
+        if (!reader.Open(path)) { std::fprintf(stderr, "cannot open %s\n", path.c_str()); return 1; }
+        if (threads <= 0) threads = (int)std::max(1u, std::thread::hardware_concurrency());
+
+        std::atomic<uint64_t> games{ 0 }, moves{ 0 };
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = reader.DecodeParallel(threads, [&](size_t, const std::vector<ArchivedGame>& block) {
+            uint64_t n = 0;
+            for (const auto& g : block) n += g.moves.size();
+            games += block.size();
+            moves += n;
+        });
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::printf("%zu blocks, %llu games, %llu moves%s\n", reader.BlockCount(), (unsigned long long)games.load(),
+            (unsigned long long)moves.load(), ok ? "" : " (corrupt blocks skipped)");
+        std::printf("decoded + replayed in %.2f s with %d threads: %.0f moves/s\n", sec, threads, sec > 0 ? moves / sec : 0.0);
+        return ok ? 0 : 1;
+    }
+
+    int Show(const std::string& path, uint64_t number)
+    {
+        GameArchiveReader reader;
+        if (!reader.Open(path)) { std::fprintf(stderr, "cannot open %s\n", path.c_str()); return 1; }
+        ArchivedGame game;
+        if (number < 1 || !reader.ReadGame(number - 1, game)) { std::fprintf(stderr, "no game %llu\n", (unsigned long long)number); return 1; }
+
+        Board board;
+        bool isWhiteTurn = true;
+        if (!game.startFen.empty()) {
+            Fen::FENToBoard(game.startFen, board, isWhiteTurn);
+            std::printf("[FEN \"%s\"]\n", game.startFen.c_str());
+        }
+        std::printf("[Result \"%s\"]\n\n", ResultString(game.result));
+
+        GameLogic logic;
+        int moveNo = 1;
+        for (size_t i = 0; i < game.moves.size(); ++i) {
+            if (isWhiteTurn) std::printf("%d. ", moveNo);
+            else if (i == 0) std::printf("%d... ", moveNo);
+            std::printf("%s ", Notation::MoveToSAN(board, game.moves[i], isWhiteTurn, logic).c_str());
+            logic.ApplyMove(board, game.moves[i], isWhiteTurn);
+            if (!isWhiteTurn) ++moveNo;
+            isWhiteTurn = !isWhiteTurn;
+        }
+        std::printf("%s\n", ResultString(game.result));
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { PrintUsage(); return 2; }
+    std::string command = argv[1];
+
+    if (command == "pack" && argc >= 4) {
+        uint32_t block = 1024;
+        for (int i = 4; i + 1 < argc; i += 2) {
+            if (std::string(argv[i]) == "--block") block = (uint32_t)std::atoi(argv[i + 1]);
+            else { PrintUsage(); return 2; }
+        }
+        return Pack(argv[2], argv[3], block);
+    }
+    if (command == "stats") {
+        int threads = 0;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::string(argv[i]) == "--threads") threads = std::atoi(argv[i + 1]);
+            else { PrintUsage(); return 2; }
+        }
+        return Stats(argv[2], threads);
+    }
+    if (command == "show" && argc == 4) return Show(argv[2], std::strtoull(argv[3], nullptr, 10));
+
+    PrintUsage();
+    return 2;
+}
@@ -0,0 +1,121 @@
+﻿// 기물 PNG -> 실행 파일에 넣을 PieceAtlas 덩어리 (빌드 단계에서 실행, 헤드리스)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++14 src/Tools/AtlasBaker.cpp src/Render/PieceAtlas.cpp src/Render/SpriteSet.cpp
+//       src/Render/PixelOps.cpp $(pkg-config --cflags --libs opencv4) -o atlas_baker
+// 빌드 (Windows): ChessProject.vcxproj의 BuildAtlasBaker / BakePieceAtlas 타깃이
+//   소스나 PNG가 바뀌었을 때만 cl로 $(IntDir)AtlasBaker\에 다시 빌드하고 실행
+// 실행:
+//   ./atlas_baker <pieces-dir> <out.atlas> [--sizes 40,48,56,64,72,80,96,112,128]
+//
+// 레벨마다 SpriteSet::Build와 같은 경로(프리멀티플라이 -> INTER_AREA)로 만들므로
+// 런타임에 원본 PNG로 만든 스프라이트와 비트 단위로 같습니다.
+// 결과가 기존 파일과 같으면 파일을 건드리지 않음 (리소스가 매번 다시 컴파일되지 않도록).
+// 기물 이미지가 하나라도 없으면 실패 (빠진 기물이 있는 아틀라스를 굽지 않음).
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../Render/PieceAtlas.h"
+#include "../Render/SpriteSet.h"
+
+namespace
+{
+    // 창 크기에 따라 타일은 연속적으로 변하므로, 흔한 크기 주변을 촘촘하게 (기본 창 = 80)
+    const int k_defaultSizes[] = { 40, 48, 56, 64, 72, 80, 96, 112, 128 };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr, "usage: atlas_baker <pieces-dir> <out.atlas> [--sizes N,N,...]\n");
+    }
+
+    bool ParseSizes(const char* text, std::vector<int>& sizes)
+    {
+        sizes.clear();
+        for (const char* p = text; *p; )
+        {
+            char* end = nullptr;
+            long v = std::strtol(p, &end, 10);
+            if (end == p || v <= 0) return false;
+            if (*end != ',' && *end != '\0') return false;
+            sizes.push_back((int)v);
+            p = (*end == ',') ? end + 1 : end;
+        }
+        return !sizes.empty();
+    }
+
+    bool SameAsFile(const std::string& path, const std::vector<uint8_t>& data)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::vector<uint8_t> old((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        return old == data;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { PrintUsage(); return 2; }
+    std::string pieceDir = argv[1];
+    std::string outPath = argv[2];
+    std::vector<int> sizes(std::begin(k_defaultSizes), std::end(k_defaultSizes));
+
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--sizes") == 0 && i + 1 < argc)
+        {
+            if (!ParseSizes(argv[++i], sizes)) { PrintUsage(); return 2; }
+        }
+        else { PrintUsage(); return 2; }
+    }
+
+    SpriteSet sprites;
+    std::vector<std::string> missing;
+    sprites.LoadFromDirectory(pieceDir, &missing);
+    if (!missing.empty())
+    {
+        for (const auto& path : missing) std::fprintf(stderr, "error: cannot load %s\n", path.c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> blob;
+    if (!PieceAtlas::Create(sizes, blob))
+    {
+        std::fprintf(stderr, "error: tile sizes must be ascending, 1..1024, at most %d levels\n", PieceAtlas::k_maxLevels);
+        return 2;
+    }
+    PieceAtlas atlas;
+    atlas.Attach(blob.data(), blob.size());
+
+    for (int level = 0; level < atlas.LevelCount(); ++level)
+    {
+        int tile = atlas.LevelTileSize(level);
+        sprites.Build(tile);
+        for (int i = 0; i < SpriteSet::COUNT; ++i)
+        {
+            const cv::Mat& sprite = sprites.Get(i);
+            uint8_t* dst = blob.data() + atlas.PixelOffset(level, i);
+            for (int y = 0; y < tile; ++y)
+                std::memcpy(dst + (size_t)y * tile * 4, sprite.ptr(y), (size_t)tile * 4);
+        }
+    }
+
+    if (SameAsFile(outPath, blob))
+    {
+        std::printf("%s is up to date\n", outPath.c_str());
+        return 0;
+    }
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    out.write((const char*)blob.data(), (std::streamsize)blob.size());
+    if (!out)
+    {
+        std::fprintf(stderr, "error: cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("%s: %d levels, %zu bytes\n", outPath.c_str(), atlas.LevelCount(), blob.size());
+    return 0;
+}
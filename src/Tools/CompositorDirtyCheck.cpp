@@ -0,0 +1,256 @@
+﻿// BoardCompositor dirty rect 헤드리스 검사 (디스플레이 불필요)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 src/Tools/CompositorDirtyCheck.cpp src/Render/BoardCompositor.cpp src/Render/SpriteSet.cpp
+//       src/Render/PieceAtlas.cpp src/Render/PixelOps.cpp src/ChessCore/*.cpp src/Utils/Trace.cpp
+//       $(pkg-config --cflags --libs opencv4) -o compositor_dirty_check
+// 실행:
+//   ./compositor_dirty_check
+//
+// 수 두기(애니메이션 포함) / 드래그 한 걸음 / 선택·힌트·위협 표시 변경이 각각 어느 사각형을 무효화하는지 확인하고,
+// 매 프레임 결과가 새 합성기로 처음부터 그린 프레임과 픽셀 단위로 같은지(빠진 dirty rect가 없는지)도 봅니다.
+// 하나라도 어긋나면 0이 아닌 값으로 종료합니다.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "../ChessCore/Fen.h"
+#include "../Render/BoardCompositor.h"
+#include "../Render/SpriteSet.h"
+
+namespace
+{
+    const int k_tile = 64;
+    const int k_width = 640;
+    const int k_height = 600;
+    const int k_origin = k_tile / 3; // BoardCompositor::BoardOrigin
+    const int k_pen = 3;             // 선택 테두리 두께
+
+    const char* k_startFen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+    const char* k_afterE4Fen = "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1";
+
+    int g_failures = 0;
+
+    // 합성기와 같은 배치 규칙으로 기대값을 만듦
+    cv::Rect Square(int x, int y) { return cv::Rect(k_origin + x * k_tile, k_origin + y * k_tile, k_tile, k_tile); }
+    cv::Rect Selection(int x, int y)
+    {
+        cv::Rect sq = Square(x, y);
+        int half = k_pen / 2;
+        return cv::Rect(sq.x - half, sq.y - half, sq.width + half * 2, sq.height + half * 2);
+    }
+    cv::Rect Hint(int x, int y)
+    {
+        int r = k_tile / 6;
+        int cx = k_origin + x * k_tile + k_tile / 2;
+        int cy = k_origin + y * k_tile + k_tile / 2;
+        return cv::Rect(cx - r, cy - r, r * 2 + 1, r * 2 + 1);
+    }
+    cv::Rect Drag(int screenX, int screenY)
+    {
+        return cv::Rect(k_origin + screenX - k_tile / 2, k_origin + screenY - k_tile / 2, k_tile, k_tile);
+    }
+
+    std::string Describe(const std::vector<cv::Rect>& rects)
+    {
+        std::string s;
+        char buf[64];
+        for (const auto& r : rects) {
+            std::snprintf(buf, sizeof(buf), " (%d,%d %dx%d)", r.x, r.y, r.width, r.height);
+            s += buf;
+        }
+        return s.empty() ? " (none)" : s;
+    }
+
+    std::vector<cv::Rect> Sorted(std::vector<cv::Rect> rects)
+    {
+        std::sort(rects.begin(), rects.end(), [](const cv::Rect& a, const cv::Rect& b) {
+            return std::make_tuple(a.y, a.x, a.height, a.width) < std::make_tuple(b.y, b.x, b.height, b.width);
+            });
+        return rects;
+    }
+
+    bool SameRects(const std::vector<cv::Rect>& a, const std::vector<cv::Rect>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].width != b[i].width || a[i].height != b[i].height) return false;
+        return true;
+    }
+
+    bool SameFrame(const cv::Mat& a, const cv::Mat& b)
+    {
+        if (a.rows != b.rows || a.cols != b.cols) return false;
+        for (int y = 0; y < a.rows; ++y)
+            if (std::memcmp(a.ptr(y), b.ptr(y), (size_t)a.cols * 4) != 0) return false;
+        return true;
+    }
+
+    // 색이 서로 다른 반투명 단색 타일 (이미지 파일 없이)
+    void MakeSprites(SpriteSet& sprites)
+    {
+        const PieceType types[] = { PieceType::Pawn, PieceType::Knight, PieceType::Bishop, PieceType::Rook, PieceType::Queen, PieceType::King };
+        for (int c = 0; c < 2; ++c)
+            for (int i = 0; i < 6; ++i) {
+                Piece p(types[i], c == 0 ? PieceColor::White : PieceColor::Black);
+                cv::Mat image(k_tile, k_tile, CV_8UC4, cv::Scalar(40 * i, c ? 60 : 220, 255 - 40 * i, 200));
+                sprites.SetSource(p, image);
+            }
+        sprites.Build(k_tile);
+    }
+
+    class Harness
+    {
+    public:
+        explicit Harness(const SpriteSet& sprites) : m_sprites(sprites)
+        {
+            m_compositor.Resize(k_width, k_height, k_tile);
+            m_compositor.SetSprites(&sprites);
+        }
+
+        // scene을 합성하고 dirty rect가 want와 같은지, 프레임이 처음부터 그린 것과 같은지 확인
+        void Expect(const char* what, const BoardScene& scene, const std::vector<cv::Rect>& want)
+        {
+            std::vector<cv::Rect> got = Sorted(m_compositor.Compose(scene));
+            std::vector<cv::Rect> expected = Sorted(want);
+            if (!SameRects(got, expected)) {
+                std::printf("  FAIL %s\n    got: %s\n    want:%s\n", what, Describe(got).c_str(), Describe(expected).c_str());
+                ++g_failures;
+            }
+
+            BoardCompositor fresh;
+            fresh.Resize(k_width, k_height, k_tile);
+            fresh.SetSprites(&m_sprites);
+            fresh.Compose(scene);
+            if (!SameFrame(m_compositor.Framebuffer(), fresh.Framebuffer())) {
+                std::printf("  FAIL %s: framebuffer differs from a full redraw\n", what);
+                ++g_failures;
+            }
+        }
+
+    private:
+        const SpriteSet& m_sprites;
+        BoardCompositor m_compositor;
+    };
+
+    // 수 두기: 바뀐 두 칸만. 애니메이션이면 스프라이트의 이전/새 위치
+    void CheckMove(const SpriteSet& sprites)
+    {
+        std::printf("move\n");
+        Board start, afterE4;
+        bool white = true;
+        Fen::FENToBoard(k_startFen, start, white);
+        Fen::FENToBoard(k_afterE4Fen, afterE4, white);
+
+        {
+            Harness h(sprites);
+            BoardScene scene;
+            scene.board = &start;
+            h.Expect("first frame", scene, { cv::Rect(0, 0, k_width, k_height) });
+            h.Expect("unchanged scene", scene, {});
+            scene.board = &afterE4;
+            h.Expect("e2-e4 without animation", scene, { Square(4, 6), Square(4, 4) });
+        }
+        {
+            Harness h(sprites);
+            BoardScene scene;
+            scene.board = &start;
+            h.Expect("first frame", scene, { cv::Rect(0, 0, k_width, k_height) });
+
+            // GuiManager처럼 수를 둔 보드 + 출발 칸에서 시작하는 애니메이션 (도착 칸은 스프라이트가 대신 그림)
+            scene.board = &afterE4;
+            scene.anim.active = true;
+            scene.anim.fromX = 4; scene.anim.fromY = 6;
+            scene.anim.toX = 4; scene.anim.toY = 4;
+            scene.anim.movingPiece = Piece(PieceType::Pawn, PieceColor::White);
+            h.Expect("animation start", scene, { Square(4, 6) });
+            scene.anim.progress = 0.5;
+            h.Expect("animation step", scene, { Square(4, 6), Square(4, 5) });
+            scene.anim.active = false;
+            h.Expect("animation end", scene, { Square(4, 5), Square(4, 4) });
+        }
+    }
+
+    // 드래그: 겹치는 한 걸음은 합친 사각형 하나, 멀리 뛰면 둘
+    void CheckDrag(const SpriteSet& sprites)
+    {
+        std::printf("drag\n");
+        Board start;
+        bool white = true;
+        Fen::FENToBoard(k_startFen, start, white);
+
+        Harness h(sprites);
+        BoardScene scene;
+        scene.board = &start;
+        h.Expect("first frame", scene, { cv::Rect(0, 0, k_width, k_height) });
+
+        scene.dragging = true;
+        scene.dragPiece = Piece(PieceType::Knight, PieceColor::White);
+        scene.dragScreenX = 200; scene.dragScreenY = 300;
+        h.Expect("drag start", scene, { Drag(200, 300) });
+        scene.dragScreenX = 205; scene.dragScreenY = 303;
+        h.Expect("small drag step", scene, { Drag(200, 300) | Drag(205, 303) });
+        h.Expect("no mouse movement", scene, {});
+        scene.dragScreenX = 400; scene.dragScreenY = 100;
+        h.Expect("large drag step", scene, { Drag(205, 303), Drag(400, 100) });
+        scene.dragging = false;
+        h.Expect("drop", scene, { Drag(400, 100) });
+    }
+
+    // 선택 / 힌트 / 위협 표시: 바뀐 항목의 이전 + 새 영역만
+    void CheckHighlights(const SpriteSet& sprites)
+    {
+        std::printf("highlights\n");
+        Board start;
+        bool white = true;
+        Fen::FENToBoard(k_startFen, start, white);
+
+        Harness h(sprites);
+        BoardScene scene;
+        scene.board = &start;
+        h.Expect("first frame", scene, { cv::Rect(0, 0, k_width, k_height) });
+
+        scene.hasSelection = true;
+        scene.selX = 4; scene.selY = 6;
+        scene.hints = { { 4, 5 }, { 4, 4 } };
+        h.Expect("select e2", scene, { Selection(4, 6), Hint(4, 5), Hint(4, 4) });
+
+        // 이웃 칸 선택 테두리는 1px씩 겹쳐서 하나로 합쳐짐
+        scene.selX = 3;
+        scene.hints = { { 3, 5 }, { 3, 4 } };
+        h.Expect("select d2", scene, { Selection(4, 6) | Selection(3, 6), Hint(4, 5), Hint(4, 4), Hint(3, 5), Hint(3, 4) });
+
+        // 힌트 색(SEE 부호)만 바뀌어도 그 원 하나
+        scene.hints[1].exchange = -1;
+        h.Expect("hint colour change", scene, { Hint(3, 4) });
+
+        scene.threatMask = 1ull << (7 * 8 + 4); // e1
+        h.Expect("threat on e1", scene, { Square(4, 7) });
+
+        scene.hasSelection = false;
+        scene.hints.clear();
+        scene.threatMask = 0;
+        // d2 선택 테두리와 e1 칸은 모서리 1px이 겹쳐 하나로 합쳐짐
+        h.Expect("clear highlights", scene, { Selection(3, 6) | Square(4, 7), Hint(3, 5), Hint(3, 4) });
+    }
+}
+
+int main()
+{
+    SpriteSet sprites;
+    MakeSprites(sprites);
+
+    CheckMove(sprites);
+    CheckDrag(sprites);
+    CheckHighlights(sprites);
+
+    if (g_failures) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
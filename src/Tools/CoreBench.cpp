@@ -0,0 +1,583 @@
+﻿// 규칙 엔진(ChessCore) 핫 패스 마이크로 벤치마크 (헤드리스)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 src/Tools/CoreBench.cpp src/ChessCore/*.cpp src/Utils/Trace.cpp -o core_bench
+// 실행:
+//   ./core_bench [--min-time-ms 300] [--samples 5] [--filter NAME] [--corpus FILE] [--json FILE]
+//
+// 고정 코퍼스(미들게임 / 엔드게임 / 전술 국면)에 대해 각 함수를 반복 호출하고
+// ns/op, 할당 횟수/op, (Linux perf 이벤트를 쓸 수 있으면) 캐시 미스/op를 보고합니다.
+// --json 을 주면 같은 결과를 JSON으로 저장 -> 실행 간 diff 용.
+// ChessCore 최적화는 이 결과와 비교해서 판단할 것.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include "../ChessCore/Board.h"
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/GameLogic.h"
+#include "../ChessCore/GameTree.h"
+#include "../ChessCore/MovePicker.h"
+#include "../ChessCore/PackedPosition.h"
+#include "../ChessCore/PawnStructure.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// 할당 횟수 측정: 이 실행 파일의 전역 operator new를 교체
+// ---------------------------------------------------------------------------
+namespace
+{
+    std::atomic<uint64_t> g_allocCount{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+    // -----------------------------------------------------------------------
+    // 하드웨어 카운터 (Linux perf_event_open). 권한이 없거나 다른 OS면 사용 안 함
+    // -----------------------------------------------------------------------
+    class PerfCounters
+    {
+    public:
+        enum { CacheMisses, CacheReferences, Instructions, Count };
+
+        PerfCounters()
+        {
+#if defined(__linux__)
+            static const uint64_t configs[Count] = {
+                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_INSTRUCTIONS
+            };
+            for (int i = 0; i < Count; ++i) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = configs[i];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                m_fd[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+            }
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            for (int fd : m_fd)
+                if (fd >= 0) close(fd);
+#endif
+        }
+
+        bool Available(int i) const { return m_fd[i] >= 0; }
+        bool AnyAvailable() const { return Available(0) || Available(1) || Available(2); }
+
+        void Start()
+        {
+#if defined(__linux__)
+            for (int fd : m_fd) {
+                if (fd < 0) continue;
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        void Stop(uint64_t out[Count])
+        {
+            for (int i = 0; i < Count; ++i) {
+                out[i] = 0;
+#if defined(__linux__)
+                if (m_fd[i] < 0) continue;
+                ioctl(m_fd[i], PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t value = 0;
+                if (read(m_fd[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) out[i] = value;
+#endif
+            }
+        }
+
+    private:
+        int m_fd[Count] = { -1, -1, -1 };
+    };
+
+    // -----------------------------------------------------------------------
+    // 코퍼스
+    // -----------------------------------------------------------------------
+    const char* const k_defaultCorpus[] = {
+        // 미들게임
+        "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4",
+        "r1bq1rk1/pp2bppp/2n1pn2/2pp4/3P4/2PBPN2/PP1N1PPP/R1BQ1RK1 w - - 0 8",
+        "r2q1rk1/1b2bppp/p2ppn2/1p6/3NP3/1BN1B3/PPP2PPP/R2Q1RK1 w - - 0 12",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        // 엔드게임
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "8/8/4k3/8/2K5/3R4/8/8 w - - 0 1",
+        "8/5pk1/6p1/7p/P6P/6P1/5PK1/8 w - - 0 40",
+        "6k1/5ppp/8/8/8/8/2r2PPP/4R1K1 b - - 0 30",
+        // 전술 (승급, 핀, 캐슬링 직전, 체크)
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "2r3k1/p4p2/3Rp2p/1p2P1pK/8/1P4P1/P3Q2P/1q6 b - - 0 1",
+        "6k1/pp4p1/2p5/2bp4/8/P5Pb/1P3rrP/2BRRN1K b - - 0 1",
+    };
+
+    struct Position
+    {
+        std::string fen;
+        Board board;
+        bool isWhiteTurn = true;
+        std::vector<std::pair<int, int>> ownSquares; // 둘 차례인 쪽 기물 좌표
+        std::vector<Move> legalMoves;
+    };
+
+    bool LoadCorpus(const std::string& path, std::vector<std::string>& out)
+    {
+        if (path.empty()) {
+            for (const char* fen : k_defaultCorpus) out.push_back(fen);
+            return true;
+        }
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            out.push_back(line);
+        }
+        return true;
+    }
+
+    // 컴파일러가 결과를 버리지 못하게 함
+    volatile uint64_t g_sink = 0;
+
+    struct BenchResult
+    {
+        std::string name;
+        uint64_t ops = 0;
+        double nsPerOp = 0.0;     // 샘플 중앙값
+        double nsPerOpMin = 0.0;
+        double allocsPerOp = 0.0;
+        bool hasPerf[PerfCounters::Count] = {};
+        double perfPerOp[PerfCounters::Count] = {};
+    };
+
+    struct BenchConfig
+    {
+        double minTimeMs = 300.0;
+        int samples = 5;
+    };
+
+    // pass()는 코퍼스 한 바퀴를 돌고 수행한 op 수를 반환
+    template <class Pass>
+    BenchResult Measure(const char* name, const BenchConfig& cfg, PerfCounters& perf, Pass&& pass)
+    {
+        using clock = std::chrono::steady_clock;
+        BenchResult r;
+        r.name = name;
+
+        // 워밍업 + 한 샘플에 필요한 반복 횟수 추정
+        uint64_t passes = 1;
+        double sampleTargetNs = cfg.minTimeMs * 1e6 / cfg.samples;
+        for (;;) {
+            auto t0 = clock::now();
+            for (uint64_t i = 0; i < passes; ++i) pass();
+            double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count();
+            if (ns >= sampleTargetNs / 4 || passes >= (1ull << 30)) {
+                passes = std::max<uint64_t>(1, (uint64_t)(passes * sampleTargetNs / std::max(ns, 1.0)));
+                break;
+            }
+            passes *= 2;
+        }
+
+        std::vector<double> samples;
+        uint64_t totalOps = 0;
+        uint64_t allocs0 = g_allocCount.load();
+        uint64_t counters[PerfCounters::Count] = {};
+        perf.Start();
+        for (int s = 0; s < cfg.samples; ++s) {
+            uint64_t ops = 0;
+            auto t0 = clock::now();
+            for (uint64_t i = 0; i < passes; ++i) ops += pass();
+            double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count();
+            samples.push_back(ns / (double)std::max<uint64_t>(ops, 1));
+            totalOps += ops;
+        }
+        perf.Stop(counters);
+        uint64_t allocs = g_allocCount.load() - allocs0;
+
+        std::sort(samples.begin(), samples.end());
+        r.ops = totalOps;
+        r.nsPerOp = samples[samples.size() / 2];
+        r.nsPerOpMin = samples.front();
+        r.allocsPerOp = (double)allocs / (double)std::max<uint64_t>(totalOps, 1);
+        for (int i = 0; i < PerfCounters::Count; ++i) {
+            r.hasPerf[i] = perf.Available(i);
+            r.perfPerOp[i] = (double)counters[i] / (double)std::max<uint64_t>(totalOps, 1);
+        }
+        return r;
+    }
+
+    std::string JsonEscape(const std::string& s)
+    {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if ((unsigned char)c < 0x20) out += ' ';
+            else out += c;
+        }
+        return out;
+    }
+
+    std::string CompilerName()
+    {
+#if defined(__clang__)
+        return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    bool WriteJson(const std::string& path, const std::vector<BenchResult>& results, size_t positions, const BenchConfig& cfg)
+    {
+        FILE* f = std::fopen(path.c_str(), "w");
+        if (!f) return false;
+
+        char stamp[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        static const char* perfKeys[PerfCounters::Count] = { "cache_misses_per_op", "cache_references_per_op", "instructions_per_op" };
+
+        std::fprintf(f, "{\n");
+        std::fprintf(f, "  \"schema\": 1,\n");
+        std::fprintf(f, "  \"timestamp\": \"%s\",\n", stamp);
+        std::fprintf(f, "  \"compiler\": \"%s\",\n", JsonEscape(CompilerName()).c_str());
+#ifdef NDEBUG
+        std::fprintf(f, "  \"optimized\": true,\n");
+#else
+        std::fprintf(f, "  \"optimized\": false,\n");
+#endif
+        std::fprintf(f, "  \"positions\": %zu,\n", positions);
+        std::fprintf(f, "  \"min_time_ms\": %.0f,\n", cfg.minTimeMs);
+        std::fprintf(f, "  \"samples\": %d,\n", cfg.samples);
+        std::fprintf(f, "  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            std::fprintf(f, "    { \"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f, \"allocs_per_op\": %.4f",
+                JsonEscape(r.name).c_str(), (unsigned long long)r.ops, r.nsPerOp, r.nsPerOpMin, r.allocsPerOp);
+            for (int k = 0; k < PerfCounters::Count; ++k) {
+                if (r.hasPerf[k]) std::fprintf(f, ", \"%s\": %.4f", perfKeys[k], r.perfPerOp[k]);
+                else std::fprintf(f, ", \"%s\": null", perfKeys[k]);
+            }
+            std::fprintf(f, " }%s\n", (i + 1 < results.size()) ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        std::fclose(f);
+        return true;
+    }
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: core_bench [--min-time-ms MS] [--samples N] [--filter NAME] [--corpus FILE] [--json FILE]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig cfg;
+    std::string filter, corpusPath, jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { PrintUsage(); return 2; }
+        if (arg == "--min-time-ms") cfg.minTimeMs = std::atof(value);
+        else if (arg == "--samples") cfg.samples = std::max(1, std::atoi(value));
+        else if (arg == "--filter") filter = value;
+        else if (arg == "--corpus") corpusPath = value;
+        else if (arg == "--json") jsonPath = value;
+        else { PrintUsage(); return 2; }
+        ++i;
+    }
+
+    std::vector<std::string> fens;
+    if (!LoadCorpus(corpusPath, fens)) {
+        std::fprintf(stderr, "cannot read %s\n", corpusPath.c_str());
+        return 1;
+    }
+
+    GameLogic logic;
+    std::vector<Position> corpus;
+    for (const auto& fen : fens) {
+        Position pos;
+        pos.fen = fen;
+        if (!Fen::FENToBoard(fen, pos.board, pos.isWhiteTurn)) {
+            std::fprintf(stderr, "skipping invalid FEN: %s\n", fen.c_str());
+            continue;
+        }
+        PieceColor own = pos.isWhiteTurn ? PieceColor::White : PieceColor::Black;
+        for (int y = 0; y < 8; ++y)
+            for (int x = 0; x < 8; ++x)
+                if (pos.board.GetPiece(x, y).color == own) pos.ownSquares.emplace_back(x, y);
+        logic.GenerateLegalMoves(pos.board, pos.isWhiteTurn, pos.legalMoves);
+        corpus.push_back(std::move(pos));
+    }
+    if (corpus.empty()) { std::fprintf(stderr, "empty corpus\n"); return 1; }
+
+    PerfCounters perf;
+    std::vector<BenchResult> results;
+    auto enabled = [&](const char* name) { return filter.empty() || std::strstr(name, filter.c_str()) != nullptr; };
+
+    // 호출부 버퍼는 벤치마크 밖에서 한 번만 잡아 두고 재사용 (GUI / 러너와 같은 사용 방식)
+    std::vector<Move> moves;
+    moves.reserve(256);
+
+    if (enabled("GeneratePseudoLegalMoves")) {
+        results.push_back(Measure("GeneratePseudoLegalMoves", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus)
+                for (const auto& sq : pos.ownSquares) {
+                    logic.GeneratePseudoLegalMoves(pos.board, sq.first, sq.second, pos.isWhiteTurn, moves);
+                    g_sink = g_sink + moves.size();
+                    ++ops;
+                }
+            return ops;
+        }));
+    }
+
+    if (enabled("IsSquareAttacked")) {
+        results.push_back(Measure("IsSquareAttacked", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus)
+                for (int y = 0; y < 8; ++y)
+                    for (int x = 0; x < 8; ++x) {
+                        g_sink = g_sink + logic.IsSquareAttacked(pos.board, x, y, true)
+                            + logic.IsSquareAttacked(pos.board, x, y, false);
+                        ops += 2;
+                    }
+            return ops;
+        }));
+    }
+
+    if (enabled("ApplyMove")) {
+        // 실패 시에도 보드가 바뀔 수 있어 호출부는 항상 복사본에 둠 -> 복사 비용 포함
+        results.push_back(Measure("ApplyMove(copy+apply)", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus)
+                for (const auto& mv : pos.legalMoves) {
+                    Board temp = pos.board;
+                    g_sink = g_sink + logic.ApplyMove(temp, mv, pos.isWhiteTurn);
+                    ++ops;
+                }
+            return ops;
+        }));
+    }
+
+    if (enabled("GenerateLegalMoves")) {
+        results.push_back(Measure("GenerateLegalMoves", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                logic.GenerateLegalMoves(pos.board, pos.isWhiteTurn, moves);
+                g_sink = g_sink + moves.size();
+                ++ops;
+            }
+            return ops;
+        }));
+    }
+
+    if (enabled("MovePicker")) {
+        // 단계별 생성기로 전부 꺼냄 (GenerateLegalMoves와 같은 집합, 순서만 다름)
+        results.push_back(Measure("MovePicker(all)", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                MovePicker picker(pos.board, pos.isWhiteTurn);
+                Move mv;
+                while (picker.Next(mv)) g_sink = g_sink + mv.dx;
+                ++ops;
+            }
+            return ops;
+        }));
+    }
+
+    if (enabled("See")) {
+        // 합법수 전부 (조용한 수는 도착 칸 안전 여부 판정)
+        results.push_back(Measure("See", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus)
+                for (const auto& mv : pos.legalMoves) {
+                    g_sink = g_sink + (uint64_t)logic.See(pos.board, mv);
+                    ++ops;
+                }
+            return ops;
+        }));
+        results.push_back(Measure("SeeGe(0)", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus)
+                for (const auto& mv : pos.legalMoves) {
+                    g_sink = g_sink + logic.SeeGe(pos.board, mv, 0);
+                    ++ops;
+                }
+            return ops;
+        }));
+    }
+
+    if (enabled("CheckGameState")) {
+        results.push_back(Measure("CheckGameState", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                g_sink = g_sink + (uint64_t)logic.CheckGameState(pos.board, pos.isWhiteTurn);
+                ++ops;
+            }
+            return ops;
+        }));
+    }
+
+    if (enabled("PawnStructure")) {
+        PawnStructure pawns;
+        results.push_back(Measure("PawnStructure::Analyze", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                PawnStructure::Analyze(pos.board, pawns);
+                g_sink = g_sink + pawns.score;
+                ++ops;
+            }
+            return ops;
+        }));
+
+        // 코퍼스가 표보다 작아 첫 샘플 이후는 모두 적중 (폰 키 계산 + 슬롯 조회 비용)
+        PawnTable table;
+        results.push_back(Measure("PawnTable::Probe(hit)", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                g_sink = g_sink + table.Probe(pos.board).score;
+                ++ops;
+            }
+            return ops;
+        }));
+    }
+
+    if (enabled("PushState")) {
+        // 무르기 스택이 이미 어느 정도 쌓인 상태(실제 대국)를 흉내 내기 위해 미리 채움
+        Board board = corpus[0].board;
+        for (int i = 0; i < 64; ++i) board.PushState(i % 2 == 0);
+        results.push_back(Measure("PushState+PopState", cfg, perf, [&]() {
+            for (int i = 0; i < 64; ++i) board.PushState(i % 2 == 0);
+            for (int i = 0; i < 64; ++i) g_sink = g_sink + board.PopState();
+            return (uint64_t)64;
+        }));
+    }
+
+    if (enabled("BoardToFEN")) {
+        results.push_back(Measure("BoardToFEN", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                g_sink = g_sink + Fen::BoardToFEN(pos.board, pos.isWhiteTurn).size();
+                ++ops;
+            }
+            return ops;
+        }));
+    }
+
+    if (enabled("PackedPosition")) {
+        results.push_back(Measure("PackedPosition::Encode", cfg, perf, [&]() {
+            uint64_t ops = 0;
+            for (auto& pos : corpus) {
+                PackedPosition packed;
+                g_sink = g_sink + PackedPosition::Encode(pos.board, pos.isWhiteTurn, packed) + packed.pieces[0];
+                ++ops;
+            }
+            return ops;
+        }));
+
+        // 디코딩 대상 보드는 재사용 (대량 읽기 루프와 같은 방식)
+        std::vector<PackedPosition> packed(corpus.size());
+        for (size_t i = 0; i < corpus.size(); ++i) PackedPosition::Encode(corpus[i].board, corpus[i].isWhiteTurn, packed[i]);
+        Board decoded;
+        results.push_back(Measure("PackedPosition::Decode", cfg, perf, [&]() {
+            for (const auto& p : packed) {
+                bool isWhiteTurn = true;
+                g_sink = g_sink + p.Decode(decoded, isWhiteTurn);
+            }
+            return (uint64_t)packed.size();
+        }));
+    }
+
+    if (enabled("GameTree")) {
+        // 본선 80수 + 8수마다 40수짜리 변화수. 서로 다른 가지의 끝을 오가는 비용 (공통 조상까지만 되돌림)
+        GameTree tree;
+        std::vector<uint32_t> leaves;
+        uint32_t rngState = 12345;
+        auto playRandom = [&](int plies) {
+            for (int i = 0; i < plies; ++i) {
+                logic.GenerateLegalMoves(tree.CurrentBoard(), tree.IsWhiteTurn(), moves);
+                if (moves.empty()) break;
+                rngState = rngState * 1103515245u + 12345u;
+                tree.Play(moves[(rngState >> 16) % moves.size()]);
+            }
+            leaves.push_back(tree.Current());
+        };
+        playRandom(80);
+        std::vector<uint32_t> mainLine;
+        tree.PathTo(leaves[0], mainLine);
+        for (size_t i = 8; i < mainLine.size(); i += 8) {
+            tree.GoTo(mainLine[i]);
+            playRandom(40);
+        }
+        size_t next = 0;
+        results.push_back(Measure("GameTree::GoTo(branch)", cfg, perf, [&]() {
+            for (size_t i = 0; i < leaves.size(); ++i) {
+                next = (next + 7) % leaves.size();
+                g_sink = g_sink + tree.GoTo(leaves[next]);
+            }
+            return (uint64_t)leaves.size();
+        }));
+    }
+
+    std::printf("%zu positions, %d samples x %.0f ms, perf counters: %s\n\n", corpus.size(), cfg.samples,
+        cfg.minTimeMs / cfg.samples, perf.AnyAvailable() ? "on" : "unavailable");
+    std::printf("%-26s %12s %12s %12s %14s %14s\n", "benchmark", "ns/op", "min ns/op", "allocs/op", "cache-miss/op", "instr/op");
+    for (const auto& r : results) {
+        char miss[32] = "-", instr[32] = "-";
+        if (r.hasPerf[PerfCounters::CacheMisses]) std::snprintf(miss, sizeof(miss), "%.3f", r.perfPerOp[PerfCounters::CacheMisses]);
+        if (r.hasPerf[PerfCounters::Instructions]) std::snprintf(instr, sizeof(instr), "%.1f", r.perfPerOp[PerfCounters::Instructions]);
+        std::printf("%-26s %12.1f %12.1f %12.3f %14s %14s\n", r.name.c_str(), r.nsPerOp, r.nsPerOpMin, r.allocsPerOp, miss, instr);
+    }
+
+    if (!jsonPath.empty() && !WriteJson(jsonPath, results, corpus.size(), cfg)) {
+        std::fprintf(stderr, "cannot write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
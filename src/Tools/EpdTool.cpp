@@ -0,0 +1,90 @@
+﻿// 헤드리스 EPD 테스트 스위트 러너 (bm / am, 여러 엔진 세션 병렬, 안정되면 조기 종료)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 -pthread src/Tools/EpdTool.cpp src/Match/EpdSuite.cpp src/ChessCore/*.cpp
+//       src/Engine/Stockfish.cpp src/Engine/UciInfo.cpp src/Utils/Logger.cpp src/Utils/Trace.cpp -o epd_suite
+// 실행:
+//   ./epd_suite <engine> <suite.epd> [--sessions 1] [--go "go movetime 10000"] [--stable 3]
+//               [--option NAME=VALUE] [--keep-hash]
+//
+// 정답 수가 반복 심화 K 깊이 연속 PV 첫 수로 유지되면 stop을 보내 다음 국면으로 넘어감 (--stable 0: 끝까지 탐색).
+// 엔진 스레드 수는 --option Threads=N 으로 세션마다 따로 지정.
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../Match/EpdSuite.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: epd_suite <engine> <suite.epd> [--sessions N] [--go CMD] [--stable K]\n"
+            "                 [--option NAME=VALUE] [--keep-hash]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { PrintUsage(); return 2; }
+
+    std::string enginePath = argv[1];
+    std::string suitePath = argv[2];
+    EpdSuiteOptions options;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--keep-hash") { options.newGamePerPosition = false; continue; }
+
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { PrintUsage(); return 2; }
+
+        if (arg == "--sessions") options.sessions = std::atoi(value);
+        else if (arg == "--go") options.goCommand = value;
+        else if (arg == "--stable") options.stableIterations = std::atoi(value);
+        else if (arg == "--option") {
+            std::string kv = value;
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos) { PrintUsage(); return 2; }
+            options.engineOptions.emplace_back(kv.substr(0, eq), kv.substr(eq + 1));
+        }
+        else { PrintUsage(); return 2; }
+        ++i;
+    }
+
+    std::vector<EpdPosition> positions;
+    std::vector<std::string> errors;
+    if (!EpdSuiteRunner::LoadSuite(suitePath, positions, &errors)) {
+        std::fprintf(stderr, "cannot read %s\n", suitePath.c_str());
+        return 1;
+    }
+    for (const auto& e : errors) std::fprintf(stderr, "skipped %s\n", e.c_str());
+
+    std::printf("%zu positions, %d sessions, \"%s\", stop after %d stable iterations\n",
+        positions.size(), options.sessions, options.goCommand.c_str(), options.stableIterations);
+
+    EpdSuiteRunner runner(enginePath, options);
+    EpdSummary summary = runner.Run(positions, [](const EpdResult& r, int solved, int done) {
+        std::printf("%4d  %-20s %-6s %-7s %9.0f ms %12llu nodes  depth %2d%s  [%d/%d]\n", r.index + 1, r.id.c_str(),
+            r.solved ? "ok" : "FAIL", r.bestMove.c_str(), r.solved ? r.solveMs : r.totalMs,
+            (unsigned long long)(r.solved ? r.solveNodes : r.nodes), r.depth, r.stoppedEarly ? " (early)" : "", solved, done);
+        std::fflush(stdout);
+    });
+
+    if (!summary.error.empty()) {
+        std::fprintf(stderr, "error: %s\n", summary.error.c_str());
+        return 1;
+    }
+
+    std::printf("\nsolved %d / %d (%.1f %%)\n", summary.solved, summary.total,
+        summary.total ? 100.0 * summary.solved / summary.total : 0.0);
+    std::printf("time to solution: p50 %.0f ms, p90 %.0f ms, p99 %.0f ms, max %.0f ms\n",
+        summary.p50Ms, summary.p90Ms, summary.p99Ms, summary.maxMs);
+    std::printf("nodes: %llu total, median %llu to solution\n",
+        (unsigned long long)summary.totalNodes, (unsigned long long)summary.solveNodesP50);
+    std::printf("wall time %.1f s\n", summary.wallMs / 1000.0);
+    return 0;
+}
@@ -0,0 +1,156 @@
+﻿// FrameScheduler 헤드리스 검사 (가상 시계, 플랫폼 독립)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++14 src/Tools/FrameSchedulerCheck.cpp src/Utils/FrameScheduler.cpp -o frame_scheduler_check
+// 실행:
+//   ./frame_scheduler_check
+//
+// GuiManager::ScheduleNextFrame / OnTimer와 같은 순서로 TimeUntilNextTick -> 시계 전진 -> BeginTick을 돌리며
+// 유휴(타이머 없음), 애니메이션 주기(16.667ms 격자), 드래그 중 이벤트 병합과 마감 시각을 확인합니다.
+// 하나라도 어긋나면 0이 아닌 값으로 종료합니다.
+
+#include <cstdint>
+#include <cstdio>
+#include "../Utils/FrameScheduler.h"
+
+namespace
+{
+    int g_failures = 0;
+
+    void Expect(bool ok, const char* what, long long got, long long want)
+    {
+        if (ok) return;
+        std::printf("  FAIL %s: got %lld, want %lld\n", what, got, want);
+        ++g_failures;
+    }
+    void ExpectEq(const char* what, long long got, long long want) { Expect(got == want, what, got, want); }
+
+    // 가상 시계: 검사가 직접 시각을 옮김
+    struct FakeClock
+    {
+        uint64_t now = 1000000;
+        FrameScheduler::Clock Get() { return [this]() { return now; }; }
+    };
+
+    const uint64_t k_period = FrameScheduler::kDefaultPeriodUs;
+
+    // 아무것도 활성이 아니면 타이머를 걸지 않음. Wake는 한 번만 틱
+    void CheckIdle()
+    {
+        std::printf("idle\n");
+        FakeClock clock;
+        FrameScheduler s(clock.Get());
+
+        ExpectEq("fresh scheduler wait", s.TimeUntilNextTick(), -1);
+        clock.now += 5 * k_period;
+        ExpectEq("fresh scheduler tick", s.BeginTick(), 0);
+
+        s.Wake();
+        s.Wake();
+        ExpectEq("idle wake wait", s.TimeUntilNextTick(), 0);
+        ExpectEq("idle wake tick", s.BeginTick(), 1);
+        ExpectEq("second tick after one wake", s.BeginTick(), 0);
+        ExpectEq("idle after wake", s.TimeUntilNextTick(), -1);
+
+        s.SetActive(FrameScheduler::Activity_Animation, true);
+        s.SetActive(FrameScheduler::Activity_Animation, false);
+        ExpectEq("idle after animation ends", s.TimeUntilNextTick(), -1);
+        ExpectEq("frames", (long long)s.GetStats().frames, 1);
+    }
+
+    // 애니메이션: 시작 즉시 한 번, 이후 시작 시각 기준 격자마다. 타이머가 늦어도 격자는 밀리지 않음
+    void CheckAnimationCadence()
+    {
+        std::printf("animation cadence\n");
+        FakeClock clock;
+        FrameScheduler s(clock.Get());
+
+        uint64_t start = clock.now;
+        s.SetActive(FrameScheduler::Activity_Animation, true);
+        ExpectEq("first tick wait", s.TimeUntilNextTick(), 0);
+        ExpectEq("first tick", s.BeginTick(), 1);
+
+        // 정확한 타이머: 매 틱이 start + k * period
+        for (int k = 1; k <= 30; ++k) {
+            int64_t wait = s.TimeUntilNextTick();
+            ExpectEq("wait to grid", wait, (long long)(start + k * k_period - clock.now));
+            clock.now += (uint64_t)wait;
+            ExpectEq("tick on grid", s.BeginTick(), 1);
+        }
+        ExpectEq("no drops on exact timer", (long long)s.GetStats().droppedFrames, 0);
+
+        // SetTimer처럼 ms로 올림 + 지터 2ms: 틱은 늦어도 다음 마감은 격자 위
+        for (int k = 31; k <= 60; ++k) {
+            int64_t wait = s.TimeUntilNextTick();
+            clock.now += (uint64_t)((wait + 999) / 1000 * 1000 + 2000);
+            ExpectEq("late tick", s.BeginTick(), 1);
+            ExpectEq("deadline stays on grid", s.TimeUntilNextTick(), (long long)(start + (k + 1) * k_period - clock.now));
+        }
+        ExpectEq("no drops under one period late", (long long)s.GetStats().droppedFrames, 0);
+
+        // 2.5주기 멈춤: 놓친 격자 2칸은 드롭, 다음 마감은 그 다음 격자
+        uint64_t grid = start + 61 * k_period;
+        clock.now = grid + 2 * k_period + k_period / 2;
+        ExpectEq("tick after stall", s.BeginTick(), 1);
+        ExpectEq("dropped slots", (long long)s.GetStats().droppedFrames, 2);
+        ExpectEq("deadline after stall", s.TimeUntilNextTick(), (long long)(grid + 3 * k_period - clock.now));
+
+        s.SetActive(FrameScheduler::Activity_Animation, false);
+        ExpectEq("idle after animation", s.TimeUntilNextTick(), -1);
+    }
+
+    // 드래그: 입력 이벤트(Wake)가 여러 번 와도 한 틱으로 합쳐지고, 격자 마감은 그대로
+    // 드래그가 끝나고 엔진만 남으면 마지막 틱 기준 100ms 폴링으로 바뀜
+    void CheckDragCoalescing()
+    {
+        std::printf("drag coalescing\n");
+        FakeClock clock;
+        FrameScheduler s(clock.Get());
+
+        uint64_t start = clock.now;
+        s.SetActive(FrameScheduler::Activity_Engine, true);
+        s.SetActive(FrameScheduler::Activity_Drag, true);
+        ExpectEq("drag start wait", s.TimeUntilNextTick(), 0);
+        ExpectEq("drag start tick", s.BeginTick(), 1);
+        ExpectEq("drag deadline", s.TimeUntilNextTick(), (long long)k_period);
+
+        // 격자 사이에 마우스 이벤트 세 번 -> 틱 한 번
+        clock.now = start + 4000;
+        s.Wake();
+        clock.now = start + 5000;
+        s.Wake();
+        s.Wake();
+        ExpectEq("coalesced wake wait", s.TimeUntilNextTick(), 0);
+        ExpectEq("coalesced wake tick", s.BeginTick(), 1);
+        ExpectEq("no second tick", s.BeginTick(), 0);
+        ExpectEq("deadline unchanged by wake", s.TimeUntilNextTick(), (long long)(start + k_period - clock.now));
+
+        clock.now = start + k_period;
+        ExpectEq("grid tick during drag", s.BeginTick(), 1);
+        ExpectEq("next drag deadline", s.TimeUntilNextTick(), (long long)k_period);
+        ExpectEq("frames", (long long)s.GetStats().frames, 3);
+
+        uint64_t lastTick = clock.now;
+        clock.now += 3000;
+        s.SetActive(FrameScheduler::Activity_Drag, false);
+        ExpectEq("engine poll deadline", s.TimeUntilNextTick(),
+                 (long long)(lastTick + FrameScheduler::kEnginePollPeriodUs - clock.now));
+
+        s.SetActive(FrameScheduler::Activity_Engine, false);
+        ExpectEq("idle after drag and engine", s.TimeUntilNextTick(), -1);
+    }
+}
+
+int main()
+{
+    CheckIdle();
+    CheckAnimationCadence();
+    CheckDragCoalescing();
+
+    if (g_failures) {
+        std::printf("%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
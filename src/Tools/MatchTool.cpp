@@ -0,0 +1,147 @@
+﻿// 헤드리스 엔진 대 엔진 대국 러너 (오프닝 스위트, 동시 대국, PGN, Elo / SPRT)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 -pthread src/Tools/MatchTool.cpp src/Match/*.cpp src/ChessCore/*.cpp
+//       src/Engine/Stockfish.cpp src/Engine/UciInfo.cpp src/Utils/Logger.cpp src/Utils/Trace.cpp -o engine_match
+// 실행:
+//   ./engine_match <engineA> <engineB> [--openings suite.epd] [--rounds 1] [--concurrency 1]
+//                  [--go "go movetime 100"] [--go-a CMD] [--go-b CMD] [--max-plies 600]
+//                  [--pgn out.pgn] [--sprt ELO0 ELO1] [--alpha 0.05] [--beta 0.05]
+//                  [--option-a NAME=VALUE] [--option-b NAME=VALUE] [--seed 1]
+//
+// 엔진 자리에 "mock"(무작위 합법수) 또는 "mock-greedy"(가장 비싼 기물부터 잡음)를 주면
+// 엔진 바이너리 없이 러너를 돌려볼 수 있음.
+// 오프닝 파일은 한 줄에 FEN/EPD 하나. 각 오프닝은 색을 바꿔 2판씩 진행.
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../Match/MatchRunner.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: engine_match <engineA|mock|mock-greedy> <engineB|mock|mock-greedy>\n"
+            "                    [--openings FILE] [--rounds N] [--concurrency N]\n"
+            "                    [--go CMD] [--go-a CMD] [--go-b CMD] [--max-plies N] [--pgn FILE]\n"
+            "                    [--sprt ELO0 ELO1] [--alpha A] [--beta B]\n"
+            "                    [--option-a NAME=VALUE] [--option-b NAME=VALUE] [--seed N]\n");
+    }
+
+    std::string BaseName(const std::string& path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return (slash == std::string::npos) ? path : path.substr(slash + 1);
+    }
+
+    struct PlayerSpec
+    {
+        std::string engine;
+        std::string goCommand;
+        std::vector<std::pair<std::string, std::string>> options;
+    };
+
+    // 스레드마다 다른 시드를 주기 위해 카운터를 공유
+    PlayerFactory MakeFactory(const PlayerSpec& spec, const std::string& name, uint32_t seed, std::atomic<uint32_t>& counter)
+    {
+        return [spec, name, seed, &counter]() -> std::unique_ptr<MatchPlayer> {
+            if (spec.engine == "mock" || spec.engine == "mock-greedy")
+                return std::make_unique<RandomPlayer>(name, seed * 7919u + counter++, spec.engine == "mock-greedy");
+            return std::make_unique<UciPlayer>(name, spec.engine, spec.goCommand, spec.options);
+        };
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { PrintUsage(); return 2; }
+
+    PlayerSpec specA{ argv[1], "", {} };
+    PlayerSpec specB{ argv[2], "", {} };
+    std::string goCommand = "go movetime 100";
+    std::string openingsPath;
+    uint32_t seed = 1;
+    MatchOptions options;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { PrintUsage(); return 2; }
+
+        if (arg == "--openings") openingsPath = value;
+        else if (arg == "--rounds") options.rounds = std::atoi(value);
+        else if (arg == "--concurrency") options.concurrency = std::atoi(value);
+        else if (arg == "--go") goCommand = value;
+        else if (arg == "--go-a") specA.goCommand = value;
+        else if (arg == "--go-b") specB.goCommand = value;
+        else if (arg == "--max-plies") options.maxPlies = std::atoi(value);
+        else if (arg == "--pgn") options.pgnPath = value;
+        else if (arg == "--alpha") options.sprtParams.alpha = std::atof(value);
+        else if (arg == "--beta") options.sprtParams.beta = std::atof(value);
+        else if (arg == "--seed") seed = (uint32_t)std::strtoul(value, nullptr, 10);
+        else if (arg == "--sprt") {
+            if (i + 2 >= argc) { PrintUsage(); return 2; }
+            options.sprt = true;
+            options.sprtParams.elo0 = std::atof(argv[i + 1]);
+            options.sprtParams.elo1 = std::atof(argv[i + 2]);
+            ++i;
+        }
+        else if (arg == "--option-a" || arg == "--option-b") {
+            std::string kv = value;
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos) { PrintUsage(); return 2; }
+            (arg == "--option-a" ? specA : specB).options.emplace_back(kv.substr(0, eq), kv.substr(eq + 1));
+        }
+        else { PrintUsage(); return 2; }
+        ++i;
+    }
+    if (specA.goCommand.empty()) specA.goCommand = goCommand;
+    if (specB.goCommand.empty()) specB.goCommand = goCommand;
+
+    std::vector<std::string> openings;
+    if (!openingsPath.empty() && !MatchRunner::LoadOpenings(openingsPath, openings)) {
+        std::fprintf(stderr, "cannot read %s\n", openingsPath.c_str());
+        return 1;
+    }
+
+    // 같은 엔진끼리 붙여도 PGN에서 구분되도록 이름에 A/B를 붙임
+    std::string nameA = BaseName(specA.engine) + " (A)";
+    std::string nameB = BaseName(specB.engine) + " (B)";
+    std::atomic<uint32_t> counter{ 0 };
+    MatchRunner runner(MakeFactory(specA, nameA, seed, counter), MakeFactory(specB, nameB, seed + 1, counter), options);
+
+    std::printf("%s vs %s: %zu openings x 2 colors x %d rounds, concurrency %d\n",
+        nameA.c_str(), nameB.c_str(), openings.empty() ? (size_t)1 : openings.size(), options.rounds, options.concurrency);
+
+    MatchSummary summary = runner.Run(openings, [](const GameRecord& game, const MatchScore& s) {
+        static const char* results[] = { "1-0", "0-1", "1/2-1/2" };
+        std::printf("game %4d  %-8s %-22s  +%d -%d =%d\n", game.index + 1, results[(int)game.result],
+            game.termination.c_str(), s.wins, s.losses, s.draws);
+        std::fflush(stdout);
+    });
+
+    if (!summary.error.empty()) {
+        std::fprintf(stderr, "error: %s\n", summary.error.c_str());
+        return 1;
+    }
+
+    MatchStats::EloEstimate elo = MatchStats::Estimate(summary.score);
+    std::printf("\nScore of %s vs %s: %d - %d - %d  [%.3f] %d games\n", nameA.c_str(), nameB.c_str(),
+        summary.score.wins, summary.score.losses, summary.score.draws, elo.score, summary.gamesPlayed);
+    std::printf("Elo difference: %+.1f +/- %.1f, LOS: %.1f %%\n", elo.elo, elo.margin95, elo.los * 100.0);
+
+    if (options.sprt) {
+        double lower = 0.0, upper = 0.0;
+        MatchStats::SprtBounds(options.sprtParams, lower, upper);
+        const char* verdict = summary.sprtResult == MatchStats::SprtResult::AcceptH1 ? "H1 accepted"
+            : summary.sprtResult == MatchStats::SprtResult::AcceptH0 ? "H0 accepted" : "inconclusive";
+        std::printf("SPRT: llr %.2f (%.2f, %.2f) [%.1f, %.1f] %s%s\n", summary.llr, lower, upper,
+            options.sprtParams.elo0, options.sprtParams.elo1, verdict, summary.stoppedBySprt ? " (stopped early)" : "");
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+﻿// 강제 메이트(mate-in-N) 일괄 풀이 도구 (df-pn 탐색, 퍼즐 단위 멀티스레드)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 -pthread src/Tools/MateTool.cpp src/ChessCore/*.cpp src/Utils/Trace.cpp -o mate_solver
+// 실행:
+//   ./mate_solver [--moves 5] [--threads 1] [--max-nodes 20000000] [--tt-mb 16] <file|->
+//
+// 입력은 한 줄에 FEN/EPD 하나 ('-'이면 표준 입력). 빈 줄과 '#' 주석은 건너뜀.
+// 줄마다 결과(mate N / none / unknown), 노드 수, 시간, 메이트 수순(SAN)을 출력.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../ChessCore/Fen.h"
+#include "../ChessCore/MateSolver.h"
+#include "../ChessCore/Notation.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: mate_solver [--moves N] [--threads N] [--max-nodes N] [--tt-mb N] <file|->\n");
+    }
+
+    // EPD는 4필드 뒤에 연산자(bm, id ...)가 오므로 숫자일 때만 카운터로 취급
+    std::string ToFen(const std::string& line)
+    {
+        std::istringstream iss(line);
+        std::string fields[6];
+        int n = 0;
+        while (n < 6 && iss >> fields[n]) ++n;
+        if (n < 4) return line;
+
+        std::string fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+        bool counters = n == 6 && fields[4].find_first_not_of("0123456789") == std::string::npos
+            && fields[5].find_first_not_of("0123456789") == std::string::npos;
+        return fen + (counters ? " " + fields[4] + " " + fields[5] : " 0 1");
+    }
+
+    void ReadPositions(std::istream& in, std::vector<std::string>& outFens)
+    {
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            outFens.push_back(ToFen(line));
+        }
+    }
+
+    std::string LineToSAN(const std::string& fen, const std::vector<Move>& line)
+    {
+        Board board;
+        bool turn = true;
+        if (!Fen::FENToBoard(fen, board, turn)) return "";
+
+        GameLogic logic;
+        std::string out;
+        for (const auto& mv : line) {
+            if (!out.empty()) out += ' ';
+            out += Notation::MoveToSAN(board, mv, turn, logic);
+            logic.ApplyMove(board, mv, turn);
+            turn = !turn;
+        }
+        return out;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    MateSolverOptions options;
+    int threads = 1;
+    std::string inputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.size() > 2 && arg.compare(0, 2, "--") == 0) {
+            const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            if (!value) { PrintUsage(); return 2; }
+
+            if (arg == "--moves") options.maxMoves = std::atoi(value);
+            else if (arg == "--threads") threads = std::atoi(value);
+            else if (arg == "--max-nodes") options.maxNodes = std::strtoull(value, nullptr, 10);
+            else if (arg == "--tt-mb") options.ttEntries = (size_t)std::atoi(value) * 1024 * 1024 / 16;
+            else { PrintUsage(); return 2; }
+            ++i;
+        }
+        else if (inputPath.empty()) inputPath = arg;
+        else { PrintUsage(); return 2; }
+    }
+    if (inputPath.empty() || options.maxMoves < 1) { PrintUsage(); return 2; }
+
+    std::vector<std::string> fens;
+    if (inputPath == "-") ReadPositions(std::cin, fens);
+    else {
+        std::ifstream in(inputPath);
+        if (!in) {
+            std::fprintf(stderr, "cannot read %s\n", inputPath.c_str());
+            return 1;
+        }
+        ReadPositions(in, fens);
+    }
+
+    std::vector<MateSolution> results = MateSolver::SolveBatch(fens, options, threads);
+
+    int mates = 0, none = 0, unknown = 0;
+    uint64_t totalNodes = 0;
+    double totalMs = 0.0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MateSolution& r = results[i];
+        totalNodes += r.nodes;
+        totalMs += r.ms;
+        if (r.status == MateStatus::Mate) {
+            ++mates;
+            std::printf("%4zu  mate %-2d  %10llu nodes %9.2f ms  %s\n", i + 1, r.mateIn,
+                (unsigned long long)r.nodes, r.ms, LineToSAN(fens[i], r.line).c_str());
+        }
+        else {
+            if (r.status == MateStatus::NoMate) ++none;
+            else ++unknown;
+            std::printf("%4zu  %-7s  %10llu nodes %9.2f ms\n", i + 1, r.status == MateStatus::NoMate ? "none" : "unknown",
+                (unsigned long long)r.nodes, r.ms);
+        }
+    }
+
+    std::printf("\n%zu positions: %d mate, %d none, %d unknown  (%llu nodes, %.1f ms solver time, %d threads)\n",
+        results.size(), mates, none, unknown, (unsigned long long)totalNodes, totalMs, threads);
+    return 0;
+}
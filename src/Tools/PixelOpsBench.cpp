@@ -0,0 +1,156 @@
+﻿// PixelOps 마이크로 벤치마크 + 비트 단위 일치 검증 (헤드리스, 플랫폼 독립)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 src/Tools/PixelOpsBench.cpp src/Render/PixelOps.cpp -o pixelops_bench
+// 실행:
+//   ./pixelops_bench [pixels=16384] [iterations=2000]
+//
+// 모든 ISA 구현이 Reference와 다르면 0이 아닌 값으로 종료합니다.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "../Render/PixelOps.h"
+
+namespace
+{
+    const PixelOps::Isa k_isas[] = { PixelOps::Isa::Scalar, PixelOps::Isa::SSE2, PixelOps::Isa::AVX2 };
+
+    bool IsaAvailable(PixelOps::Isa isa)
+    {
+        return (int)isa <= (int)PixelOps::BestIsa();
+    }
+
+    // 가능한 모든 (채널, 알파) 조합 + 꼬리 처리용 다양한 길이
+    bool VerifyPremultiply(PixelOps::Isa isa)
+    {
+        std::vector<uint8_t> base(256 * 256 * 4);
+        for (int a = 0; a < 256; ++a)
+            for (int c = 0; c < 256; ++c) {
+                uint8_t* px = &base[(a * 256 + c) * 4];
+                px[0] = (uint8_t)c; px[1] = (uint8_t)(255 - c); px[2] = (uint8_t)(c ^ 0x5A); px[3] = (uint8_t)a;
+            }
+
+        for (size_t len : { (size_t)256 * 256, (size_t)1, (size_t)3, (size_t)7, (size_t)13, (size_t)31, (size_t)65535 }) {
+            std::vector<uint8_t> ref(base.begin(), base.begin() + len * 4);
+            std::vector<uint8_t> got = ref;
+            PixelOps::PremultiplySpanReference(ref.data(), len);
+            PixelOps::PremultiplySpan(isa, got.data(), len);
+            if (ref != got) return false;
+        }
+        return true;
+    }
+
+    // 가능한 모든 (src 채널 <= src 알파, dst 채널) 조합
+    bool VerifyBlendOver(PixelOps::Isa isa)
+    {
+        std::vector<uint8_t> src, dst;
+        src.reserve(256 * 256 * 4);
+        dst.reserve(256 * 256 * 4);
+        for (int sa = 0; sa < 256; ++sa) {
+            src.clear(); dst.clear();
+            for (int sc = 0; sc <= sa; ++sc)
+                for (int d = 0; d < 256; ++d) {
+                    uint8_t s[4] = { (uint8_t)sc, (uint8_t)(sa - sc), (uint8_t)(sc / 2), (uint8_t)sa };
+                    uint8_t t[4] = { (uint8_t)d, (uint8_t)(255 - d), (uint8_t)(d ^ 0xA5), (uint8_t)(255 - (d / 3)) };
+                    src.insert(src.end(), s, s + 4);
+                    dst.insert(dst.end(), t, t + 4);
+                }
+            size_t count = src.size() / 4;
+            std::vector<uint8_t> ref = dst, got = dst;
+            PixelOps::BlendOverSpanReference(ref.data(), src.data(), count);
+            PixelOps::BlendOverSpan(isa, got.data(), src.data(), count);
+            if (ref != got) return false;
+
+            // 꼬리 길이 검증
+            size_t tail = (size_t)(sa % 11) + 1;
+            if (tail > count) tail = count;
+            std::vector<uint8_t> refT(dst.begin(), dst.begin() + tail * 4), gotT = refT;
+            PixelOps::BlendOverSpanReference(refT.data(), src.data(), tail);
+            PixelOps::BlendOverSpan(isa, gotT.data(), src.data(), tail);
+            if (refT != gotT) return false;
+        }
+        return true;
+    }
+
+    template <class Fn>
+    double MeasureNsPerPixel(size_t pixels, int iterations, Fn&& fn)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) fn();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        return ns / ((double)pixels * iterations);
+    }
+
+    void PrintRow(const char* kernel, const char* isa, double nsPerPixel, double refNs)
+    {
+        std::printf("%-12s %-10s %8.3f ns/px %9.1f Mpx/s   x%.2f\n",
+            kernel, isa, nsPerPixel, 1000.0 / nsPerPixel, refNs / nsPerPixel);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t pixels = (argc > 1) ? (size_t)std::strtoul(argv[1], nullptr, 10) : 16384;
+    int iterations = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    if (pixels == 0) pixels = 1;
+    if (iterations <= 0) iterations = 1;
+
+    std::printf("best isa: %s\n", PixelOps::IsaName(PixelOps::BestIsa()));
+
+    // 1. 비트 단위 일치 검증
+    bool allOk = true;
+    for (PixelOps::Isa isa : k_isas) {
+        if (!IsaAvailable(isa)) { std::printf("verify %-8s skipped (unsupported)\n", PixelOps::IsaName(isa)); continue; }
+        bool pm = VerifyPremultiply(isa);
+        bool bo = VerifyBlendOver(isa);
+        std::printf("verify %-8s premultiply:%s blend-over:%s\n", PixelOps::IsaName(isa), pm ? "ok" : "MISMATCH", bo ? "ok" : "MISMATCH");
+        allOk = allOk && pm && bo;
+    }
+
+    // 2. 처리량 측정 (랜덤 스프라이트 데이터)
+    std::mt19937 rng(12345);
+    std::vector<uint8_t> sprite(pixels * 4);
+    for (auto& b : sprite) b = (uint8_t)(rng() & 0xFF);
+    std::vector<uint8_t> premul = sprite;
+    PixelOps::PremultiplySpanReference(premul.data(), pixels);
+    std::vector<uint8_t> frame(pixels * 4);
+    for (auto& b : frame) b = (uint8_t)(rng() & 0xFF);
+
+    std::vector<uint8_t> work(pixels * 4);
+    std::printf("\n%zu pixels x %d iterations\n", pixels, iterations);
+
+    double refPm = MeasureNsPerPixel(pixels, iterations, [&] {
+        std::memcpy(work.data(), sprite.data(), work.size());
+        PixelOps::PremultiplySpanReference(work.data(), pixels);
+    });
+    PrintRow("premultiply", "reference", refPm, refPm);
+    for (PixelOps::Isa isa : k_isas) {
+        if (!IsaAvailable(isa)) continue;
+        double ns = MeasureNsPerPixel(pixels, iterations, [&] {
+            std::memcpy(work.data(), sprite.data(), work.size());
+            PixelOps::PremultiplySpan(isa, work.data(), pixels);
+        });
+        PrintRow("premultiply", PixelOps::IsaName(isa), ns, refPm);
+    }
+
+    double refBo = MeasureNsPerPixel(pixels, iterations, [&] {
+        std::memcpy(work.data(), frame.data(), work.size());
+        PixelOps::BlendOverSpanReference(work.data(), premul.data(), pixels);
+    });
+    PrintRow("blend-over", "reference", refBo, refBo);
+    for (PixelOps::Isa isa : k_isas) {
+        if (!IsaAvailable(isa)) continue;
+        double ns = MeasureNsPerPixel(pixels, iterations, [&] {
+            std::memcpy(work.data(), frame.data(), work.size());
+            PixelOps::BlendOverSpan(isa, work.data(), premul.data(), pixels);
+        });
+        PrintRow("blend-over", PixelOps::IsaName(isa), ns, refBo);
+    }
+
+    return allOk ? 0 : 1;
+}
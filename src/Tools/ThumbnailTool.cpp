@@ -0,0 +1,100 @@
+﻿// FEN 목록 -> 보드 썸네일(PNG/JPEG) 일괄 생성 (헤드리스, 디스플레이 불필요)
+//
+// 빌드 (Linux):
+//   g++ -O2 -std=c++17 -pthread src/Tools/ThumbnailTool.cpp src/Render/*.cpp src/ChessCore/*.cpp src/Utils/Trace.cpp
+//       $(pkg-config --cflags --libs opencv4) -o board_thumbs
+// 실행:
+//   ./board_thumbs <fen-list.txt> <out-dir> [--size 256] [--format png|jpg] [--quality 90]
+//                  [--threads 0] [--assets assets/pieces]
+//
+// fen-list.txt는 한 줄에 FEN 하나 (빈 줄, '#'으로 시작하는 줄은 무시).
+// 출력 파일 이름은 목록 순서의 0부터 시작하는 번호 (000000.png ...).
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../Render/SpriteSet.h"
+#include "../Render/ThumbnailRenderer.h"
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+            "usage: board_thumbs <fen-list.txt> <out-dir> [--size N] [--format png|jpg]\n"
+            "                    [--quality Q] [--threads N] [--assets DIR]\n");
+    }
+
+    bool ReadFenList(const std::string& path, std::vector<std::string>& out)
+    {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+            out.push_back(line);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) { PrintUsage(); return 2; }
+
+    std::string listPath = argv[1];
+    std::string outDir = argv[2];
+    std::string assetDir = "assets/pieces";
+    ThumbnailOptions options;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) { PrintUsage(); return 2; }
+        if (arg == "--size") options.size = std::atoi(value);
+        else if (arg == "--format") options.format = value;
+        else if (arg == "--quality") options.jpegQuality = std::atoi(value);
+        else if (arg == "--threads") options.threads = std::atoi(value);
+        else if (arg == "--assets") assetDir = value;
+        else { PrintUsage(); return 2; }
+        ++i;
+    }
+
+    std::vector<std::string> fens;
+    if (!ReadFenList(listPath, fens)) {
+        std::fprintf(stderr, "cannot read %s\n", listPath.c_str());
+        return 1;
+    }
+
+    SpriteSet sources;
+    std::vector<std::string> missing;
+    if (!sources.LoadFromDirectory(assetDir, &missing)) {
+        std::fprintf(stderr, "no piece images found in %s\n", assetDir.c_str());
+        return 1;
+    }
+    for (const auto& path : missing) std::fprintf(stderr, "warning: missing %s\n", path.c_str());
+
+    ThumbnailRenderer renderer(sources, options);
+    const std::string ext = renderer.Extension();
+
+    std::atomic<size_t> writeErrors{ 0 };
+    ThumbnailBatchResult result = renderer.RenderBatch(fens, [&](size_t index, const std::vector<unsigned char>& data) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%06zu", index);
+        std::string path = outDir + "/" + name + ext;
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f || std::fwrite(data.data(), 1, data.size(), f) != data.size()) ++writeErrors;
+        if (f) std::fclose(f);
+    });
+
+    double rate = (result.seconds > 0.0) ? result.rendered / result.seconds : 0.0;
+    std::printf("%zu rendered, %zu failed, %zu write errors, %dx%d px, %.3f s (%.0f boards/s)\n",
+        result.rendered, result.failed, writeErrors.load(), renderer.ImageSize(), renderer.ImageSize(),
+        result.seconds, rate);
+    return (result.failed == 0 && writeErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+﻿#include "FrameScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+FrameScheduler::FrameScheduler(Clock clock, uint64_t periodUs)
+    : m_clock(std::move(clock)), m_periodUs(periodUs ? periodUs : kDefaultPeriodUs)
+{
+}
+
+FrameScheduler::Clock FrameScheduler::SteadyClock()
+{
+    return []() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+}
+
+uint64_t FrameScheduler::CurrentPeriod() const
+{
+    if (m_active & (Activity_Animation | Activity_Drag)) return m_periodUs;
+    return kEnginePollPeriodUs;
+}
+
+void FrameScheduler::SetActive(uint32_t activity, bool active)
+{
+    uint32_t before = m_active;
+    if (active) m_active |= activity;
+    else m_active &= ~activity;
+    if (before == m_active) return;
+
+    uint64_t now = m_clock();
+    if (before == 0) {
+        // 유휴 -> 활성: 즉시 한 번 틱하고 그 시각을 격자 기준으로 삼음
+        m_phaseUs = now;
+        m_nextTickUs = now;
+        m_hasLastTick = false;
+        return;
+    }
+    if (m_active == 0) {
+        // 활성 -> 유휴: 유휴 구간이 프레임 간격 통계에 섞이지 않도록 끊음
+        m_hasLastTick = false;
+        return;
+    }
+
+    // 활성 종류가 바뀌어 주기가 달라졌으면 마지막 틱 기준으로 격자를 다시 맞춤
+    m_phaseUs = m_hasLastTick ? m_lastTickUs : now;
+    m_nextTickUs = m_hasLastTick ? m_lastTickUs + CurrentPeriod() : now;
+}
+
+void FrameScheduler::Wake()
+{
+    m_wakePending = true;
+}
+
+int64_t FrameScheduler::TimeUntilNextTick() const
+{
+    if (m_wakePending) return 0;
+    if (m_active == 0) return -1;
+
+    uint64_t now = m_clock();
+    return (now >= m_nextTickUs) ? 0 : (int64_t)(m_nextTickUs - now);
+}
+
+bool FrameScheduler::BeginTick()
+{
+    uint64_t now = m_clock();
+    bool due = (m_active != 0) && now >= m_nextTickUs;
+    if (!due && !m_wakePending) return false;
+
+    m_wakePending = false;
+    ++m_frames;
+
+    if (m_active == 0) {
+        // 유휴 상태의 Wake 틱: 간격 통계 없음
+        m_hasLastTick = false;
+        return true;
+    }
+
+    if (m_hasLastTick) RecordInterval(now - m_lastTickUs);
+
+    if (due) {
+        // 다음 격자 시각으로 이동. 한 주기 이상 늦었으면 놓친 슬롯은 드롭으로 기록
+        uint64_t period = CurrentPeriod();
+        uint64_t late = now - m_nextTickUs;
+        uint64_t skipped = late / period;
+        m_dropped += skipped;
+        m_nextTickUs += (skipped + 1) * period;
+    }
+
+    m_lastTickUs = now;
+    m_hasLastTick = true;
+    return true;
+}
+
+void FrameScheduler::RecordInterval(uint64_t us)
+{
+    if (m_intervalCount == 0 || us < m_intervalMin) m_intervalMin = us;
+    if (us > m_intervalMax) m_intervalMax = us;
+    m_history[m_intervalCount % kHistorySize] = (uint32_t)std::min<uint64_t>(us, UINT32_MAX);
+    m_intervalSum += us;
+    ++m_intervalCount;
+}
+
+FrameScheduler::Stats FrameScheduler::GetStats() const
+{
+    Stats s;
+    s.frames = m_frames;
+    s.droppedFrames = m_dropped;
+    if (m_intervalCount == 0) return s;
+
+    s.minFrameUs = m_intervalMin;
+    s.maxFrameUs = m_intervalMax;
+    s.avgFrameUs = (double)m_intervalSum / (double)m_intervalCount;
+
+    // 백분위는 최근 kHistorySize개 간격 기준
+    size_t n = (size_t)std::min<uint64_t>(m_intervalCount, kHistorySize);
+    std::vector<uint32_t> sorted(m_history.begin(), m_history.begin() + n);
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) { return (uint64_t)sorted[std::min(n - 1, (size_t)(p * (double)(n - 1) + 0.5))]; };
+    s.p50FrameUs = pct(0.50);
+    s.p95FrameUs = pct(0.95);
+    s.p99FrameUs = pct(0.99);
+    return s;
+}
+
+void FrameScheduler::ResetStats()
+{
+    m_frames = 0;
+    m_dropped = 0;
+    m_intervalCount = 0;
+    m_intervalSum = 0;
+    m_intervalMin = 0;
+    m_intervalMax = 0;
+}
@@ -0,0 +1,82 @@
+﻿#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+
+// 유휴 상태를 인식하는 프레임 스케줄러 (플랫폼 독립)
+// - 애니메이션 / 드래그 / 엔진 탐색 중 하나라도 활성일 때만 틱을 요청
+// - Wake()로 이벤트(엔진 완료, 입력) 발생 시 한 번 즉시 틱
+// - 틱 시각은 period 간격의 고정 격자에 맞춤 (vsync 방식), 늦으면 다음 격자로 건너뜀
+// - 시간은 주입된 Clock(µs)으로만 읽으므로 가상 시계로 단위 테스트 가능
+class FrameScheduler
+{
+public:
+    using Clock = std::function<uint64_t()>; // 단조 증가 시각 (µs)
+
+    enum Activity : uint32_t
+    {
+        Activity_Animation = 1u << 0,
+        Activity_Drag      = 1u << 1,
+        Activity_Engine    = 1u << 2,
+    };
+
+    struct Stats
+    {
+        uint64_t frames = 0;        // 기록된 틱 수
+        uint64_t droppedFrames = 0; // 건너뛴 격자 슬롯 수
+        uint64_t minFrameUs = 0;    // 연속 틱 간격 (활성 구간 안에서만)
+        uint64_t maxFrameUs = 0;
+        double   avgFrameUs = 0.0;
+        uint64_t p50FrameUs = 0;
+        uint64_t p95FrameUs = 0;
+        uint64_t p99FrameUs = 0;
+    };
+
+    static const uint64_t kDefaultPeriodUs = 16667;    // 60Hz
+    static const uint64_t kEnginePollPeriodUs = 100000; // 엔진만 활성일 때 (완료는 Wake로 통지됨)
+
+    explicit FrameScheduler(Clock clock = SteadyClock(), uint64_t periodUs = kDefaultPeriodUs);
+
+    static Clock SteadyClock();
+
+    void SetActive(uint32_t activity, bool active);
+    bool IsActive() const { return m_active != 0; }
+    uint32_t ActiveMask() const { return m_active; }
+
+    // 이벤트 발생: 다음 틱을 즉시 허용 (활성 상태가 아니어도 한 번)
+    void Wake();
+
+    // 다음 틱까지 남은 시간 (µs). 0이면 지금 틱, -1이면 틱 불필요 (완전 유휴)
+    int64_t TimeUntilNextTick() const;
+
+    // 틱 시각이 되었으면 true를 반환하고 다음 격자 시각 / 통계를 갱신
+    bool BeginTick();
+
+    Stats GetStats() const;
+    void ResetStats();
+
+private:
+    static const int kHistorySize = 256;
+
+    Clock    m_clock;
+    uint64_t m_periodUs;
+    uint32_t m_active = 0;
+    bool     m_wakePending = false;
+
+    uint64_t m_phaseUs = 0;      // 격자 기준 시각
+    uint64_t m_nextTickUs = 0;   // 다음 격자 시각
+    uint64_t m_lastTickUs = 0;
+    bool     m_hasLastTick = false;
+
+    // 통계
+    uint64_t m_frames = 0;
+    uint64_t m_dropped = 0;
+    uint64_t m_intervalCount = 0;
+    uint64_t m_intervalSum = 0;
+    uint64_t m_intervalMin = 0;
+    uint64_t m_intervalMax = 0;
+    std::array<uint32_t, kHistorySize> m_history{}; // 최근 간격 (백분위 계산용)
+
+    uint64_t CurrentPeriod() const;
+    void RecordInterval(uint64_t us);
+};
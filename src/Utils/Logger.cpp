@@ -1,17 +1,467 @@
 ﻿#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#endif
+
+namespace
+{
+    // 레코드 하나 = 256바이트. 본문이 넘치면 잘라서 "..."로 표시
+    const size_t kTextBytes = 240;
+
+    struct Record
+    {
+        int64_t  wallUs = 0;  // system_clock (µs)
+        uint32_t thread = 0;  // 로거가 부여한 작은 스레드 번호
+        LogLevel level = LogLevel::Info;
+        uint16_t len = 0;
+        char     text[kTextBytes];
+    };
+
+    // 단일 생산자(소유 스레드) / 단일 소비자(기록 스레드) 링 버퍼
+    struct Ring
+    {
+        std::vector<Record> slots;
+        uint64_t mask = 0;
+        uint32_t threadId = 0;
+
+        alignas(64) std::atomic<uint64_t> head{ 0 }; // 생산자만 씀
+        alignas(64) std::atomic<uint64_t> tail{ 0 }; // 소비자만 씀
+        std::atomic<uint64_t> dropped{ 0 };
+        std::atomic<bool> closed{ false };           // 소유 스레드 종료
+    };
+
+    // 같은 초 안의 레코드는 날짜/시각 문자열을 다시 만들지 않음
+    struct StampCache
+    {
+        int64_t second = -1;
+        char text[32] = {};
+    };
+
+    struct State
+    {
+        std::atomic<bool> running{ false };
+        std::atomic<int>  minLevel{ (int)LogLevel::Info };
+        std::atomic<uint32_t> nextThreadId{ 1 };
+        std::atomic<uint64_t> totalDropped{ 0 };
+
+        std::mutex registryMutex; // 링 등록 / 해제 때만 사용
+        std::vector<std::shared_ptr<Ring>> rings;
+        size_t ringRecords = 1024;
+
+        Logger::Options options;
+        std::thread writer;
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::condition_variable flushed;
+        bool stop = false;
+        std::atomic<bool> urgent{ false }; // 생산자는 wakeMutex 없이 세움 (아래 Push 참고)
+        uint64_t flushRequested = 0;
+        uint64_t flushCompleted = 0;
+
+        std::mutex syncMutex; // 동기 출력(Start 전 / Shutdown 후) 직렬화
+
+        // 기록 스레드 전용
+        FILE* file = nullptr;
+        size_t fileBytes = 0;
+        StampCache writerStamp;
+        StampCache syncStamp; // syncMutex 보호
+
+        ~State()
+        {
+            Logger::Shutdown();
+        }
+    };
+
+    State& G()
+    {
+        static State s;
+        return s;
+    }
+
+    struct RingHolder
+    {
+        std::shared_ptr<Ring> ring;
+        ~RingHolder()
+        {
+            if (ring) ring->closed.store(true, std::memory_order_release);
+        }
+    };
+
+    Ring* ThisThreadRing()
+    {
+        thread_local RingHolder holder;
+        if (!holder.ring) {
+            State& g = G();
+            auto ring = std::make_shared<Ring>();
+            size_t cap = 1;
+            while (cap < g.ringRecords) cap <<= 1;
+            ring->slots.resize(cap);
+            ring->mask = cap - 1;
+            ring->threadId = g.nextThreadId.fetch_add(1);
+
+            std::lock_guard<std::mutex> lock(g.registryMutex);
+            g.rings.push_back(ring);
+            holder.ring = std::move(ring);
+        }
+        return holder.ring.get();
+    }
+
+    int64_t WallMicros()
+    {
+        return (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    const char* LevelName(LogLevel level)
+    {
+        switch (level) {
+        case LogLevel::Trace: return "TRACE";
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info:  return "INFO ";
+        case LogLevel::Warn:  return "WARN ";
+        case LogLevel::Error: return "ERROR";
+        default:              return "?    ";
+        }
+    }
+
+    void SetText(Record& rec, const char* text, size_t len)
+    {
+        if (len >= kTextBytes) {
+            std::memcpy(rec.text, text, kTextBytes - 4);
+            std::memcpy(rec.text + kTextBytes - 4, "...", 3);
+            len = kTextBytes - 1;
+        }
+        else {
+            std::memcpy(rec.text, text, len);
+        }
+        rec.text[len] = '\0';
+        rec.len = (uint16_t)len;
+    }
+
+    // "2026-01-02 03:04:05.678901 INFO  [3] message\n"
+    size_t FormatLine(StampCache& stamp, const Record& rec, char* out, size_t outSize)
+    {
+        int64_t sec = rec.wallUs / 1000000;
+        if (sec != stamp.second) {
+            std::time_t t = (std::time_t)sec;
+            std::tm tm{};
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            std::strftime(stamp.text, sizeof(stamp.text), "%Y-%m-%d %H:%M:%S", &tm);
+            stamp.second = sec;
+        }
+        int n = std::snprintf(out, outSize, "%s.%06d %s [%u] %s\n", stamp.text, (int)(rec.wallUs % 1000000),
+            LevelName(rec.level), rec.thread, rec.text);
+        return (n < 0) ? 0 : std::min((size_t)n, outSize - 1);
+    }
+
+#ifdef _WIN32
+    void DebuggerOutput(const char* line, size_t len)
+    {
+        int wlen = MultiByteToWideChar(CP_UTF8, 0, line, (int)len, nullptr, 0);
+        std::wstring w(wlen, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, line, (int)len, &w[0], wlen);
+        w = L"[ChessProject] " + w;
+        OutputDebugStringW(w.c_str());
+    }
+#endif
+
+    void OpenFile(State& g)
+    {
+        g.file = std::fopen(g.options.filePath.c_str(), "ab");
+        g.fileBytes = 0;
+        if (g.file) {
+            std::fseek(g.file, 0, SEEK_END);
+            long pos = std::ftell(g.file);
+            g.fileBytes = (pos > 0) ? (size_t)pos : 0;
+        }
+    }
+
+    // path.(n-1) 삭제, path.(i) -> path.(i+1), path -> path.1
+    void RotateFile(State& g)
+    {
+        std::fclose(g.file);
+        g.file = nullptr;
+
+        const std::string& base = g.options.filePath;
+        int keep = std::max(1, g.options.maxFiles);
+        if (keep == 1) {
+            std::remove(base.c_str());
+        }
+        else {
+            std::remove((base + "." + std::to_string(keep - 1)).c_str());
+            for (int i = keep - 2; i >= 1; --i)
+                std::rename((base + "." + std::to_string(i)).c_str(), (base + "." + std::to_string(i + 1)).c_str());
+            std::rename(base.c_str(), (base + ".1").c_str());
+        }
+        OpenFile(g);
+    }
+
+    void EmitLine(State& g, const char* line, size_t len)
+    {
+        if (g.file) {
+            if (g.fileBytes > 0 && g.fileBytes + len > g.options.maxFileBytes) RotateFile(g);
+            if (g.file) {
+                std::fwrite(line, 1, len, g.file);
+                g.fileBytes += len;
+            }
+        }
+        if (g.options.toStderr) std::fwrite(line, 1, len, stderr);
+#ifdef _WIN32
+        if (g.options.toDebugger) DebuggerOutput(line, len);
+#endif
+    }
+
+    // 모든 링을 비우고 시간순으로 기록. 반환값: 기록한 레코드 수
+    size_t Drain(State& g, std::vector<Record>& batch)
+    {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(g.registryMutex);
+            rings = g.rings;
+        }
+
+        batch.clear();
+        uint64_t dropped = 0;
+        for (auto& ring : rings) {
+            uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) batch.push_back(ring->slots[tail & ring->mask]);
+            ring->tail.store(tail, std::memory_order_release);
+            dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+        }
+
+        // 스레드 간 순서는 타임스탬프로 맞춤 (같은 스레드 안에서는 이미 순서대로)
+        std::stable_sort(batch.begin(), batch.end(),
+            [](const Record& a, const Record& b) { return a.wallUs < b.wallUs; });
+
+        char line[kTextBytes + 64];
+        for (const Record& rec : batch) EmitLine(g, line, FormatLine(g.writerStamp, rec, line, sizeof(line)));
+
+        if (dropped > 0) {
+            Record rec;
+            rec.wallUs = WallMicros();
+            rec.level = LogLevel::Warn;
+            char msg[96];
+            int n = std::snprintf(msg, sizeof(msg), "[logger] %llu records dropped (ring buffer full)", (unsigned long long)dropped);
+            SetText(rec, msg, (size_t)std::max(n, 0));
+            EmitLine(g, line, FormatLine(g.writerStamp, rec, line, sizeof(line)));
+        }
+        if (g.file) std::fflush(g.file);
+
+        // 종료된 스레드의 링은 비운 뒤 해제
+        {
+            std::lock_guard<std::mutex> lock(g.registryMutex);
+            g.rings.erase(std::remove_if(g.rings.begin(), g.rings.end(), [](const std::shared_ptr<Ring>& r) {
+                return r->closed.load(std::memory_order_acquire)
+                    && r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire);
+            }), g.rings.end());
+        }
+        return batch.size();
+    }
+
+    void WriterMain()
+    {
+        State& g = G();
+        std::vector<Record> batch;
+        std::unique_lock<std::mutex> lock(g.wakeMutex);
+        for (;;) {
+            g.wake.wait_for(lock, std::chrono::milliseconds(g.options.flushIntervalMs),
+                [&]() { return g.stop || g.urgent.load(std::memory_order_acquire) || g.flushRequested != g.flushCompleted; });
+            bool stopping = g.stop;
+            uint64_t request = g.flushRequested;
+            g.urgent.exchange(false, std::memory_order_acquire); // 세운 쪽의 head 기록이 Drain에 보이도록
+
+            lock.unlock();
+            Drain(g, batch);
+            lock.lock();
+
+            g.flushCompleted = request;
+            g.flushed.notify_all();
+            if (stopping) break;
+        }
+    }
+
+    // Start 전 / Shutdown 후: 호출 스레드에서 바로 출력
+    void WriteSync(const Record& rec)
+    {
+        State& g = G();
+        std::lock_guard<std::mutex> lock(g.syncMutex);
+        char line[kTextBytes + 64];
+        size_t len = FormatLine(g.syncStamp, rec, line, sizeof(line));
+#ifdef _WIN32
+        DebuggerOutput(line, len);
+#else
+        std::fwrite(line, 1, len, stderr);
+#endif
+    }
+
+    void Push(LogLevel level, const char* text, size_t len, const char* fmt, va_list* args)
+    {
+        State& g = G();
+        if (!g.running.load(std::memory_order_acquire)) {
+            Record rec;
+            rec.wallUs = WallMicros();
+            rec.level = level;
+            if (fmt) {
+                char buf[kTextBytes];
+                int n = std::vsnprintf(buf, sizeof(buf), fmt, *args);
+                SetText(rec, buf, (size_t)std::max(n, 0));
+            }
+            else {
+                SetText(rec, text, len);
+            }
+            WriteSync(rec);
+            return;
+        }
+
+        Ring* ring = ThisThreadRing();
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        if (head - tail > ring->mask) {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            g.totalDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // 포맷은 호출 스레드에서 함: %s 인자가 호출자의 임시 버퍼를 가리킬 수 있어 인자를 기록 스레드로 넘길 수 없음
+        Record& rec = ring->slots[head & ring->mask];
+        rec.wallUs = WallMicros();
+        rec.thread = ring->threadId;
+        rec.level = level;
+        if (fmt) {
+            int n = std::vsnprintf(rec.text, kTextBytes, fmt, *args);
+            if (n >= (int)kTextBytes) std::memcpy(rec.text + kTextBytes - 4, "...", 4);
+            rec.len = (uint16_t)std::min(std::max(n, 0), (int)kTextBytes - 1);
+        }
+        else {
+            SetText(rec, text, len);
+        }
+        ring->head.store(head + 1, std::memory_order_release);
+
+        // 오류는 곧바로 기록되도록 기록 스레드를 깨움 (그 외는 주기적으로 배출)
+        // 락 없이 플래그만 세우고 알림. 기록 스레드가 조건을 본 직후 ~ 잠들기 직전 사이에 알림이 오면 놓치지만
+        // 그 대기는 flushIntervalMs 시간 제한이 있고 플래그는 남아 있으므로 늦어도 한 주기 안에 기록됨
+        // 배출 전까지 이미 세워진 플래그면 다시 알리지 않음 (오류가 몰려도 알림은 한 번)
+        if (level >= LogLevel::Error && !g.urgent.exchange(true, std::memory_order_acq_rel))
+            g.wake.notify_one();
+    }
+}
+
+void Logger::Start(const Options& options)
+{
+    State& g = G();
+    if (g.running.load()) return;
+
+    g.options = options;
+    g.ringRecords = std::max<size_t>(16, options.ringRecords);
+    g.minLevel.store((int)options.minLevel);
+    g.stop = false;
+    g.urgent.store(false);
+    if (!g.options.filePath.empty()) OpenFile(g);
+
+    g.writer = std::thread(WriterMain);
+    g.running.store(true, std::memory_order_release);
+}
+
+void Logger::Shutdown()
+{
+    State& g = G();
+    if (!g.running.exchange(false)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(g.wakeMutex);
+        g.stop = true;
+    }
+    g.wake.notify_one();
+    g.writer.join();
+
+    if (g.file) {
+        std::fclose(g.file);
+        g.file = nullptr;
+    }
+}
+
+void Logger::Flush()
+{
+    State& g = G();
+    if (!g.running.load()) return;
+
+    std::unique_lock<std::mutex> lock(g.wakeMutex);
+    uint64_t ticket = ++g.flushRequested;
+    g.wake.notify_one();
+    g.flushed.wait(lock, [&]() { return g.flushCompleted >= ticket || g.stop; });
+}
+
+void Logger::SetLevel(LogLevel level)
+{
+    G().minLevel.store((int)level, std::memory_order_relaxed);
+}
+
+bool Logger::IsEnabled(LogLevel level)
+{
+    return (int)level >= G().minLevel.load(std::memory_order_relaxed);
+}
+
+void Logger::Write(LogLevel level, const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    Push(level, nullptr, 0, fmt, &args);
+    va_end(args);
+}
+
+void Logger::WriteRaw(LogLevel level, const char* text, size_t len)
+{
+    Push(level, text, len, nullptr, nullptr);
+}
+
+uint64_t Logger::DroppedCount()
+{
+    return G().totalDropped.load(std::memory_order_relaxed);
+}
 
 void Log(const std::wstring& msg)
 {
-    std::wstring s = L"[ChessProject] " + msg + L"\n";
-    OutputDebugStringW(s.c_str());
+    if (!Logger::IsEnabled(LogLevel::Info)) return;
+
+    // UTF-16(Windows) / UTF-32 -> UTF-8
+    std::string utf8;
+    utf8.reserve(msg.size() * 3);
+    for (size_t i = 0; i < msg.size(); ++i) {
+        uint32_t cp = (uint32_t)msg[i];
+        if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < msg.size()) {
+            uint32_t lo = (uint32_t)msg[i + 1];
+            if (lo >= 0xDC00 && lo <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                ++i;
+            }
+        }
+        if (cp < 0x80) utf8 += (char)cp;
+        else if (cp < 0x800) { utf8 += (char)(0xC0 | (cp >> 6)); utf8 += (char)(0x80 | (cp & 0x3F)); }
+        else if (cp < 0x10000) { utf8 += (char)(0xE0 | (cp >> 12)); utf8 += (char)(0x80 | ((cp >> 6) & 0x3F)); utf8 += (char)(0x80 | (cp & 0x3F)); }
+        else { utf8 += (char)(0xF0 | (cp >> 18)); utf8 += (char)(0x80 | ((cp >> 12) & 0x3F)); utf8 += (char)(0x80 | ((cp >> 6) & 0x3F)); utf8 += (char)(0x80 | (cp & 0x3F)); }
+    }
+    Logger::WriteRaw(LogLevel::Info, utf8.data(), utf8.size());
 }
 
 void LogA(const std::string& msg)
 {
-    int len = MultiByteToWideChar(CP_UTF8, 0, msg.c_str(), -1, nullptr, 0);
-    std::wstring w;
-    w.resize(len);
-    MultiByteToWideChar(CP_UTF8, 0, msg.c_str(), -1, &w[0], len);
-    Log(w);
+    if (!Logger::IsEnabled(LogLevel::Info)) return;
+    Logger::WriteRaw(LogLevel::Info, msg.data(), msg.size());
 }
@@ -1,5 +1,96 @@
 ﻿#pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
+// 비동기 로거 (플랫폼 독립)
+// - 호출 스레드는 자기 전용 링 버퍼(SPSC, lock-free)에 레코드를 넣고 바로 반환
+//   (버퍼가 가득 차면 기다리지 않고 버림 -> 개수는 나중에 경고로 기록)
+// - 백그라운드 스레드가 시간순으로 모아 포맷 후 파일(회전) / stderr / 디버거 출력
+// - LOG_COMPILE_LEVEL 보다 낮은 LOG_* 매크로는 빈 문장으로 치환되어 비용 0
+// - Start() 전이나 Shutdown() 후에는 동기식으로 바로 출력 (기존 동작과 동일)
+
+enum class LogLevel : uint8_t
+{
+    Trace = 0,
+    Debug,
+    Info,
+    Warn,
+    Error,
+    Off
+};
+
+// 컴파일 타임 최소 레벨 (0 = Trace ... 4 = Error, 5 = 전부 제거)
+#ifndef LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILE_LEVEL 2
+#else
+#define LOG_COMPILE_LEVEL 0
+#endif
+#endif
+
+namespace Logger
+{
+    struct Options
+    {
+        LogLevel minLevel = LogLevel::Info;   // 런타임 최소 레벨 (SetLevel로 변경 가능)
+        std::string filePath;                 // 비어 있으면 파일 출력 없음
+        size_t maxFileBytes = 4 * 1024 * 1024; // 넘으면 path -> path.1 -> ... 로 회전
+        int maxFiles = 3;                     // 보관할 파일 수 (현재 파일 포함)
+        bool toStderr = true;
+        bool toDebugger = true;               // Windows: OutputDebugStringW
+        size_t ringRecords = 1024;            // 스레드당 레코드 수 (2의 거듭제곱으로 올림)
+        unsigned flushIntervalMs = 50;        // 백그라운드 스레드 배출 주기
+    };
+
+    void Start(const Options& options);
+    // 남은 레코드를 모두 기록하고 스레드 종료
+    void Shutdown();
+    // 지금까지 넣은 레코드가 기록될 때까지 대기
+    void Flush();
+
+    void SetLevel(LogLevel level);
+    bool IsEnabled(LogLevel level);
+
+#if defined(__GNUC__) || defined(__clang__)
+    void Write(LogLevel level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+#else
+    void Write(LogLevel level, const char* fmt, ...);
+#endif
+    void WriteRaw(LogLevel level, const char* text, size_t len);
+
+    // 링 버퍼가 가득 차서 버린 레코드 수 (누적)
+    uint64_t DroppedCount();
+}
+
+#define LOG_AT(level, ...) do { if (Logger::IsEnabled(level)) Logger::Write(level, __VA_ARGS__); } while (0)
+
+#if LOG_COMPILE_LEVEL <= 0
+#define LOG_TRACE(...) LOG_AT(LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 2
+#define LOG_INFO(...) LOG_AT(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 3
+#define LOG_WARN(...) LOG_AT(LogLevel::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 4
+#define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+// 기존 API (Info 레벨)
 void Log(const std::wstring& msg);
 void LogA(const std::string& msg);
@@ -0,0 +1,123 @@
+﻿#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Trace::g_enabled{ false };
+
+namespace
+{
+    struct Event
+    {
+        const char* name;
+        const char* category;
+        uint64_t startUs;
+        uint64_t durUs;
+        uint32_t tid;
+        std::atomic<uint32_t> ready; // 기록 완료 후 1 (덤프 중 반쯤 쓰인 이벤트 제외)
+    };
+
+    std::mutex g_bufferMutex; // Enable / Disable / Dump 사이만 직렬화 (Record는 잠그지 않음)
+    std::unique_ptr<Event[]> g_events;
+    size_t g_capacity = 0;
+    std::atomic<size_t> g_next{ 0 };
+    std::atomic<size_t> g_dropped{ 0 };
+    std::atomic<uint32_t> g_nextTid{ 1 };
+
+    const auto g_epoch = std::chrono::steady_clock::now();
+
+    uint32_t ThisThreadId()
+    {
+        thread_local uint32_t tid = g_nextTid.fetch_add(1);
+        return tid;
+    }
+
+    void WriteJsonString(FILE* f, const char* s)
+    {
+        std::fputc('"', f);
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') std::fputc('\\', f);
+            std::fputc(*s, f);
+        }
+        std::fputc('"', f);
+    }
+}
+
+void Trace::Enable(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(g_bufferMutex);
+    g_enabled.store(false);
+    // 버퍼는 처음 한 번만 할당 (기록 중인 스레드가 있을 수 있으므로 해제/재할당하지 않음)
+    if (!g_events) {
+        g_capacity = (capacity > 0) ? capacity : 1;
+        g_events.reset(new Event[g_capacity]);
+    }
+    for (size_t i = 0; i < g_capacity; ++i) g_events[i].ready.store(0, std::memory_order_relaxed);
+    g_next.store(0);
+    g_dropped.store(0);
+    g_enabled.store(true, std::memory_order_release);
+}
+
+void Trace::Disable()
+{
+    g_enabled.store(false, std::memory_order_release);
+}
+
+uint64_t Trace::NowUs()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+void Trace::Record(const char* name, const char* category, uint64_t startUs, uint64_t endUs)
+{
+    // 스코프 시작 후 Enable로 버퍼가 바뀌는 경우는 드물고, 인덱스 검사로 범위만 보장
+    size_t i = g_next.fetch_add(1, std::memory_order_relaxed);
+    if (i >= g_capacity) {
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Event& e = g_events[i];
+    e.name = name;
+    e.category = category;
+    e.startUs = startUs;
+    e.durUs = endUs - startUs;
+    e.tid = ThisThreadId();
+    e.ready.store(1, std::memory_order_release);
+}
+
+size_t Trace::EventCount()
+{
+    size_t n = g_next.load(std::memory_order_relaxed);
+    return (n < g_capacity) ? n : g_capacity;
+}
+
+size_t Trace::DroppedCount()
+{
+    return g_dropped.load(std::memory_order_relaxed);
+}
+
+bool Trace::DumpChromeJson(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(g_bufferMutex);
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"ChessProject\"}}");
+
+    size_t count = EventCount();
+    for (size_t i = 0; i < count; ++i) {
+        const Event& e = g_events[i];
+        if (e.ready.load(std::memory_order_acquire) == 0) continue;
+        std::fprintf(f, ",\n{\"name\":");
+        WriteJsonString(f, e.name);
+        std::fprintf(f, ",\"cat\":");
+        WriteJsonString(f, e.category);
+        std::fprintf(f, ",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%u}",
+            (unsigned long long)e.startUs, (unsigned long long)e.durUs, e.tid);
+    }
+    std::fprintf(f, "\n],\"otherData\":{\"dropped\":%zu}}\n", DroppedCount());
+    return std::fclose(f) == 0;
+}
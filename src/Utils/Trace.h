@@ -0,0 +1,55 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 스코프 단위 타이밍 기록 -> Chrome trace JSON (chrome://tracing, Perfetto)
+// - 꺼져 있을 때 비용: 원자 변수 읽기 한 번
+// - 켜져 있을 때: 미리 잡아 둔 고정 크기 버퍼에 lock-free로 추가 (가득 차면 버림)
+// - 이름 / 카테고리는 문자열 리터럴만 (포인터만 저장)
+namespace Trace
+{
+    extern std::atomic<bool> g_enabled;
+
+    inline bool IsEnabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+    // 켜면 버퍼를 비우고 기록 시작 (capacity = 이벤트 수, 처음 호출 때만 적용)
+    void Enable(size_t capacity = 1 << 18);
+    void Disable();
+
+    uint64_t NowUs();
+    void Record(const char* name, const char* category, uint64_t startUs, uint64_t endUs);
+
+    size_t EventCount();
+    size_t DroppedCount();
+
+    // 지금까지의 이벤트를 Chrome trace 형식으로 저장 (기록 중에도 호출 가능)
+    bool DumpChromeJson(const std::string& path);
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name, const char* category = "app")
+            : m_name(name), m_category(category), m_active(IsEnabled())
+        {
+            if (m_active) m_start = NowUs();
+        }
+        ~Scope()
+        {
+            if (m_active) Record(m_name, m_category, m_start, NowUs());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        const char* m_category;
+        uint64_t m_start = 0;
+        bool m_active;
+    };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, category)